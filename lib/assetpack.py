@@ -0,0 +1,251 @@
+# coding: ascii
+# pygame - Python Game Library
+#
+# This library is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Library General Public
+# License as published by the Free Software Foundation; either
+# version 2 of the License, or (at your option) any later version.
+#
+# This library is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Library General Public License for more details.
+#
+# You should have received a copy of the GNU Library General Public
+# License along with this library; if not, write to the Free
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+"""pygame module for packed, memory mapped asset archives
+
+An archive is a single file holding many assets, with a table of contents
+at the end. It is opened with mmap, so reading an entry costs no system
+calls, and images stored as raw pixels become Surfaces without decoding
+or copying.
+
+Layout, all integers little endian:
+
+    header    magic "PGAK", version u16, reserved u16,
+              entry count u32, table of contents offset u64
+    data      each entry starts on a 16 byte boundary
+    contents  per entry: name length u16, kind u8, pad u8, offset u64,
+              size u64, width u32, height u32, pixel format 4s,
+              then the UTF-8 name
+
+Kind 0 entries are file contents stored as they are. Kind 1 entries are
+raw pixel rows in the named pygame.image.tostring format.
+
+Build an archive from the command line with
+
+    python -m pygame.assetpack [--raw] archive.pak directory_or_file ...
+"""
+
+__all__ = ['Archive', 'build']
+
+import os
+import sys
+import mmap
+import struct
+from pygame.compat import as_bytes, PY_MAJOR_VERSION
+
+MAGIC = as_bytes('PGAK')
+VERSION = 1
+ALIGN = 16
+
+KIND_FILE = 0
+KIND_RAW = 1
+
+_header = struct.Struct('<4sHHIQ')
+_entry = struct.Struct('<HBxQQII4s')
+
+# image types stored as raw pixels when building with raw_images
+IMAGE_EXTENSIONS = frozenset(('.bmp', '.gif', '.jpg', '.jpeg', '.lbm',
+                              '.pbm', '.pcx', '.pgm', '.png', '.pnm',
+                              '.ppm', '.tga', '.tif', '.tiff', '.xpm'))
+
+
+class Archive(object):
+    """Archive(path) -> Archive
+    open a packed asset archive for reading
+    """
+
+    def __init__(self, path):
+        self._file = open(path, 'rb')
+        try:
+            # A private mapping: Surfaces sharing raw entries may be drawn
+            # on without writing through to the file.
+            self._map = mmap.mmap(self._file.fileno(), 0,
+                                  access=mmap.ACCESS_COPY)
+            self._entries = self._read_contents()
+        except:
+            self._file.close()
+            raise
+
+    def _read_contents(self):
+        mapped = self._map
+        if len(mapped) < _header.size:
+            raise ValueError("not an asset archive")
+        magic, version, reserved, count, offset = \
+            _header.unpack_from(mapped, 0)
+        if magic != MAGIC:
+            raise ValueError("not an asset archive")
+        if version != VERSION:
+            raise ValueError("unsupported asset archive version %d" % version)
+        entries = {}
+        for i in range(count):
+            try:
+                (namelen, kind, start, size,
+                 width, height, fmt) = _entry.unpack_from(mapped, offset)
+            except struct.error:
+                raise ValueError("asset archive is truncated")
+            offset += _entry.size
+            if offset + namelen > len(mapped) or start + size > len(mapped):
+                raise ValueError("asset archive is truncated")
+            name = mapped[offset:offset + namelen].decode('utf-8')
+            offset += namelen
+            entries[name] = (kind, start, size, (width, height),
+                             fmt.rstrip(as_bytes('\0')).decode('ascii'))
+        return entries
+
+    def __len__(self):
+        return len(self._entries)
+
+    def __contains__(self, name):
+        return name in self._entries
+
+    def __iter__(self):
+        return iter(self.names())
+
+    def names(self):
+        """names() -> list
+        get the sorted entry names
+        """
+        return sorted(self._entries)
+
+    def is_raw(self, name):
+        """is_raw(name) -> bool
+        test if an entry holds raw pixels
+        """
+        return self._entries[name][0] == KIND_RAW
+
+    def _view(self, start, size):
+        if PY_MAJOR_VERSION >= 3:
+            return memoryview(self._map)[start:start + size]
+        return buffer(self._map, start, size)
+
+    def read(self, name):
+        """read(name) -> buffer
+        get the stored bytes of an entry without copying them
+        """
+        kind, start, size, dims, fmt = self._entries[name]
+        return self._view(start, size)
+
+    def load_image(self, name):
+        """load_image(name) -> Surface
+        load an image entry
+        """
+        import pygame.image
+
+        kind, start, size, dims, fmt = self._entries[name]
+        if kind == KIND_RAW:
+            return pygame.image.frombuffer(self._view(start, size), dims, fmt)
+        if PY_MAJOR_VERSION >= 3:
+            return pygame.image.load(self._view(start, size), name)
+        from pygame.compat import get_BytesIO
+        return pygame.image.load(get_BytesIO()(self._map[start:start + size]),
+                                 name)
+
+    def close(self):
+        """close() -> None
+        close the archive file
+        """
+        self._file.close()
+        self._entries = {}
+        self._map = None
+
+
+def _raw_pixels(filename):
+    import pygame
+    import pygame.image
+
+    surf = pygame.image.load(filename)
+    if surf.get_flags() & pygame.SRCALPHA or surf.get_colorkey() is not None:
+        fmt = 'RGBA'
+    else:
+        fmt = 'RGBX'
+    return surf.get_size(), fmt, pygame.image.tostring(surf, fmt)
+
+
+def build(path, files, raw_images=False):
+    """build(path, files, raw_images=False) -> None
+    write an asset archive
+
+    files is a sequence of file names, or of (name, file name) pairs to
+    choose the entry name. With raw_images true, image files are decoded
+    now and stored as raw pixels.
+    """
+    contents = []
+    out = open(path, 'wb')
+    try:
+        out.write(_header.pack(MAGIC, VERSION, 0, 0, 0))
+        for item in files:
+            if isinstance(item, tuple):
+                name, filename = item
+            else:
+                name = filename = item
+            name = name.replace(os.sep, '/')
+            ext = os.path.splitext(filename)[1].lower()
+            if raw_images and ext in IMAGE_EXTENSIONS:
+                (width, height), fmt, data = _raw_pixels(filename)
+                kind = KIND_RAW
+            else:
+                f = open(filename, 'rb')
+                try:
+                    data = f.read()
+                finally:
+                    f.close()
+                width = height = 0
+                fmt = ''
+                kind = KIND_FILE
+            pad = -out.tell() % ALIGN
+            out.write(as_bytes('\0') * pad)
+            contents.append((name.encode('utf-8'), kind, out.tell(),
+                             len(data), width, height, as_bytes(fmt)))
+            out.write(data)
+
+        offset = out.tell()
+        for name, kind, start, size, width, height, fmt in contents:
+            out.write(_entry.pack(len(name), kind, start, size,
+                                  width, height, fmt))
+            out.write(name)
+        out.seek(0)
+        out.write(_header.pack(MAGIC, VERSION, 0, len(contents), offset))
+    finally:
+        out.close()
+
+
+def main(args=None):
+    """build an archive from the command line"""
+    if args is None:
+        args = sys.argv[1:]
+    raw_images = '--raw' in args
+    args = [a for a in args if a != '--raw']
+    if len(args) < 2:
+        sys.stderr.write("usage: python -m pygame.assetpack [--raw] "
+                         "archive.pak directory_or_file ...\n")
+        return 2
+
+    files = []
+    for source in args[1:]:
+        if os.path.isdir(source):
+            for dirpath, dirnames, filenames in os.walk(source):
+                dirnames.sort()
+                for filename in sorted(filenames):
+                    full = os.path.join(dirpath, filename)
+                    files.append((os.path.relpath(full, source), full))
+        else:
+            files.append((os.path.basename(source), source))
+    build(args[0], files, raw_images)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -5,7 +5,8 @@ from pygame._freetype import (
    STYLE_NORMAL, STYLE_OBLIQUE, STYLE_STRONG, STYLE_UNDERLINE, STYLE_WIDE,
    STYLE_DEFAULT,
    init, quit,
-   was_init, get_cache_size, get_default_font, get_default_resolution, 
+   was_init, get_cache_size, get_cache_budget, set_cache_budget,
+   get_cache_stats, get_default_font, get_default_resolution,
    get_error, get_version, set_default_resolution,
    _PYGAME_C_API, __PYGAMEinit__,
    )
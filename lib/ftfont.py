@@ -9,6 +9,7 @@ from pygame.sysfont import match_font, get_fonts, SysFont as _SysFont
 from pygame import encode_file_path
 from pygame.compat import bytes_, unicode_, as_unicode, as_bytes
 from pygame import Surface as _Surface, Color as _Color, SRCALPHA as _SRCALPHA
+from collections import OrderedDict as _OrderedDict
 
 class Font(_Font):
     """Font(filename, size) -> Font
@@ -26,6 +27,8 @@ class Font(_Font):
     __unull = as_unicode(r"\x00")
     __bnull = as_bytes("\x00")
 
+    __cache_budget = 0
+
     def __init__(self, file, size=-1):
         if size <= 1:
             size = 1
@@ -49,11 +52,82 @@ class Font(_Font):
         self.pad = True
         self.ucs4 = True
         self.underline_adjustment = 1.0
+        self.__cache = _OrderedDict()
+        self.__cache_stats = [0, 0, 0, 0]
 
     def render(self, text, antialias, color, background=None):
         """render(text, antialias, color, background=None) -> Surface
            draw text on a new Surface"""
 
+        if not self.__cache_budget or type(text) not in (unicode_, bytes_):
+            return self.__render(text, antialias, color, background)
+        fg = self.__color_key(color)
+        bg = None if background is None else self.__color_key(background)
+        if fg is None or (bg is None and background is not None):
+            return self.__render(text, antialias, color, background)
+        key = (text, bool(antialias), fg, bg,
+               self.wide, self.oblique, self.underline)
+        stats = self.__cache_stats
+        cache = self.__cache
+        s = cache.pop(key, None)
+        if s is not None:
+            # reinserting makes it the most recently used
+            cache[key] = s
+            stats[0] += 1
+            return s
+        stats[1] += 1
+        s = self.__render(text, antialias, color, background)
+        size = s.get_pitch() * s.get_height()
+        if size <= self.__cache_budget:
+            self.__trim_cache(self.__cache_budget - size)
+            cache[key] = s
+            stats[3] += size
+        return s
+
+    def render_to(self, surf, dest, text, antialias, color, background=None):
+        """render_to(surface, dest, text, antialias, color, background=None) -> Rect
+           draw text on an existing Surface"""
+
+        return surf.blit(self.render(text, antialias, color, background), dest)
+
+    def set_cache_budget(self, budget):
+        """set_cache_budget(bytes) -> None
+           keep rendered text surfaces for reuse"""
+
+        if budget < 0:
+            raise ValueError("the cache budget must be positive")
+        self.__cache_budget = budget
+        self.__trim_cache(budget)
+
+    def get_cache_budget(self):
+        """get_cache_budget() -> int
+           get the memory allowed for rendered text surfaces"""
+
+        return self.__cache_budget
+
+    def get_cache_stats(self):
+        """get_cache_stats() -> (hits, misses, evictions, bytes)
+           get the counters of the rendered text cache"""
+
+        return tuple(self.__cache_stats)
+
+    def __trim_cache(self, budget):
+        cache = self.__cache
+        stats = self.__cache_stats
+        while stats[3] > budget and cache:
+            s = cache.popitem(last=False)[1]
+            stats[2] += 1
+            stats[3] -= s.get_pitch() * s.get_height()
+
+    @staticmethod
+    def __color_key(color):
+        # Only sequence colors make keys; names and mapped integers are
+        # rendered without the cache.
+        if isinstance(color, (tuple, list, _Color)) and len(color) in (3, 4):
+            return tuple(color)[:3]
+        return None
+
+    def __render(self, text, antialias, color, background):
         if text is None:
             text = ""
         if (isinstance(text, unicode_) and  # conditional and
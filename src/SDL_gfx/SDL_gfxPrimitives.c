@@ -952,6 +952,255 @@ int pixelRGBA(SDL_Surface * dst, Sint16 x, Sint16 y, Uint8 r, Uint8 g, Uint8 b,
 }
 
 
+/* ----- Span primitives */
+
+/* SSE2 is part of the x86-64 baseline; 32-bit builds only get it when the compiler targets it */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define GFX_SPAN_SSE2
+#endif
+
+/*!
+\brief Internal span context shared by the filled primitives.
+
+Holds the destination surface locked for the whole primitive, the color already
+mapped to the destination format and the clipping boundary, so that the per-span
+work is reduced to clipping and storing/blending a contiguous run of pixels.
+*/
+typedef struct {
+	SDL_Surface *dst;
+	Uint32 mcolor;
+	Uint8 alpha;
+	Sint16 left, right, top, bottom;
+} SDL_gfxSpanContext;
+
+/*!
+\brief Internal function to fill a run of pixels with a mapped color.
+
+Uses the widest stores available: memset for 8bpp, 16 byte SSE2 stores (or
+32bit stores of two pixels) for 16bpp, a 12 byte pattern of four pixels for
+24bpp and 16 byte SSE2 stores for 32bpp.
+
+\param pixel Pointer to the first pixel of the run.
+\param bpp Bytes per pixel of the destination surface.
+\param n Number of pixels in the run.
+\param mcolor The color value in destination format.
+*/
+static void _spanFill(Uint8 *pixel, int bpp, int n, Uint32 mcolor)
+{
+	Uint32 pattern[3];
+	Uint8 *colorptr;
+
+	switch (bpp) {
+	case 1:
+		memset(pixel, (Uint8) mcolor, n);
+		break;
+	case 2:
+		mcolor &= 0xffff;
+		if (n > 0 && ((size_t) pixel & 2)) {
+			*(Uint16 *) pixel = (Uint16) mcolor;
+			pixel += 2;
+			n--;
+		}
+		mcolor |= mcolor << 16;
+#ifdef GFX_SPAN_SSE2
+		if (n >= 8) {
+			__m128i c128 = _mm_set1_epi32((int) mcolor);
+			for (; n >= 8; n -= 8, pixel += 16) {
+				_mm_storeu_si128((__m128i *) pixel, c128);
+			}
+		}
+#endif
+		for (; n >= 2; n -= 2, pixel += 4) {
+			*(Uint32 *) pixel = mcolor;
+		}
+		if (n) {
+			*(Uint16 *) pixel = (Uint16) mcolor;
+		}
+		break;
+	case 3:
+		colorptr = (Uint8 *) pattern;
+		if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
+			colorptr[0] = (mcolor >> 16) & 0xff;
+			colorptr[1] = (mcolor >> 8) & 0xff;
+			colorptr[2] = mcolor & 0xff;
+		} else {
+			colorptr[0] = mcolor & 0xff;
+			colorptr[1] = (mcolor >> 8) & 0xff;
+			colorptr[2] = (mcolor >> 16) & 0xff;
+		}
+		memcpy(colorptr + 3, colorptr, 3);
+		memcpy(colorptr + 6, colorptr, 6);
+		for (; n >= 4; n -= 4, pixel += 12) {
+			memcpy(pixel, pattern, 12);
+		}
+		for (; n > 0; n--, pixel += 3) {
+			memcpy(pixel, pattern, 3);
+		}
+		break;
+	default:		/* case 4 */
+#ifdef GFX_SPAN_SSE2
+		if (n >= 4) {
+			__m128i c128 = _mm_set1_epi32((int) mcolor);
+			for (; n >= 4; n -= 4, pixel += 16) {
+				_mm_storeu_si128((__m128i *) pixel, c128);
+			}
+		}
+#endif
+		for (; n > 0; n--, pixel += 4) {
+			*(Uint32 *) pixel = mcolor;
+		}
+		break;
+	}
+}
+
+/*!
+\brief Internal function to alpha blend a run of 32bpp pixels with a mapped color.
+
+Every channel becomes d + (s - d) * alpha / 256, exactly as in _filledRectAlpha,
+computed as (d * (256 - alpha) + s * alpha) >> 8 which stays within 16 bits.
+Like the per-pixel routine, the destination alpha is not blended but replaced by
+the weighted source alpha, and bits outside of the channel masks are cleared.
+
+\param pixel Pointer to the first pixel of the run.
+\param n Number of pixels in the run.
+\param mcolor The color value in destination format.
+\param alpha Alpha blending amount for pixels.
+\param keepmask Rmask | Gmask | Bmask | Amask of the destination format.
+\param amask Amask of the destination format.
+*/
+static void _spanBlend32(Uint8 *pixel, int n, Uint32 mcolor, Uint8 alpha, Uint32 keepmask, Uint32 amask)
+{
+	Uint32 ialpha = 256 - alpha;
+	Uint32 s0 = mcolor & 0xff;
+	Uint32 s1 = (mcolor >> 8) & 0xff;
+	Uint32 s2 = (mcolor >> 16) & 0xff;
+	Uint32 s3 = mcolor >> 24;
+	Uint32 d;
+
+#ifdef GFX_SPAN_SSE2
+	if (n >= 4) {
+		__m128i zero = _mm_setzero_si128();
+		__m128i ia = _mm_set1_epi16((short) ialpha);
+		__m128i src = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_set1_epi32((int) mcolor), zero),
+			_mm_set1_epi16((short) alpha));
+		__m128i mask = _mm_set1_epi32((int) keepmask);
+		__m128i dmask = _mm_set1_epi32((int) ~amask);
+		__m128i lo, hi, px;
+
+		for (; n >= 4; n -= 4, pixel += 16) {
+			px = _mm_and_si128(_mm_loadu_si128((__m128i *) pixel), dmask);
+			lo = _mm_unpacklo_epi8(px, zero);
+			hi = _mm_unpackhi_epi8(px, zero);
+			lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, ia), src), 8);
+			hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, ia), src), 8);
+			px = _mm_and_si128(_mm_packus_epi16(lo, hi), mask);
+			_mm_storeu_si128((__m128i *) pixel, px);
+		}
+	}
+#endif
+	s0 *= alpha;
+	s1 *= alpha;
+	s2 *= alpha;
+	s3 *= alpha;
+	for (; n > 0; n--, pixel += 4) {
+		d = *(Uint32 *) pixel & ~amask;
+		*(Uint32 *) pixel = ((((d & 0xff) * ialpha + s0) >> 8) |
+			(((((d >> 8) & 0xff) * ialpha + s1) >> 8) << 8) |
+			(((((d >> 16) & 0xff) * ialpha + s2) >> 8) << 16) |
+			((((d >> 24) * ialpha + s3) >> 8) << 24)) & keepmask;
+	}
+}
+
+/*!
+\brief Internal function to start a span based primitive.
+
+Maps the color to the destination format and locks the surface once for all
+spans drawn until _gfxSpanEnd is called.
+
+\param ctx The span context to set up.
+\param dst The surface to draw on.
+\param color The color value of the primitive to draw (0xRRGGBBAA). 
+
+\returns Returns 0 on success, -1 on failure.
+*/
+static int _gfxSpanBegin(SDL_gfxSpanContext *ctx, SDL_Surface * dst, Uint32 color)
+{
+	ctx->dst = dst;
+	ctx->alpha = color & 0x000000ff;
+	ctx->mcolor = SDL_MapRGBA(dst->format, (color & 0xff000000) >> 24,
+		(color & 0x00ff0000) >> 16, (color & 0x0000ff00) >> 8, ctx->alpha);
+	ctx->left = dst->clip_rect.x;
+	ctx->right = dst->clip_rect.x + dst->clip_rect.w - 1;
+	ctx->top = dst->clip_rect.y;
+	ctx->bottom = dst->clip_rect.y + dst->clip_rect.h - 1;
+
+	if (SDL_MUSTLOCK(dst)) {
+		if (SDL_LockSurface(dst) < 0) {
+			return (-1);
+		}
+	}
+	return (0);
+}
+
+/*!
+\brief Internal function to finish a span based primitive.
+
+\param ctx The span context set up by _gfxSpanBegin.
+*/
+static void _gfxSpanEnd(SDL_gfxSpanContext *ctx)
+{
+	if (SDL_MUSTLOCK(ctx->dst)) {
+		SDL_UnlockSurface(ctx->dst);
+	}
+}
+
+/*!
+\brief Internal function to draw one clipped horizontal span with blending.
+
+The surface must have been locked with _gfxSpanBegin.
+
+\param ctx The span context set up by _gfxSpanBegin.
+\param x1 X coordinate of the first point of the span.
+\param x2 X coordinate of the second point of the span.
+\param y Y coordinate of the span.
+*/
+static void _gfxSpan(SDL_gfxSpanContext *ctx, Sint16 x1, Sint16 x2, Sint16 y)
+{
+	SDL_Surface *dst = ctx->dst;
+	SDL_PixelFormat *format = dst->format;
+	Sint16 xtmp;
+	Uint8 *pixel;
+
+	if ((y < ctx->top) || (y > ctx->bottom)) {
+		return;
+	}
+	if (x1 > x2) {
+		xtmp = x1;
+		x1 = x2;
+		x2 = xtmp;
+	}
+	if (x1 < ctx->left) {
+		x1 = ctx->left;
+	}
+	if (x2 > ctx->right) {
+		x2 = ctx->right;
+	}
+	if (x1 > x2) {
+		return;
+	}
+
+	pixel = (Uint8 *) dst->pixels + (int) y * dst->pitch + (int) x1 * format->BytesPerPixel;
+	if (ctx->alpha == 255) {
+		_spanFill(pixel, format->BytesPerPixel, x2 - x1 + 1, ctx->mcolor);
+	} else if (format->BytesPerPixel == 4) {
+		_spanBlend32(pixel, x2 - x1 + 1, ctx->mcolor, ctx->alpha,
+			format->Rmask | format->Gmask | format->Bmask | format->Amask, format->Amask);
+	} else {
+		_filledRectAlpha(dst, x1, y, x2, y, ctx->mcolor, ctx->alpha);
+	}
+}
+
 /*!
 \brief Draw horizontal line without blending;
 
@@ -1132,14 +1381,7 @@ int hlineRGBAStore(SDL_Surface * dst, Sint16 x1, Sint16 x2, Sint16 y, Uint8 r, U
 */
 int hlineColor(SDL_Surface * dst, Sint16 x1, Sint16 x2, Sint16 y, Uint32 color)
 {
-	Sint16 left, right, top, bottom;
-	Uint8 *pixel, *pixellast;
-	int dx;
-	int pixx, pixy;
-	Sint16 xtmp;
-	int result = -1;
-	Uint8 *colorptr;
-	Uint8 color3[3];
+	SDL_gfxSpanContext span;
 
 	/*
 	* Check visibility of clipping rectangle
@@ -1149,140 +1391,34 @@ int hlineColor(SDL_Surface * dst, Sint16 x1, Sint16 x2, Sint16 y, Uint32 color)
 	}
 
 	/*
-	* Swap x1, x2 if required to ensure x1<=x2
-	*/
-	if (x1 > x2) {
-		xtmp = x1;
-		x1 = x2;
-		x2 = xtmp;
-	}
-
-	/*
-	* Get clipping boundary and
-	* check visibility of hline 
+	* Check visibility of hline 
 	*/
-	left = dst->clip_rect.x;
-	if (x2<left) {
-		return(0);
-	}
-	right = dst->clip_rect.x + dst->clip_rect.w - 1;
-	if (x1>right) {
-		return(0);
+	if ((y < dst->clip_rect.y) || (y >= dst->clip_rect.y + dst->clip_rect.h)) {
+		return (0);
 	}
-	top = dst->clip_rect.y;
-	bottom = dst->clip_rect.y + dst->clip_rect.h - 1;
-	if ((y<top) || (y>bottom)) {
+	if (((x1 < dst->clip_rect.x) && (x2 < dst->clip_rect.x)) ||
+		((x1 >= dst->clip_rect.x + dst->clip_rect.w) && (x2 >= dst->clip_rect.x + dst->clip_rect.w))) {
 		return (0);
 	}
 
 	/*
-	* Clip x 
+	* Setup color and lock the surface 
 	*/
-	if (x1 < left) {
-		x1 = left;
-	}
-	if (x2 > right) {
-		x2 = right;
+	if (_gfxSpanBegin(&span, dst, color) < 0) {
+		return (-1);
 	}
 
 	/*
-	* Calculate width difference
+	* Draw 
 	*/
-	dx = x2 - x1;
+	_gfxSpan(&span, x1, x2, y);
 
 	/*
-	* Alpha check 
+	* Unlock surface 
 	*/
-	if ((color & 255) == 255) {
-
-		/*
-		* No alpha-blending required 
-		*/
-
-		/*
-		* Setup color 
-		*/
-		colorptr = (Uint8 *) & color;
-		if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
-			color = SDL_MapRGBA(dst->format, colorptr[0], colorptr[1], colorptr[2], colorptr[3]);
-		} else {
-			color = SDL_MapRGBA(dst->format, colorptr[3], colorptr[2], colorptr[1], colorptr[0]);
-		}
-
-		/*
-		* Lock the surface 
-		*/
-		if (SDL_MUSTLOCK(dst)) {
-			if (SDL_LockSurface(dst) < 0) {
-				return (-1);
-			}
-		}
-
-		/*
-		* More variable setup 
-		*/
-		pixx = dst->format->BytesPerPixel;
-		pixy = dst->pitch;
-		pixel = ((Uint8 *) dst->pixels) + pixx * (int) x1 + pixy * (int) y;
-
-		/*
-		* Draw 
-		*/
-		switch (dst->format->BytesPerPixel) {
-	case 1:
-		memset(pixel, color, dx + 1);
-		break;
-	case 2:
-		pixellast = pixel + dx + dx;
-		for (; pixel <= pixellast; pixel += pixx) {
-			*(Uint16 *) pixel = color;
-		}
-		break;
-	case 3:
-		pixellast = pixel + dx + dx + dx;
-		if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
-			color3[0] = (color >> 16) & 0xff;
-			color3[1] = (color >> 8) & 0xff;
-			color3[2] = color & 0xff;
-		} else {
-			color3[0] = color & 0xff;
-			color3[1] = (color >> 8) & 0xff;
-			color3[2] = (color >> 16) & 0xff;
-		}
-		for (; pixel <= pixellast; pixel += pixx) {
-			memcpy(pixel, color3, 3);
-		}
-		break;
-	default:		/* case 4 */
-		dx = dx + dx;
-		pixellast = pixel + dx + dx;
-		for (; pixel <= pixellast; pixel += pixx) {
-			*(Uint32 *) pixel = color;
-		}
-		break;
-		}
-
-		/* 
-		* Unlock surface 
-		*/
-		if (SDL_MUSTLOCK(dst)) {
-			SDL_UnlockSurface(dst);
-		}
-
-		/*
-		* Set result code 
-		*/
-		result = 0;
+	_gfxSpanEnd(&span);
 
-	} else {
-
-		/*
-		* Alpha blending blit 
-		*/
-		result = _HLineAlpha(dst, x1, x1 + dx, y, color);
-	}
-
-	return (result);
+	return (0);
 }
 
 /*!
@@ -1765,9 +1901,15 @@ int roundedRectangleRGBA(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sin
 */
 int roundedBoxColor(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y2, Sint16 rad, Uint32 color)
 {
-	int result;
+	SDL_gfxSpanContext span;
 	Sint16 w, h, tmp;
 	Sint16 xx1, xx2, yy1, yy2;
+	Sint16 cx = 0;
+	Sint16 cy;
+	Sint16 ocx = (Sint16) 0xffff;
+	Sint16 ocy = (Sint16) 0xffff;
+	Sint16 df, d_e, d_se;
+	Sint16 y;
 
 	/* 
 	* Check destination surface 
@@ -1850,44 +1992,77 @@ int roundedBoxColor(SDL_Surface * dst, Sint16 x1, Sint16 y1, Sint16 x2, Sint16 y
 	}
 
 	/*
-	* Draw corners
+	* Setup color and lock the surface once for all spans
+	*/
+	if (_gfxSpanBegin(&span, dst, color) < 0) {
+		return (-1);
+	}
+
+	/*
+	* Draw corners as a filled circle split apart at its center
+	* lines, so every row of the box is covered by exactly one span
 	*/
-	result = 0;
 	xx1 = x1 + rad;
 	xx2 = x2 - rad;
 	yy1 = y1 + rad;
 	yy2 = y2 - rad;
-	result |= filledPieColor(dst, xx1, yy1, rad, 180, 270, color);
-	result |= filledPieColor(dst, xx2, yy1, rad, 270, 360, color);
-	result |= filledPieColor(dst, xx1, yy2, rad,  90, 180, color);
-	result |= filledPieColor(dst, xx2, yy2, rad,   0,  90, color);
-
-	/*
-	* Draw body
-	*/
-	xx1++;
-	xx2--;
-	yy1++;
-	yy2--;
-	if (xx1 <= xx2) {
-		result |= boxColor(dst, xx1, y1, xx2, y2, color);
-	}
-	if (yy1 <= yy2) {
-		result |= boxColor(dst, x1, yy1, xx1-1, yy2, color);
-		result |= boxColor(dst, xx2+1, yy1, x2, yy2, color);
-	}
-
-	return result;
-}
-
-/*!
-\brief Draw rounded-corner box (filled rectangle) with blending.
-
-\param dst The surface to draw on.
-\param x1 X coordinate of the first point (i.e. top right) of the box.
-\param y1 Y coordinate of the first point (i.e. top right) of the box.
-\param x2 X coordinate of the second point (i.e. bottom left) of the box.
-\param y2 Y coordinate of the second point (i.e. bottom left) of the box.
+	cy = rad;
+	df = 1 - rad;
+	d_e = 3;
+	d_se = -2 * rad + 5;
+	do {
+		if (ocy != cy) {
+			_gfxSpan(&span, xx1 - cx, xx2 + cx, yy1 - cy);
+			if (yy2 + cy != yy1 - cy) {
+				_gfxSpan(&span, xx1 - cx, xx2 + cx, yy2 + cy);
+			}
+			ocy = cy;
+		}
+		if (ocx != cx) {
+			if (cx != cy) {
+				_gfxSpan(&span, xx1 - cy, xx2 + cy, yy1 - cx);
+				if (yy2 + cx != yy1 - cx) {
+					_gfxSpan(&span, xx1 - cy, xx2 + cy, yy2 + cx);
+				}
+			}
+			ocx = cx;
+		}
+		if (df < 0) {
+			df += d_e;
+			d_e += 2;
+			d_se += 2;
+		} else {
+			df += d_se;
+			d_e += 2;
+			d_se += 4;
+			cy--;
+		}
+		cx++;
+	} while (cx <= cy);
+
+	/*
+	* Draw body
+	*/
+	for (y = yy1 + 1; y < yy2; y++) {
+		_gfxSpan(&span, x1, x2, y);
+	}
+
+	/*
+	* Unlock surface 
+	*/
+	_gfxSpanEnd(&span);
+
+	return (0);
+}
+
+/*!
+\brief Draw rounded-corner box (filled rectangle) with blending.
+
+\param dst The surface to draw on.
+\param x1 X coordinate of the first point (i.e. top right) of the box.
+\param y1 Y coordinate of the first point (i.e. top right) of the box.
+\param x2 X coordinate of the second point (i.e. bottom left) of the box.
+\param y2 Y coordinate of the second point (i.e. bottom left) of the box.
 \param rad The radius of the corner arcs of the box.
 \param r The red value of the box to draw. 
 \param g The green value of the box to draw. 
@@ -3485,7 +3660,7 @@ multiple-hline draw removal and other minor speedup changes.
 int filledCircleColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Uint32 color)
 {
 	Sint16 left, right, top, bottom;
-	int result;
+	SDL_gfxSpanContext span;
 	Sint16 x1, y1, x2, y2;
 	Sint16 cx = 0;
 	Sint16 cy = rad;
@@ -3543,10 +3718,16 @@ int filledCircleColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Uint32
 		return(0);
 	} 
 
+	/*
+	* Setup color and lock the surface once for all spans
+	*/
+	if (_gfxSpanBegin(&span, dst, color) < 0) {
+		return (-1);
+	}
+
 	/*
 	* Draw 
 	*/
-	result = 0;
 	do {
 		xpcx = x + cx;
 		xmcx = x - cx;
@@ -3556,10 +3737,10 @@ int filledCircleColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Uint32
 			if (cy > 0) {
 				ypcy = y + cy;
 				ymcy = y - cy;
-				result |= hlineColor(dst, xmcx, xpcx, ypcy, color);
-				result |= hlineColor(dst, xmcx, xpcx, ymcy, color);
+				_gfxSpan(&span, xmcx, xpcx, ypcy);
+				_gfxSpan(&span, xmcx, xpcx, ymcy);
 			} else {
-				result |= hlineColor(dst, xmcx, xpcx, y, color);
+				_gfxSpan(&span, xmcx, xpcx, y);
 			}
 			ocy = cy;
 		}
@@ -3568,10 +3749,10 @@ int filledCircleColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Uint32
 				if (cx > 0) {
 					ypcx = y + cx;
 					ymcx = y - cx;
-					result |= hlineColor(dst, xmcy, xpcy, ymcx, color);
-					result |= hlineColor(dst, xmcy, xpcy, ypcx, color);
+					_gfxSpan(&span, xmcy, xpcy, ymcx);
+					_gfxSpan(&span, xmcy, xpcy, ypcx);
 				} else {
-					result |= hlineColor(dst, xmcy, xpcy, y, color);
+					_gfxSpan(&span, xmcy, xpcy, y);
 				}
 			}
 			ocx = cx;
@@ -3592,7 +3773,12 @@ int filledCircleColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rad, Uint32
 		cx++;
 	} while (cx <= cy);
 
-	return (result);
+	/*
+	* Unlock surface 
+	*/
+	_gfxSpanEnd(&span);
+
+	return (0);
 }
 
 /*!
@@ -4287,7 +4473,7 @@ and other speedup changes.
 int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry, Uint32 color)
 {
 	Sint16 left, right, top, bottom;
-	int result;
+	SDL_gfxSpanContext span;
 	Sint16 x1, y1, x2, y2;
 	int ix, iy;
 	int h, i, j, k;
@@ -4354,10 +4540,16 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 	*/
 	oh = oi = oj = ok = 0xFFFF;
 
+	/*
+	* Setup color and lock the surface once for all spans
+	*/
+	if (_gfxSpanBegin(&span, dst, color) < 0) {
+		return (-1);
+	}
+
 	/*
 	* Draw 
 	*/
-	result = 0;
 	if (rx > ry) {
 		ix = 0;
 		iy = rx * 64;
@@ -4372,10 +4564,10 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 				xph = x + h;
 				xmh = x - h;
 				if (k > 0) {
-					result |= hlineColor(dst, xmh, xph, y + k, color);
-					result |= hlineColor(dst, xmh, xph, y - k, color);
+					_gfxSpan(&span, xmh, xph, y + k);
+					_gfxSpan(&span, xmh, xph, y - k);
 				} else {
-					result |= hlineColor(dst, xmh, xph, y, color);
+					_gfxSpan(&span, xmh, xph, y);
 				}
 				ok = k;
 			}
@@ -4383,10 +4575,10 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 				xmi = x - i;
 				xpi = x + i;
 				if (j > 0) {
-					result |= hlineColor(dst, xmi, xpi, y + j, color);
-					result |= hlineColor(dst, xmi, xpi, y - j, color);
+					_gfxSpan(&span, xmi, xpi, y + j);
+					_gfxSpan(&span, xmi, xpi, y - j);
 				} else {
-					result |= hlineColor(dst, xmi, xpi, y, color);
+					_gfxSpan(&span, xmi, xpi, y);
 				}
 				oj = j;
 			}
@@ -4409,10 +4601,10 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 				xmj = x - j;
 				xpj = x + j;
 				if (i > 0) {
-					result |= hlineColor(dst, xmj, xpj, y + i, color);
-					result |= hlineColor(dst, xmj, xpj, y - i, color);
+					_gfxSpan(&span, xmj, xpj, y + i);
+					_gfxSpan(&span, xmj, xpj, y - i);
 				} else {
-					result |= hlineColor(dst, xmj, xpj, y, color);
+					_gfxSpan(&span, xmj, xpj, y);
 				}
 				oi = i;
 			}
@@ -4420,10 +4612,10 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 				xmk = x - k;
 				xpk = x + k;
 				if (h > 0) {
-					result |= hlineColor(dst, xmk, xpk, y + h, color);
-					result |= hlineColor(dst, xmk, xpk, y - h, color);
+					_gfxSpan(&span, xmk, xpk, y + h);
+					_gfxSpan(&span, xmk, xpk, y - h);
 				} else {
-					result |= hlineColor(dst, xmk, xpk, y, color);
+					_gfxSpan(&span, xmk, xpk, y);
 				}
 				oh = h;
 			}
@@ -4434,7 +4626,12 @@ int filledEllipseColor(SDL_Surface * dst, Sint16 x, Sint16 y, Sint16 rx, Sint16
 		} while (i > h);
 	}
 
-	return (result);
+	/*
+	* Unlock surface 
+	*/
+	_gfxSpanEnd(&span);
+
+	return (0);
 }
 
 /*!
@@ -5094,38 +5291,26 @@ int _gfxPrimitivesCompareInt(const void *a, const void *b)
 	return (*(const int *) a) - (*(const int *) b);
 }
 
-/*!
-\brief Global vertex array to use if optional parameters are not given in filledPolygonMT calls.
-
-Note: Used for non-multithreaded (default) operation of filledPolygonMT.
-*/
-static int *gfxPrimitivesPolyIntsGlobal = NULL;
-
-/*!
-\brief Flag indicating if global vertex array was already allocated.
-
-Note: Used for non-multithreaded (default) operation of filledPolygonMT.
-*/
-static int gfxPrimitivesPolyAllocatedGlobal = 0;
-
 /*!
 \brief Draw filled polygon with alpha blending (multi-threaded capable).
 
-Note: The last two parameters are optional; but are required for multithreaded operation.  
+Note: The last two parameters are optional. When given, the temporary vertex array
+is kept in the caller's cache and reused across calls; when NULL, a scratch array is
+allocated and freed within the call. No global state is used, so the function is reentrant.
 
 \param dst The surface to draw on.
 \param vx Vertex array containing X coordinates of the points of the filled polygon.
 \param vy Vertex array containing Y coordinates of the points of the filled polygon.
 \param n Number of points in the vertex array. Minimum number is 3.
 \param color The color value of the filled polygon to draw (0xRRGGBBAA). 
-\param polyInts Preallocated, temporary vertex array used for sorting vertices. Required for multithreaded operation; set to NULL otherwise.
-\param polyAllocated Flag indicating if temporary vertex array was allocated. Required for multithreaded operation; set to NULL otherwise.
+\param polyInts Preallocated, temporary vertex array used for sorting vertices, or NULL.
+\param polyAllocated Flag indicating if temporary vertex array was allocated, or NULL.
 
 \returns Returns 0 on success, -1 on failure.
 */
 int filledPolygonColorMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, int n, Uint32 color, int **polyInts, int *polyAllocated)
 {
-	int result;
+	SDL_gfxSpanContext span;
 	int i;
 	int y, xa, xb;
 	int miny, maxy;
@@ -5136,6 +5321,8 @@ int filledPolygonColorMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy
 	int *gfxPrimitivesPolyInts = NULL;
 	int *gfxPrimitivesPolyIntsNew = NULL;
 	int gfxPrimitivesPolyAllocated = 0;
+	int *gfxPrimitivesPolyIntsScratch = NULL;
+	int gfxPrimitivesPolyAllocatedScratch = 0;
 
 	/*
 	* Check visibility of clipping rectangle
@@ -5165,14 +5352,12 @@ int filledPolygonColorMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy
 	* Map polygon cache  
 	*/
 	if ((polyInts==NULL) || (polyAllocated==NULL)) {
-		/* Use global cache */
-		gfxPrimitivesPolyInts = gfxPrimitivesPolyIntsGlobal;
-		gfxPrimitivesPolyAllocated = gfxPrimitivesPolyAllocatedGlobal;
-	} else {
-		/* Use local cache */
-		gfxPrimitivesPolyInts = *polyInts;
-		gfxPrimitivesPolyAllocated = *polyAllocated;
+		/* Use per-call scratch, freed before returning */
+		polyInts = &gfxPrimitivesPolyIntsScratch;
+		polyAllocated = &gfxPrimitivesPolyAllocatedScratch;
 	}
+	gfxPrimitivesPolyInts = *polyInts;
+	gfxPrimitivesPolyAllocated = *polyAllocated;
 
 	/*
 	* Allocate temp array, only grow array 
@@ -5184,10 +5369,8 @@ int filledPolygonColorMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy
 		if (gfxPrimitivesPolyAllocated < n) {
 			gfxPrimitivesPolyIntsNew = (int *) realloc(gfxPrimitivesPolyInts, sizeof(int) * n);
 			if (!gfxPrimitivesPolyIntsNew) {
-				if (!gfxPrimitivesPolyInts) {
-					free(gfxPrimitivesPolyInts);
-					gfxPrimitivesPolyInts = NULL;
-				}
+				free(gfxPrimitivesPolyInts);
+				gfxPrimitivesPolyInts = NULL;
 				gfxPrimitivesPolyAllocated = 0;
 			} else {
 				gfxPrimitivesPolyInts = gfxPrimitivesPolyIntsNew;
@@ -5206,13 +5389,8 @@ int filledPolygonColorMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy
 	/*
 	* Update cache variables
 	*/
-	if ((polyInts==NULL) || (polyAllocated==NULL)) { 
-		gfxPrimitivesPolyIntsGlobal =  gfxPrimitivesPolyInts;
-		gfxPrimitivesPolyAllocatedGlobal = gfxPrimitivesPolyAllocated;
-	} else {
-		*polyInts = gfxPrimitivesPolyInts;
-		*polyAllocated = gfxPrimitivesPolyAllocated;
-	}
+	*polyInts = gfxPrimitivesPolyInts;
+	*polyAllocated = gfxPrimitivesPolyAllocated;
 
 	/*
 	* Check temp array again
@@ -5234,10 +5412,17 @@ int filledPolygonColorMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy
 		}
 	}
 
+	/*
+	* Setup color and lock the surface once for all spans
+	*/
+	if (_gfxSpanBegin(&span, dst, color) < 0) {
+		free(gfxPrimitivesPolyIntsScratch);
+		return (-1);
+	}
+
 	/*
 	* Draw, scanning y 
 	*/
-	result = 0;
 	for (y = miny; (y <= maxy); y++) {
 		ints = 0;
 		for (i = 0; (i < n); i++) {
@@ -5273,11 +5458,21 @@ int filledPolygonColorMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy
 			xa = (xa >> 16) + ((xa & 32768) >> 15);
 			xb = gfxPrimitivesPolyInts[i+1] - 1;
 			xb = (xb >> 16) + ((xb & 32768) >> 15);
-			result |= hlineColor(dst, xa, xb, y, color);
+			_gfxSpan(&span, xa, xb, y);
 		}
 	}
 
-	return (result);
+	/*
+	* Unlock surface 
+	*/
+	_gfxSpanEnd(&span);
+
+	/*
+	* Release per-call scratch
+	*/
+	free(gfxPrimitivesPolyIntsScratch);
+
+	return (0);
 }
 
 /*!
@@ -5485,7 +5680,7 @@ alpha drawing.
 
 To get the best performance of this operation you need to make sure the texture and the dst surface have the same format
 (see  http://docs.mandragor.org/files/Common_libs_documentation/SDL/SDL_Documentation_project_en/sdlblitsurface.html).
-The last two parameters are optional, but required for multithreaded operation. When set to NULL, uses global static temp array.
+The last two parameters are optional. When set to NULL, a temp array is allocated and freed within the call.
 
 \param dst the destination surface, 
 \param vx array of x vector components
@@ -5512,7 +5707,10 @@ int texturedPolygonMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, i
 	int ind1, ind2;
 	int ints;
 	int *gfxPrimitivesPolyInts = NULL;
+	int *gfxPrimitivesPolyIntsNew = NULL;
 	int gfxPrimitivesPolyAllocated = 0;
+	int *gfxPrimitivesPolyIntsScratch = NULL;
+	int gfxPrimitivesPolyAllocatedScratch = 0;
 
 	/*
 	* Check visibility of clipping rectangle
@@ -5532,14 +5730,12 @@ int texturedPolygonMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, i
 	* Map polygon cache  
 	*/
 	if ((polyInts==NULL) || (polyAllocated==NULL)) {
-		/* Use global cache */
-		gfxPrimitivesPolyInts = gfxPrimitivesPolyIntsGlobal;
-		gfxPrimitivesPolyAllocated = gfxPrimitivesPolyAllocatedGlobal;
-	} else {
-		/* Use local cache */
-		gfxPrimitivesPolyInts = *polyInts;
-		gfxPrimitivesPolyAllocated = *polyAllocated;
+		/* Use per-call scratch, freed before returning */
+		polyInts = &gfxPrimitivesPolyIntsScratch;
+		polyAllocated = &gfxPrimitivesPolyAllocatedScratch;
 	}
+	gfxPrimitivesPolyInts = *polyInts;
+	gfxPrimitivesPolyAllocated = *polyAllocated;
 
 	/*
 	* Allocate temp array, only grow array 
@@ -5549,8 +5745,15 @@ int texturedPolygonMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, i
 		gfxPrimitivesPolyAllocated = n;
 	} else {
 		if (gfxPrimitivesPolyAllocated < n) {
-			gfxPrimitivesPolyInts = (int *) realloc(gfxPrimitivesPolyInts, sizeof(int) * n);
-			gfxPrimitivesPolyAllocated = n;
+			gfxPrimitivesPolyIntsNew = (int *) realloc(gfxPrimitivesPolyInts, sizeof(int) * n);
+			if (!gfxPrimitivesPolyIntsNew) {
+				free(gfxPrimitivesPolyInts);
+				gfxPrimitivesPolyInts = NULL;
+				gfxPrimitivesPolyAllocated = 0;
+			} else {
+				gfxPrimitivesPolyInts = gfxPrimitivesPolyIntsNew;
+				gfxPrimitivesPolyAllocated = n;
+			}
 		}
 	}
 
@@ -5564,13 +5767,8 @@ int texturedPolygonMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, i
 	/*
 	* Update cache variables
 	*/
-	if ((polyInts==NULL) || (polyAllocated==NULL)) { 
-		gfxPrimitivesPolyIntsGlobal =  gfxPrimitivesPolyInts;
-		gfxPrimitivesPolyAllocatedGlobal = gfxPrimitivesPolyAllocated;
-	} else {
-		*polyInts = gfxPrimitivesPolyInts;
-		*polyAllocated = gfxPrimitivesPolyAllocated;
-	}
+	*polyInts = gfxPrimitivesPolyInts;
+	*polyAllocated = gfxPrimitivesPolyAllocated;
 
 	/*
 	* Check temp array again
@@ -5599,9 +5797,11 @@ int texturedPolygonMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, i
 		}
 	}
 	if (maxx <0 || minx > dst->w){
+		free(gfxPrimitivesPolyIntsScratch);
 		return -1;
 	}
 	if (maxy <0 || miny > dst->h){
+		free(gfxPrimitivesPolyIntsScratch);
 		return -1;
 	}
 
@@ -5648,6 +5848,11 @@ int texturedPolygonMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, i
 		}
 	}
 
+	/*
+	* Release per-call scratch
+	*/
+	free(gfxPrimitivesPolyIntsScratch);
+
 	return (result);
 }
 
@@ -5675,6 +5880,533 @@ int texturedPolygon(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, int
 	return (texturedPolygonMT(dst, vx, vy, n, texture, texture_dx, texture_dy, NULL, NULL));
 }
 
+/* ---- Textured triangles */
+
+/*!
+\brief Internal state shared by all spans of a texturedTriangles call.
+*/
+typedef struct {
+	SDL_Surface *dst;
+	SDL_Surface *texture;
+	int bilinear;
+	int fast;
+	int blend;
+	int colorkey;
+	Uint32 key;
+	Uint32 amask;
+	Uint32 lane;
+	Uint8 lshift;
+	Uint8 constalpha;
+	int srcalpha;
+} SDL_gfxTexContext;
+
+/*!
+\brief Internal helper to wrap a texel coordinate into [0,size).
+*/
+static int _texWrap(int t, int size)
+{
+	t %= size;
+	if (t < 0) {
+		t += size;
+	}
+	return (t);
+}
+
+/*!
+\brief Internal helper to read a raw pixel value of any depth.
+*/
+static Uint32 _texGetRaw(const Uint8 *p, int bpp)
+{
+	switch (bpp) {
+	case 1:
+		return (*p);
+	case 2:
+		return (*(const Uint16 *) p);
+	case 3:
+		if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
+			return ((p[0] << 16) | (p[1] << 8) | p[2]);
+		} else {
+			return (p[0] | (p[1] << 8) | (p[2] << 16));
+		}
+	default:
+		return (*(const Uint32 *) p);
+	}
+}
+
+/*!
+\brief Internal helper to store a raw pixel value of any depth.
+*/
+static void _texPutRaw(Uint8 *p, int bpp, Uint32 color)
+{
+	switch (bpp) {
+	case 1:
+		*p = color;
+		break;
+	case 2:
+		*(Uint16 *) p = color;
+		break;
+	case 3:
+		if (SDL_BYTEORDER == SDL_BIG_ENDIAN) {
+			p[0] = (color >> 16) & 0xff;
+			p[1] = (color >> 8) & 0xff;
+			p[2] = color & 0xff;
+		} else {
+			p[0] = color & 0xff;
+			p[1] = (color >> 8) & 0xff;
+			p[2] = (color >> 16) & 0xff;
+		}
+		break;
+	default:
+		*(Uint32 *) p = color;
+		break;
+	}
+}
+
+/*!
+\brief Internal helper to fetch a 32bpp texel with its effective alpha stored in the alpha lane.
+*/
+static __inline Uint32 _texFetch32(SDL_gfxTexContext *ctx, int tx, int ty)
+{
+	SDL_Surface *texture = ctx->texture;
+	Uint32 t = ((Uint32 *) ((Uint8 *) texture->pixels + ty * texture->pitch))[tx];
+
+	if (ctx->blend) {
+		if (ctx->colorkey && ((t & ~ctx->amask) == ctx->key)) {
+			t &= ~ctx->lane;
+		} else if (!(ctx->srcalpha && ctx->amask)) {
+			t = (t & ~ctx->lane) | ((Uint32) ctx->constalpha << ctx->lshift);
+		}
+	}
+	return (t);
+}
+
+/*!
+\brief Internal helper to linearly interpolate the four byte lanes of two packed pixels.
+*/
+static __inline Uint32 _texLerp32(Uint32 a, Uint32 b, Uint32 f)
+{
+	Uint32 rb, ag;
+
+	rb = (((a & 0x00ff00ff) * (256 - f) + (b & 0x00ff00ff) * f) >> 8) & 0x00ff00ff;
+	ag = (((a >> 8) & 0x00ff00ff) * (256 - f) + ((b >> 8) & 0x00ff00ff) * f) & 0xff00ff00;
+	return (rb | ag);
+}
+
+/*!
+\brief Internal helper to draw one textured span when source and destination share a 32bpp layout.
+*/
+static void _texSpan32(SDL_gfxTexContext *ctx, Uint32 *pixel, int n, Sint32 u, Sint32 v, Sint32 du, Sint32 dv)
+{
+	SDL_Surface *texture = ctx->texture;
+	int tw = texture->w, th = texture->h;
+	int tx, ty, tx1, ty1, fx, fy;
+	Uint32 s, d, a, rb, ag;
+
+	if (!ctx->bilinear && !ctx->blend) {
+		for (; n > 0; n--, pixel++, u += du, v += dv) {
+			tx = u >> 16;
+			ty = v >> 16;
+			if ((unsigned) tx >= (unsigned) tw) {
+				tx = _texWrap(tx, tw);
+			}
+			if ((unsigned) ty >= (unsigned) th) {
+				ty = _texWrap(ty, th);
+			}
+			*pixel = ((Uint32 *) ((Uint8 *) texture->pixels + ty * texture->pitch))[tx];
+		}
+		return;
+	}
+
+	for (; n > 0; n--, pixel++, u += du, v += dv) {
+		if (ctx->bilinear) {
+			tx = (u - 0x8000) >> 16;
+			ty = (v - 0x8000) >> 16;
+			fx = ((u - 0x8000) >> 8) & 0xff;
+			fy = ((v - 0x8000) >> 8) & 0xff;
+			tx1 = tx + 1;
+			ty1 = ty + 1;
+			if ((unsigned) tx >= (unsigned) tw) {
+				tx = _texWrap(tx, tw);
+			}
+			if ((unsigned) tx1 >= (unsigned) tw) {
+				tx1 = _texWrap(tx1, tw);
+			}
+			if ((unsigned) ty >= (unsigned) th) {
+				ty = _texWrap(ty, th);
+			}
+			if ((unsigned) ty1 >= (unsigned) th) {
+				ty1 = _texWrap(ty1, th);
+			}
+			s = _texLerp32(
+				_texLerp32(_texFetch32(ctx, tx, ty), _texFetch32(ctx, tx1, ty), fx),
+				_texLerp32(_texFetch32(ctx, tx, ty1), _texFetch32(ctx, tx1, ty1), fx),
+				fy);
+		} else {
+			tx = u >> 16;
+			ty = v >> 16;
+			if ((unsigned) tx >= (unsigned) tw) {
+				tx = _texWrap(tx, tw);
+			}
+			if ((unsigned) ty >= (unsigned) th) {
+				ty = _texWrap(ty, th);
+			}
+			s = _texFetch32(ctx, tx, ty);
+		}
+
+		if (!ctx->blend) {
+			*pixel = s;
+			continue;
+		}
+
+		/*
+		* Blend the color lanes, keep the destination alpha lane
+		*/
+		a = (s & ctx->lane) >> ctx->lshift;
+		if (a == 0) {
+			continue;
+		}
+		d = *pixel;
+		if (a == 255) {
+			*pixel = (s & ~ctx->lane) | (d & ctx->lane);
+			continue;
+		}
+		rb = (((d & 0x00ff00ff) * (256 - a) + (s & 0x00ff00ff) * a) >> 8) & 0x00ff00ff;
+		ag = (((d >> 8) & 0x00ff00ff) * (256 - a) + ((s >> 8) & 0x00ff00ff) * a) & 0xff00ff00;
+		*pixel = ((rb | ag) & ~ctx->lane) | (d & ctx->lane);
+	}
+}
+
+/*!
+\brief Internal helper to fetch a texel of any depth as RGBA with its effective alpha.
+*/
+static void _texFetchRGBA(SDL_gfxTexContext *ctx, int tx, int ty, Uint8 *rgba)
+{
+	SDL_Surface *texture = ctx->texture;
+	Uint32 t;
+
+	t = _texGetRaw((Uint8 *) texture->pixels + ty * texture->pitch + tx * texture->format->BytesPerPixel,
+		texture->format->BytesPerPixel);
+	SDL_GetRGBA(t, texture->format, &rgba[0], &rgba[1], &rgba[2], &rgba[3]);
+	if (!(ctx->srcalpha && ctx->amask)) {
+		rgba[3] = ctx->constalpha;
+	}
+	if (ctx->colorkey && ((t & ~ctx->amask) == ctx->key)) {
+		rgba[3] = 0;
+	}
+}
+
+/*!
+\brief Internal helper to draw one textured span for arbitrary source and destination formats.
+*/
+static void _texSpanGeneric(SDL_gfxTexContext *ctx, Uint8 *pixel, int n, Sint32 u, Sint32 v, Sint32 du, Sint32 dv)
+{
+	SDL_PixelFormat *format = ctx->dst->format;
+	int bpp = format->BytesPerPixel;
+	int tw = ctx->texture->w, th = ctx->texture->h;
+	int tx, ty, tx1, ty1, fx, fy, i;
+	Uint32 w00, w10, w01, w11, a;
+	Uint8 s[4], t00[4], t10[4], t01[4], t11[4], d[4];
+
+	for (; n > 0; n--, pixel += bpp, u += du, v += dv) {
+		if (ctx->bilinear) {
+			tx = (u - 0x8000) >> 16;
+			ty = (v - 0x8000) >> 16;
+			fx = ((u - 0x8000) >> 8) & 0xff;
+			fy = ((v - 0x8000) >> 8) & 0xff;
+			tx1 = _texWrap(tx + 1, tw);
+			ty1 = _texWrap(ty + 1, th);
+			tx = _texWrap(tx, tw);
+			ty = _texWrap(ty, th);
+			_texFetchRGBA(ctx, tx, ty, t00);
+			_texFetchRGBA(ctx, tx1, ty, t10);
+			_texFetchRGBA(ctx, tx, ty1, t01);
+			_texFetchRGBA(ctx, tx1, ty1, t11);
+			w00 = (256 - fx) * (256 - fy);
+			w10 = fx * (256 - fy);
+			w01 = (256 - fx) * fy;
+			w11 = fx * fy;
+			for (i = 0; i < 4; i++) {
+				s[i] = (t00[i] * w00 + t10[i] * w10 + t01[i] * w01 + t11[i] * w11) >> 16;
+			}
+		} else {
+			_texFetchRGBA(ctx, _texWrap(u >> 16, tw), _texWrap(v >> 16, th), s);
+		}
+
+		if (!ctx->blend) {
+			_texPutRaw(pixel, bpp, SDL_MapRGBA(format, s[0], s[1], s[2], s[3]));
+			continue;
+		}
+
+		a = s[3];
+		if (a == 0) {
+			continue;
+		}
+		SDL_GetRGBA(_texGetRaw(pixel, bpp), format, &d[0], &d[1], &d[2], &d[3]);
+		if (a != 255) {
+			for (i = 0; i < 3; i++) {
+				s[i] = (d[i] * (256 - a) + s[i] * a) >> 8;
+			}
+		}
+		_texPutRaw(pixel, bpp, SDL_MapRGBA(format, s[0], s[1], s[2], d[3]));
+	}
+}
+
+/*!
+\brief Internal helper to compute the x coordinate where an edge crosses a scanline.
+
+The edge is always evaluated from its upper to its lower vertex, so that two triangles 
+sharing an edge compute identical crossings and neither overdraw nor leave gaps.
+*/
+static __inline double _texEdgeX(double x0, double y0, double x1, double y1, double y)
+{
+	return (x0 + (x1 - x0) * (y - y0) / (y1 - y0));
+}
+
+/*!
+\brief Internal helper to convert a texture coordinate or step to 16.16 fixed point.
+
+Sampling wraps around the texture, so the value is first reduced modulo its size; the
+result then stays well inside Sint32 however far the plane is extrapolated.
+*/
+static __inline Sint32 _texFixed(double t, int size)
+{
+	return ((Sint32) (fmod(t, (double) size) * 65536.0));
+}
+
+/*!
+\brief Internal helper to rasterize one affine textured triangle.
+
+Pixels are sampled at their centers with a top-left fill rule. The texture gradients
+are constant over the triangle and computed once; each span steps them in 16.16 fixed point.
+*/
+static void _texTriangle(SDL_gfxTexContext *ctx, const double *px, const double *py, const double *pu, const double *pv)
+{
+	SDL_Surface *dst = ctx->dst;
+	int a = 0, b = 1, c = 2, t;
+	int y, ystart, yend, xstart, xend, x, len, maxlen;
+	int left, right, top, bottom;
+	int tw = ctx->texture->w, th = ctx->texture->h;
+	double area, dudx, dudy, dvdx, dvdy, du, dv;
+	double yc, xl, xr, xs, u, v;
+
+	/*
+	* Sort vertices by y
+	*/
+	if (py[b] < py[a]) { t = a; a = b; b = t; }
+	if (py[c] < py[b]) { t = b; b = c; c = t; }
+	if (py[b] < py[a]) { t = a; a = b; b = t; }
+
+	area = (px[b] - px[a]) * (py[c] - py[a]) - (px[c] - px[a]) * (py[b] - py[a]);
+	if (area == 0.0) {
+		return;
+	}
+
+	/*
+	* Constant texture gradients of the triangle plane
+	*/
+	dudx = ((pu[b] - pu[a]) * (py[c] - py[a]) - (pu[c] - pu[a]) * (py[b] - py[a])) / area;
+	dvdx = ((pv[b] - pv[a]) * (py[c] - py[a]) - (pv[c] - pv[a]) * (py[b] - py[a])) / area;
+	dudy = ((pu[c] - pu[a]) * (px[b] - px[a]) - (pu[b] - pu[a]) * (px[c] - px[a])) / area;
+	dvdy = ((pv[c] - pv[a]) * (px[b] - px[a]) - (pv[b] - pv[a]) * (px[c] - px[a])) / area;
+
+	/*
+	* Longest run whose 16.16 coordinates, starting inside one texture period, cannot
+	* overflow; longer spans restart from a freshly wrapped coordinate.
+	*/
+	du = fabs(fmod(dudx, (double) tw));
+	dv = fabs(fmod(dvdx, (double) th));
+	if (du < dv) {
+		du = dv;
+	}
+	maxlen = 0x7fffffff;
+	if (du > 0.0) {
+		dv = (32766.0 - (tw > th ? tw : th)) / du;
+		maxlen = dv < 1.0 ? 1 : (dv < 0x7fffffff ? (int) dv : 0x7fffffff);
+	}
+
+	left = dst->clip_rect.x;
+	right = dst->clip_rect.x + dst->clip_rect.w;
+	top = dst->clip_rect.y;
+	bottom = dst->clip_rect.y + dst->clip_rect.h;
+
+	ystart = (int) ceil(py[a] - 0.5);
+	yend = (int) ceil(py[c] - 0.5);
+	if (ystart < top) {
+		ystart = top;
+	}
+	if (yend > bottom) {
+		yend = bottom;
+	}
+
+	for (y = ystart; y < yend; y++) {
+		yc = y + 0.5;
+		xl = _texEdgeX(px[a], py[a], px[c], py[c], yc);
+		if (yc < py[b]) {
+			xr = _texEdgeX(px[a], py[a], px[b], py[b], yc);
+		} else {
+			xr = _texEdgeX(px[b], py[b], px[c], py[c], yc);
+		}
+		if (xr < xl) {
+			xs = xl;
+			xl = xr;
+			xr = xs;
+		}
+
+		xstart = (int) ceil(xl - 0.5);
+		xend = (int) ceil(xr - 0.5);
+		if (xstart < left) {
+			xstart = left;
+		}
+		if (xend > right) {
+			xend = right;
+		}
+		if (xstart >= xend) {
+			continue;
+		}
+
+		for (x = xstart; x < xend; x += len) {
+			len = xend - x;
+			if (len > maxlen) {
+				len = maxlen;
+			}
+
+			/*
+			* Evaluate the plane at the first pixel center of the run
+			*/
+			xs = x + 0.5;
+			u = pu[a] + dudx * (xs - px[a]) + dudy * (yc - py[a]);
+			v = pv[a] + dvdx * (xs - px[a]) + dvdy * (yc - py[a]);
+
+			if (ctx->fast) {
+				_texSpan32(ctx, (Uint32 *) ((Uint8 *) dst->pixels + y * dst->pitch) + x, len,
+					_texFixed(u, tw), _texFixed(v, th),
+					_texFixed(dudx, tw), _texFixed(dvdx, th));
+			} else {
+				_texSpanGeneric(ctx, (Uint8 *) dst->pixels + y * dst->pitch + x * dst->format->BytesPerPixel, len,
+					_texFixed(u, tw), _texFixed(v, th),
+					_texFixed(dudx, tw), _texFixed(dvdx, th));
+			}
+		}
+	}
+}
+
+/*!
+\brief Check if a 32bpp format has all its channels on whole bytes.
+*/
+static int _texByteLanes(SDL_PixelFormat *format)
+{
+	return ((format->BytesPerPixel == 4) && 
+		(format->Rloss == 0) && (format->Gloss == 0) && (format->Bloss == 0) && 
+		(format->Rshift % 8 == 0) && (format->Gshift % 8 == 0) && (format->Bshift % 8 == 0) &&
+		((format->Amask == 0) || ((format->Aloss == 0) && (format->Ashift % 8 == 0))));
+}
+
+/*!
+\brief Draw a list of affine textured triangles.
+
+Each group of three consecutive vertices forms one triangle. Texture coordinates are given
+in texels as 16.16 fixed point values and wrap around the texture edges. The texture is 
+drawn with its per-pixel or per-surface alpha and colorkey, as SDL_BlitSurface would.
+Source and destination surfaces sharing a 32bpp layout take a fast path that copies or 
+blends packed pixels directly.
+
+\param dst The surface to draw on.
+\param vx Vertex array containing X coordinates of the triangle corners.
+\param vy Vertex array containing Y coordinates of the triangle corners.
+\param vu Array of texture X coordinates for each vertex (16.16 fixed point).
+\param vv Array of texture Y coordinates for each vertex (16.16 fixed point).
+\param n Number of vertices; must be a positive multiple of 3.
+\param texture The surface to sample from.
+\param bilinear Use bilinear filtering instead of nearest texel sampling when non-zero.
+
+\returns Returns 0 on success, -1 on failure.
+*/
+int texturedTriangles(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, const Sint32 * vu, const Sint32 * vv, 
+					  int n, SDL_Surface * texture, int bilinear)
+{
+	SDL_gfxTexContext ctx;
+	SDL_PixelFormat *tf;
+	double px[3], py[3], pu[3], pv[3];
+	int i, k;
+
+	/*
+	* Sanity checks
+	*/
+	if ((vx == NULL) || (vy == NULL) || (vu == NULL) || (vv == NULL) || (texture == NULL)) {
+		return (-1);
+	}
+	if ((n < 3) || (n % 3)) {
+		return (-1);
+	}
+	if ((texture->w == 0) || (texture->h == 0)) {
+		return (0);
+	}
+	if ((dst->clip_rect.w == 0) || (dst->clip_rect.h == 0)) {
+		return (0);
+	}
+
+	/*
+	* Setup sampling state
+	*/
+	tf = texture->format;
+	ctx.dst = dst;
+	ctx.texture = texture;
+	ctx.bilinear = bilinear;
+	ctx.amask = tf->Amask;
+	ctx.srcalpha = (texture->flags & SDL_SRCALPHA) != 0;
+	ctx.colorkey = (texture->flags & SDL_SRCCOLORKEY) != 0;
+	ctx.key = tf->colorkey;
+	ctx.constalpha = ctx.srcalpha ? tf->alpha : 255;
+	ctx.blend = ctx.colorkey || (ctx.srcalpha && (tf->Amask || (tf->alpha != 255)));
+	ctx.fast = _texByteLanes(tf) && _texByteLanes(dst->format) &&
+		(tf->Rmask == dst->format->Rmask) && (tf->Gmask == dst->format->Gmask) &&
+		(tf->Bmask == dst->format->Bmask) && (tf->Amask == dst->format->Amask);
+	ctx.lane = tf->Amask ? tf->Amask : ~(tf->Rmask | tf->Gmask | tf->Bmask);
+	for (ctx.lshift = 0; ctx.lshift < 32 && !((ctx.lane >> ctx.lshift) & 1); ctx.lshift += 8);
+
+	/*
+	* Lock the surfaces once for all triangles
+	*/
+	if (SDL_MUSTLOCK(dst)) {
+		if (SDL_LockSurface(dst) < 0) {
+			return (-1);
+		}
+	}
+	if ((texture != dst) && SDL_MUSTLOCK(texture)) {
+		if (SDL_LockSurface(texture) < 0) {
+			if (SDL_MUSTLOCK(dst)) {
+				SDL_UnlockSurface(dst);
+			}
+			return (-1);
+		}
+	}
+
+	/*
+	* Draw
+	*/
+	for (i = 0; i < n; i += 3) {
+		for (k = 0; k < 3; k++) {
+			px[k] = vx[i + k];
+			py[k] = vy[i + k];
+			pu[k] = vu[i + k] / 65536.0;
+			pv[k] = vv[i + k] / 65536.0;
+		}
+		_texTriangle(&ctx, px, py, pu, pv);
+	}
+
+	/*
+	* Unlock surfaces
+	*/
+	if ((texture != dst) && SDL_MUSTLOCK(texture)) {
+		SDL_UnlockSurface(texture);
+	}
+	if (SDL_MUSTLOCK(dst)) {
+		SDL_UnlockSurface(dst);
+	}
+
+	return (0);
+}
+
 
 /* ---- Character */
 
@@ -202,6 +202,11 @@ extern "C" {
 		int **polyInts, int *polyAllocated);
 	SDL_GFXPRIMITIVES_SCOPE int texturedPolygonMT(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, int n, SDL_Surface * texture,int texture_dx,int texture_dy, int **polyInts, int *polyAllocated);
 
+	/* Textured Triangles */
+
+	SDL_GFXPRIMITIVES_SCOPE int texturedTriangles(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy,
+		const Sint32 * vu, const Sint32 * vv, int n, SDL_Surface * texture, int bilinear);
+
 	/* Bezier */
 
 	SDL_GFXPRIMITIVES_SCOPE int bezierColor(SDL_Surface * dst, const Sint16 * vx, const Sint16 * vy, int n, int s, Uint32 color);
@@ -36,6 +36,23 @@
 #include "camera.h"
 #include "pgcompat.h"
 
+/* SSE2 is part of the x86-64 baseline. 32 bit x86 gcc builds compile the
+ * conversion kernels for SSE2 per function and check SDL_HasSSE2 first.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CAMERA_SSE2_SUPPORT
+#define CAMERA_SSE2_TARGET
+#elif defined(__GNUC__) && !defined(__clang__) && defined(__i386__) && \
+      (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define CAMERA_SSE2_SUPPORT
+#define CAMERA_SSE2_TARGET __attribute__((target("sse2")))
+#endif
+
+#if defined(CAMERA_SSE2_SUPPORT)
+#include <emmintrin.h>
+#endif
+
 /*
 #if defined(__unix__) || !defined(__APPLE__)
 #else
@@ -46,7 +63,7 @@
 
 
 /* functions available to pygame users */
-PyObject* surf_colorspace (PyObject* self, PyObject* arg);
+PyObject* surf_colorspace (PyObject* self, PyObject* arg, PyObject *kwds);
 PyObject* list_cameras (PyObject* self, PyObject* arg);
 PyObject* camera_start (PyCameraObject* self);
 PyObject* camera_stop (PyCameraObject* self);
@@ -65,27 +82,157 @@ PyObject* camera_get_raw(PyCameraObject* self);
  * on the result, call v4l, v4l2, vfw, or other functions.
  */
 
+/* converts a raw YUYV or YUV420 frame held in a buffer into a Surface, the
+   same way a camera with that pixelformat would */
+static PyObject* raw_colorspace (PyObject* data, const char* source,
+                                 int cspace, PyObject* surfobj) {
+    SDL_Surface* surf;
+    unsigned long pixelformat;
+    const void* buf = NULL;
+    Py_ssize_t buflen = 0, need;
+    int size;
+#if HAVE_NEW_BUFPROTO
+    Py_buffer view;
+    int have_view = 0;
+#endif
+
+    if (!strcmp (source, "YUYV")) {
+        pixelformat = V4L2_PIX_FMT_YUYV;
+    } else if (!strcmp (source, "YUV420")) {
+        pixelformat = V4L2_PIX_FMT_YUV420;
+    } else {
+        return RAISE (PyExc_ValueError, "Incorrect source format");
+    }
+    if (!surfobj)
+        return RAISE (PyExc_ValueError,
+                      "raw frames need a destination Surface");
+
+    surf = PySurface_AsSurface (surfobj);
+    if (surf->w % 2 || (pixelformat == V4L2_PIX_FMT_YUV420 && surf->h % 2))
+        return RAISE (PyExc_ValueError, "frame size must be even");
+    /* the conversions write the rows back to back */
+    if (surf->pitch != surf->w * surf->format->BytesPerPixel)
+        return RAISE (PyExc_ValueError,
+                      "destination Surface rows must not be padded");
+    size = surf->w * surf->h;
+    if (pixelformat == V4L2_PIX_FMT_YUYV)
+        need = (Py_ssize_t) size * 2;
+    else
+        need = (Py_ssize_t) size * 3 / 2;
+
+#if HAVE_NEW_BUFPROTO
+#if PY2
+    if (PyObject_CheckBuffer (data)) {
+#endif
+        if (PyObject_GetBuffer (data, &view, PyBUF_SIMPLE))
+            return NULL;
+        have_view = 1;
+        buf = view.buf;
+        buflen = view.len;
+#if PY2
+    }
+#endif
+#endif
+#if PY2
+    if (!buf && PyObject_AsReadBuffer (data, &buf, &buflen))
+        return NULL;
+#endif
+
+    if (buflen < need) {
+#if HAVE_NEW_BUFPROTO
+        if (have_view)
+            PyBuffer_Release (&view);
+#endif
+        return RAISE (PyExc_ValueError, "buffer too small for the frame size");
+    }
+
+    if (!PySurface_Lock (surfobj)) {
+#if HAVE_NEW_BUFPROTO
+        if (have_view)
+            PyBuffer_Release (&view);
+#endif
+        return NULL;
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    if (pixelformat == V4L2_PIX_FMT_YUYV) {
+        switch (cspace) {
+            case YUV_OUT:
+                yuyv_to_yuv (buf, surf->pixels, size, surf->format);
+                break;
+            case RGB_OUT:
+                yuyv_to_rgb (buf, surf->pixels, size, surf->format);
+                break;
+            case HSV_OUT:
+                yuyv_to_rgb (buf, surf->pixels, size, surf->format);
+                rgb_to_hsv (surf->pixels, surf->pixels, size,
+                            V4L2_PIX_FMT_YUYV, surf->format);
+                break;
+        }
+    } else {
+        switch (cspace) {
+            case YUV_OUT:
+                yuv420_to_yuv (buf, surf->pixels, surf->w, surf->h,
+                               surf->format);
+                break;
+            case RGB_OUT:
+                yuv420_to_rgb (buf, surf->pixels, surf->w, surf->h,
+                               surf->format);
+                break;
+            case HSV_OUT:
+                yuv420_to_rgb (buf, surf->pixels, surf->w, surf->h,
+                               surf->format);
+                rgb_to_hsv (surf->pixels, surf->pixels, size,
+                            V4L2_PIX_FMT_YUV420, surf->format);
+                break;
+        }
+    }
+    Py_END_ALLOW_THREADS;
+
+    PySurface_Unlock (surfobj);
+#if HAVE_NEW_BUFPROTO
+    if (have_view)
+        PyBuffer_Release (&view);
+#endif
+    Py_INCREF (surfobj);
+    return surfobj;
+}
+
 /* colorspace() - Surface colorspace conversion */
-PyObject* surf_colorspace (PyObject* self, PyObject* arg) {
+PyObject* surf_colorspace (PyObject* self, PyObject* arg, PyObject *kwds) {
     PyObject *surfobj, *surfobj2;
     SDL_Surface* surf, *newsurf;
     char* color;
+    char* source = "RGB";
     int cspace;
+    static char *kwids[] = {"surface", "format", "dest", "source", NULL};
     surfobj2 = NULL;
 
     /*get all the arguments*/
-    if (!PyArg_ParseTuple (arg, "O!s|O!", &PySurface_Type, &surfobj,
-                           &color, &PySurface_Type, &surfobj2))
+    if (!PyArg_ParseTupleAndKeywords (arg, kwds, "Os|Os", kwids, &surfobj,
+                                      &color, &surfobj2, &source))
         return NULL;
 
+    if (surfobj2 == Py_None)
+        surfobj2 = NULL;
+    if (surfobj2 && !PySurface_Check (surfobj2))
+        return RAISE (PyExc_TypeError, "destination must be a Surface");
+
     if (!strcmp(color, "YUV")) {
         cspace = YUV_OUT;
     } else if (!strcmp(color, "HSV")) {
         cspace = HSV_OUT;
+    } else if (!strcmp(color, "RGB") && strcmp(source, "RGB")) {
+        cspace = RGB_OUT;
     } else {
         return RAISE (PyExc_ValueError, "Incorrect colorspace value");
     }
 
+    if (strcmp (source, "RGB"))
+        return raw_colorspace (surfobj, source, cspace, surfobj2);
+    if (!PySurface_Check (surfobj))
+        return RAISE (PyExc_TypeError, "source must be a Surface");
+
     surf = PySurface_AsSurface (surfobj);
 
     if (!surfobj2) {
@@ -404,6 +551,241 @@ void colorspace (SDL_Surface *src, SDL_Surface *dst, int cspace) {
     }
 }
 
+#if defined(CAMERA_SSE2_SUPPORT)
+/*
+ * SSE2 kernels for 32 bit destinations with 8 bit channels, the depth
+ * cameras and colorspace() almost always use. Each one converts as many
+ * whole blocks of 8 pixels as it can, returns how many pixels it wrote,
+ * and leaves the tail to the scalar loop of its caller. They use the same
+ * integer formulas as the scalar code, so the results are bit exact.
+ */
+
+/* non-zero if the SSE2 kernels can handle this destination format */
+static int
+camera_use_sse2 (SDL_PixelFormat* format)
+{
+    static int has_sse2 = -1;
+
+    if (has_sse2 < 0)
+        has_sse2 = SDL_HasSSE2 () ? 1 : 0;
+    return has_sse2 && format->BytesPerPixel == 4 &&
+        !format->Rloss && !format->Gloss && !format->Bloss;
+}
+
+/* packs 8 channel triplets held in 16 bit lanes into 8 Uint32 pixels */
+static CAMERA_SSE2_TARGET void
+pack_pixels_sse2 (__m128i c1, __m128i c2, __m128i c3, __m128i shift1,
+                  __m128i shift2, __m128i shift3, __m128i extra, Uint32* d)
+{
+    const __m128i zero = _mm_setzero_si128 ();
+    __m128i lo, hi;
+
+    lo = _mm_or_si128 (_mm_sll_epi32 (_mm_unpacklo_epi16 (c1, zero), shift1),
+                       _mm_sll_epi32 (_mm_unpacklo_epi16 (c2, zero), shift2));
+    lo = _mm_or_si128 (lo, _mm_sll_epi32 (_mm_unpacklo_epi16 (c3, zero),
+                                          shift3));
+    hi = _mm_or_si128 (_mm_sll_epi32 (_mm_unpackhi_epi16 (c1, zero), shift1),
+                       _mm_sll_epi32 (_mm_unpackhi_epi16 (c2, zero), shift2));
+    hi = _mm_or_si128 (hi, _mm_sll_epi32 (_mm_unpackhi_epi16 (c3, zero),
+                                          shift3));
+    _mm_storeu_si128 ((__m128i*) d, _mm_or_si128 (lo, extra));
+    _mm_storeu_si128 ((__m128i*) (d + 4), _mm_or_si128 (hi, extra));
+}
+
+/* 8 pixels of y, u and v in 16 bit lanes to rgb, with the libv4l formulas.
+   u and v are already repeated for both pixels sharing them. */
+static CAMERA_SSE2_TARGET void
+yuv_pixels_sse2 (__m128i y, __m128i u, __m128i v, SDL_PixelFormat* format,
+                 Uint32* d)
+{
+    const __m128i zero = _mm_setzero_si128 ();
+    const __m128i c128 = _mm_set1_epi16 (128);
+    __m128i u1, rg, v1, r, g, b;
+
+    u = _mm_sub_epi16 (u, c128);
+    v = _mm_sub_epi16 (v, c128);
+    u1 = _mm_srai_epi16 (_mm_add_epi16 (_mm_slli_epi16 (u, 7), u), 6);
+    rg = _mm_add_epi16 (_mm_add_epi16 (_mm_slli_epi16 (u, 1), u),
+                        _mm_add_epi16 (_mm_slli_epi16 (v, 2),
+                                       _mm_slli_epi16 (v, 1)));
+    rg = _mm_srai_epi16 (rg, 3);
+    v1 = _mm_srai_epi16 (_mm_add_epi16 (_mm_slli_epi16 (v, 1), v), 1);
+
+    /* the unsigned pack saturates the same way SAT2 does */
+    r = _mm_unpacklo_epi8 (_mm_packus_epi16 (_mm_add_epi16 (y, v1), zero),
+                           zero);
+    g = _mm_unpacklo_epi8 (_mm_packus_epi16 (_mm_sub_epi16 (y, rg), zero),
+                           zero);
+    b = _mm_unpacklo_epi8 (_mm_packus_epi16 (_mm_add_epi16 (y, u1), zero),
+                           zero);
+    pack_pixels_sse2 (r, g, b, _mm_cvtsi32_si128 (format->Rshift),
+                      _mm_cvtsi32_si128 (format->Gshift),
+                      _mm_cvtsi32_si128 (format->Bshift),
+                      _mm_set1_epi32 ((int) format->Amask), d);
+}
+
+static CAMERA_SSE2_TARGET int
+yuyv_to_rgb_sse2 (const Uint8* s, Uint32* d, int length,
+                  SDL_PixelFormat* format)
+{
+    const __m128i low8 = _mm_set1_epi16 (0xFF);
+    const __m128i low16 = _mm_set1_epi32 (0xFFFF);
+    __m128i px, uv, u, v;
+    int n;
+
+    for (n = 0; n + 8 <= length; n += 8) {
+        /* y0 u0 y1 v0 ... as 16 bit lanes: y in the low bytes, u and v
+           alternating in the high bytes */
+        px = _mm_loadu_si128 ((const __m128i*) (s + 2 * n));
+        uv = _mm_srli_epi16 (px, 8);
+        u = _mm_and_si128 (uv, low16);
+        v = _mm_srli_epi32 (uv, 16);
+        u = _mm_or_si128 (u, _mm_slli_epi32 (u, 16));
+        v = _mm_or_si128 (v, _mm_slli_epi32 (v, 16));
+        yuv_pixels_sse2 (_mm_and_si128 (px, low8), u, v, format, d + n);
+    }
+    return n;
+}
+
+/* converts the first pixels of a pair of rows, width is the whole row */
+static CAMERA_SSE2_TARGET int
+yuv420_to_rgb_sse2 (const Uint8* y1, const Uint8* y2, const Uint8* u,
+                    const Uint8* v, Uint32* d1, Uint32* d2, int width,
+                    SDL_PixelFormat* format)
+{
+    const __m128i zero = _mm_setzero_si128 ();
+    __m128i uu, vv;
+    Uint32 u4, v4;
+    int n;
+
+    for (n = 0; n + 8 <= width; n += 8) {
+        memcpy (&u4, u + n / 2, 4);
+        memcpy (&v4, v + n / 2, 4);
+        uu = _mm_unpacklo_epi8 (_mm_cvtsi32_si128 ((int) u4), zero);
+        vv = _mm_unpacklo_epi8 (_mm_cvtsi32_si128 ((int) v4), zero);
+        uu = _mm_unpacklo_epi16 (uu, uu);
+        vv = _mm_unpacklo_epi16 (vv, vv);
+        yuv_pixels_sse2 (_mm_unpacklo_epi8 (
+            _mm_loadl_epi64 ((const __m128i*) (y1 + n)), zero),
+            uu, vv, format, d1 + n);
+        yuv_pixels_sse2 (_mm_unpacklo_epi8 (
+            _mm_loadl_epi64 ((const __m128i*) (y2 + n)), zero),
+            uu, vv, format, d2 + n);
+    }
+    return n;
+}
+
+/* unpacks one 8 bit channel of 8 Uint32 pixels into 16 bit lanes */
+static CAMERA_SSE2_TARGET __m128i
+channel_sse2 (__m128i lo, __m128i hi, int shift)
+{
+    const __m128i mask = _mm_set1_epi32 (0xFF);
+    const __m128i count = _mm_cvtsi32_si128 (shift);
+
+    return _mm_packs_epi32 (_mm_and_si128 (_mm_srl_epi32 (lo, count), mask),
+                            _mm_and_si128 (_mm_srl_epi32 (hi, count), mask));
+}
+
+/* the stage 2 rgb_to_yuv path, may run in place */
+static CAMERA_SSE2_TARGET int
+rgb_to_yuv_sse2 (const Uint32* s, Uint32* d, int length,
+                 SDL_PixelFormat* format)
+{
+    const __m128i c128 = _mm_set1_epi16 (128);
+    __m128i lo, hi, r, g, b, y, u, v;
+    int n;
+
+    for (n = 0; n + 8 <= length; n += 8) {
+        lo = _mm_loadu_si128 ((const __m128i*) (s + n));
+        hi = _mm_loadu_si128 ((const __m128i*) (s + n + 4));
+        r = channel_sse2 (lo, hi, format->Rshift);
+        g = channel_sse2 (lo, hi, format->Gshift);
+        b = channel_sse2 (lo, hi, format->Bshift);
+
+        /* The 16 bit sums wrap, but each result fits once shifted: y is
+           below 65536 and unsigned, u and v are within a signed short. */
+        y = _mm_add_epi16 (_mm_mullo_epi16 (r, _mm_set1_epi16 (77)),
+                           _mm_mullo_epi16 (g, _mm_set1_epi16 (150)));
+        y = _mm_add_epi16 (y, _mm_mullo_epi16 (b, _mm_set1_epi16 (29)));
+        y = _mm_srli_epi16 (_mm_add_epi16 (y, c128), 8);
+        u = _mm_add_epi16 (_mm_mullo_epi16 (r, _mm_set1_epi16 (-38)),
+                           _mm_mullo_epi16 (g, _mm_set1_epi16 (-74)));
+        u = _mm_add_epi16 (u, _mm_mullo_epi16 (b, _mm_set1_epi16 (112)));
+        u = _mm_add_epi16 (_mm_srai_epi16 (_mm_add_epi16 (u, c128), 8), c128);
+        v = _mm_sub_epi16 (_mm_mullo_epi16 (r, _mm_set1_epi16 (112)),
+                           _mm_mullo_epi16 (g, _mm_set1_epi16 (94)));
+        v = _mm_sub_epi16 (v, _mm_mullo_epi16 (b, _mm_set1_epi16 (18)));
+        v = _mm_add_epi16 (_mm_srai_epi16 (_mm_add_epi16 (v, c128), 8), c128);
+
+        pack_pixels_sse2 (y, u, v, _mm_cvtsi32_si128 (format->Rshift),
+                          _mm_cvtsi32_si128 (format->Gshift),
+                          _mm_cvtsi32_si128 (format->Bshift),
+                          _mm_setzero_si128 (), d + n);
+    }
+    return n;
+}
+
+/* the stage 2 rgb_to_hsv path, may run in place. The divisions are done in
+   single precision: every quotient is small enough that truncating it gives
+   the same result as the integer division. */
+static CAMERA_SSE2_TARGET int
+rgb_to_hsv_sse2 (const Uint32* s, Uint32* d, int length,
+                 SDL_PixelFormat* format)
+{
+    const __m128i zero = _mm_setzero_si128 ();
+    const __m128i mask = _mm_set1_epi32 (0xFF);
+    const __m128i rcount = _mm_cvtsi32_si128 (format->Rshift);
+    const __m128i gcount = _mm_cvtsi32_si128 (format->Gshift);
+    const __m128i bcount = _mm_cvtsi32_si128 (format->Bshift);
+    const __m128 c43 = _mm_set1_ps (43.0f);
+    __m128i px, r, g, b, max, delta, isr, isg, h, hr, hg, hb, sat, grey;
+    __m128 fdelta;
+    int n;
+
+    for (n = 0; n + 4 <= length; n += 4) {
+        px = _mm_loadu_si128 ((const __m128i*) (s + n));
+        r = _mm_and_si128 (_mm_srl_epi32 (px, rcount), mask);
+        g = _mm_and_si128 (_mm_srl_epi32 (px, gcount), mask);
+        b = _mm_and_si128 (_mm_srl_epi32 (px, bcount), mask);
+
+        /* the high halves of the 32 bit lanes are zero, so the 16 bit
+           min and max work on them */
+        max = _mm_max_epi16 (_mm_max_epi16 (r, g), b);
+        delta = _mm_sub_epi32 (max, _mm_min_epi16 (_mm_min_epi16 (r, g), b));
+        fdelta = _mm_cvtepi32_ps (delta);
+
+        sat = _mm_cvttps_epi32 (_mm_div_ps (
+            _mm_mul_ps (fdelta, _mm_set1_ps (255.0f)),
+            _mm_cvtepi32_ps (max)));
+        hr = _mm_cvttps_epi32 (_mm_div_ps (
+            _mm_mul_ps (_mm_cvtepi32_ps (_mm_sub_epi32 (g, b)), c43), fdelta));
+        hg = _mm_cvttps_epi32 (_mm_div_ps (
+            _mm_mul_ps (_mm_cvtepi32_ps (_mm_sub_epi32 (b, r)), c43), fdelta));
+        hb = _mm_cvttps_epi32 (_mm_div_ps (
+            _mm_mul_ps (_mm_cvtepi32_ps (_mm_sub_epi32 (r, g)), c43), fdelta));
+        hg = _mm_add_epi32 (hg, _mm_set1_epi32 (85));
+        hb = _mm_add_epi32 (hb, _mm_set1_epi32 (170));
+
+        isr = _mm_cmpeq_epi32 (r, max);
+        isg = _mm_andnot_si128 (isr, _mm_cmpeq_epi32 (g, max));
+        h = _mm_or_si128 (_mm_and_si128 (isr, hr), _mm_and_si128 (isg, hg));
+        h = _mm_or_si128 (h, _mm_andnot_si128 (_mm_or_si128 (isr, isg), hb));
+
+        /* grey pixels divided by zero above, they get zero hue and
+           saturation */
+        grey = _mm_cmpeq_epi32 (delta, zero);
+        h = _mm_andnot_si128 (grey, _mm_and_si128 (h, mask));
+        sat = _mm_andnot_si128 (grey, _mm_and_si128 (sat, mask));
+
+        px = _mm_or_si128 (_mm_sll_epi32 (h, rcount),
+                           _mm_sll_epi32 (sat, gcount));
+        px = _mm_or_si128 (px, _mm_sll_epi32 (max, bcount));
+        _mm_storeu_si128 ((__m128i*) (d + n), px);
+    }
+    return n;
+}
+#endif /* CAMERA_SSE2_SUPPORT */
+
 /* converts pretty directly if its already RGB24 */
 void rgb24_to_rgb (const void* src, void* dst, int length, SDL_PixelFormat* format)
 {
@@ -470,6 +852,9 @@ void rgb_to_hsv (const void* src, void* dst, int length,
     Uint32 *s32, *d32;
     Uint8 r, g, b, p1, p2, h, s, v, max, min, delta;
     int rshift, gshift, bshift, rloss, gloss, bloss;
+#if defined(CAMERA_SSE2_SUPPORT)
+    int n;
+#endif
 
     s8 = (Uint8 *) src;
     s16 = (Uint16 *) src;
@@ -567,6 +952,14 @@ void rgb_to_hsv (const void* src, void* dst, int length,
             }
         }
     } else { /* for use as stage 2 in yuv or bayer to hsv, r and b switched */
+#if defined(CAMERA_SSE2_SUPPORT)
+        if (camera_use_sse2 (format)) {
+            n = rgb_to_hsv_sse2 (s32, d32, length, format);
+            s32 += n;
+            d32 += n;
+            length -= n;
+        }
+#endif
         while (length--) {
             switch (format->BytesPerPixel) {
                 case 1:
@@ -638,6 +1031,9 @@ void rgb_to_yuv (const void* src, void* dst, int length,
     Uint8 r, g, b, y, u, v;
     Uint8 p1, p2;
     int rshift, gshift, bshift, rloss, gloss, bloss;
+#if defined(CAMERA_SSE2_SUPPORT)
+    int n;
+#endif
 
     s8 = (Uint8 *) src;
     s16 = (Uint16 *) src;
@@ -733,6 +1129,14 @@ void rgb_to_yuv (const void* src, void* dst, int length,
                 }
                 break;
             default:
+#if defined(CAMERA_SSE2_SUPPORT)
+                if (camera_use_sse2 (format)) {
+                    n = rgb_to_yuv_sse2 (s32, d32, length, format);
+                    s32 += n;
+                    d32 += n;
+                    length -= n;
+                }
+#endif
                 while (length--) {
                     r = *s32 >> rshift << rloss;
                     g = *s32 >> gshift << gloss;
@@ -811,6 +1215,10 @@ void yuyv_to_rgb (const void* src, void* dst, int length, SDL_PixelFormat* forma
     int i;
     int r1, g1, b1, r2, b2, g2;
     int rshift, gshift, bshift, rloss, gloss, bloss, y1, y2, u, v, u1, rg, v1;
+    Uint32 amask;
+#if defined(CAMERA_SSE2_SUPPORT)
+    int n;
+#endif
 
     rshift = format->Rshift;
     gshift = format->Gshift;
@@ -818,6 +1226,7 @@ void yuyv_to_rgb (const void* src, void* dst, int length, SDL_PixelFormat* forma
     rloss = format->Rloss;
     gloss = format->Gloss;
     bloss = format->Bloss;
+    amask = format->Amask;
 
     d8 = (Uint8 *) dst;
     d16 = (Uint16 *) dst;
@@ -825,6 +1234,15 @@ void yuyv_to_rgb (const void* src, void* dst, int length, SDL_PixelFormat* forma
     i = length >> 1;
     s = (Uint8 *) src;
 
+#if defined(CAMERA_SSE2_SUPPORT)
+    if (camera_use_sse2 (format)) {
+        n = yuyv_to_rgb_sse2 (s, d32, length, format);
+        s += n * 2;
+        d32 += n;
+        i -= n >> 1;
+    }
+#endif
+
     /* yuyv packs 2 pixels into every 4 bytes, sharing the u and v color
        terms between the 2, with each pixel having a unique y luminance term.
        Thus, we will operate on 2 pixels at a time. */
@@ -866,8 +1284,8 @@ void yuyv_to_rgb (const void* src, void* dst, int length, SDL_PixelFormat* forma
                *d8++ = r2;
                break;
             default:
-               *d32++ = ((r1 >> rloss) << rshift) | ((g1 >> gloss) << gshift) | ((b1 >> bloss) << bshift);
-               *d32++ = ((r2 >> rloss) << rshift) | ((g2 >> gloss) << gshift) | ((b2 >> bloss) << bshift);
+               *d32++ = ((r1 >> rloss) << rshift) | ((g1 >> gloss) << gshift) | ((b1 >> bloss) << bshift) | amask;
+               *d32++ = ((r2 >> rloss) << rshift) | ((g2 >> gloss) << gshift) | ((b2 >> bloss) << bshift) | amask;
                break;
         }
     }
@@ -1075,6 +1493,10 @@ void yuv420_to_rgb (const void* src, void* dst, int width, int height, SDL_Pixel
     Uint8 *d8_1, *d8_2;
     Uint16 *d16_1, *d16_2;
     Uint32 *d32_1, *d32_2;
+    Uint32 amask;
+#if defined(CAMERA_SSE2_SUPPORT)
+    int n, sse2 = camera_use_sse2 (format);
+#endif
 
     rshift = format->Rshift;
     gshift = format->Gshift;
@@ -1082,6 +1504,7 @@ void yuv420_to_rgb (const void* src, void* dst, int width, int height, SDL_Pixel
     rloss = format->Rloss;
     gloss = format->Gloss;
     bloss = format->Bloss;
+    amask = format->Amask;
 
     /* see http://en.wikipedia.org/wiki/YUV for an explanation of YUV420 */
     y1 = (Uint8*) src;
@@ -1220,6 +1643,19 @@ void yuv420_to_rgb (const void* src, void* dst, int width, int height, SDL_Pixel
         default:
             while(j--) {
                 i = width/2;
+#if defined(CAMERA_SSE2_SUPPORT)
+                if (sse2) {
+                    n = yuv420_to_rgb_sse2 (y1, y2, u, v, d32_1, d32_2,
+                                            width, format);
+                    y1 += n;
+                    y2 += n;
+                    u += n / 2;
+                    v += n / 2;
+                    d32_1 += n;
+                    d32_2 += n;
+                    i -= n / 2;
+                }
+#endif
                 while(i--) {
                     /* These formulas are from libv4l */
                     u1 = (((*u - 128) << 7) +  (*u - 128)) >> 6;
@@ -1232,20 +1668,20 @@ void yuv420_to_rgb (const void* src, void* dst, int width, int height, SDL_Pixel
                     y = *y1++;
                     *d32_1++ = ((SAT2(y + v1) >> rloss) << rshift) |
                       ((SAT2(y - rg) >> gloss) << gshift) |
-                      ((SAT2(y + u1) >> bloss) << bshift);
+                      ((SAT2(y + u1) >> bloss) << bshift) | amask;
                     y = *y1++;
                     *d32_1++ = ((SAT2(y + v1) >> rloss) << rshift) |
                       ((SAT2(y - rg) >> gloss) << gshift) |
-                      ((SAT2(y + u1) >> bloss) << bshift);
+                      ((SAT2(y + u1) >> bloss) << bshift) | amask;
                     /* do the pixels on row 2 */
                     y = *y2++;
                     *d32_2++ = ((SAT2(y + v1) >> rloss) << rshift) |
                       ((SAT2(y - rg) >> gloss) << gshift) |
-                      ((SAT2(y + u1) >> bloss) << bshift);
+                      ((SAT2(y + u1) >> bloss) << bshift) | amask;
                     y = *y2++;
                     *d32_2++ = ((SAT2(y + v1) >> rloss) << rshift) |
                       ((SAT2(y - rg) >> gloss) << gshift) |
-                      ((SAT2(y + u1) >> bloss) << bshift);
+                      ((SAT2(y + u1) >> bloss) << bshift) | amask;
                 }
                 /* y2 is at the beginning of a new row, make it the new row 1 */
                 y1 = y2;
@@ -1514,7 +1950,8 @@ PyObject* Camera (PyCameraObject* self, PyObject* arg) {
 
 /* Camera module definition */
 PyMethodDef camera_builtins[] = {
-    {"colorspace", surf_colorspace, METH_VARARGS, DOC_PYGAMECAMERACOLORSPACE },
+    {"colorspace", (PyCFunction) surf_colorspace, METH_VARARGS | METH_KEYWORDS,
+     DOC_PYGAMECAMERACOLORSPACE },
     {"list_cameras", list_cameras, METH_NOARGS, DOC_PYGAMECAMERALISTCAMERAS },
     {"Camera", (PyCFunction) Camera, METH_VARARGS, DOC_PYGAMECAMERACAMERA },
     {NULL, NULL, 0, NULL }
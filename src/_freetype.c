@@ -46,6 +46,9 @@ static PyObject *_ft_was_init(PyObject *);
 static PyObject *_ft_autoinit(PyObject *);
 static void _ft_autoquit(void);
 static PyObject *_ft_get_cache_size(PyObject *);
+static PyObject *_ft_get_cache_budget(PyObject *);
+static PyObject *_ft_set_cache_budget(PyObject *, PyObject *);
+static PyObject *_ft_get_cache_stats(PyObject *);
 static PyObject *_ft_get_default_resolution(PyObject *);
 static PyObject *_ft_set_default_resolution(PyObject *, PyObject *);
 static PyObject *_ft_get_default_font(PyObject* self);
@@ -63,6 +66,7 @@ static int _ftfont_init(PgFontObject *, PyObject *, PyObject *);
  */
 static PyObject *_ftfont_getrect(PgFontObject *, PyObject *, PyObject *);
 static PyObject *_ftfont_getmetrics(PgFontObject *, PyObject *, PyObject *);
+static PyObject *_ftfont_preload(PgFontObject *, PyObject *, PyObject *);
 static PyObject *_ftfont_render(PgFontObject *, PyObject *, PyObject *);
 static PyObject *_ftfont_render_to(PgFontObject *, PyObject *, PyObject *);
 static PyObject *_ftfont_render_raw(PgFontObject *, PyObject *, PyObject *);
@@ -106,6 +110,9 @@ static int _ftfont_setstyle_flag(PgFontObject *, PyObject *, void *);
 static PyObject *_ftfont_getrender_flag(PgFontObject *, void *);
 static int _ftfont_setrender_flag(PgFontObject *, PyObject *, void *);
 
+static PyObject *_ftfont_getrendercache(PgFontObject *, void *);
+static int _ftfont_setrendercache(PgFontObject *, PyObject *, void *);
+
 #if defined(PGFT_DEBUG_CACHE)
 static PyObject *_ftfont_getdebugcachestats(PgFontObject *, void *);
 #endif
@@ -123,6 +130,13 @@ static int build_scale(PyObject *, PyObject *, Scale_t *);
 static FT_UInt number_to_FX6_unsigned(PyObject *);
 static int obj_to_rotation(PyObject *, void *);
 static void free_string(PGFT_String *);
+#ifdef HAVE_PYGAME_SDL_VIDEO
+static PyObject *get_render_key(PyObject *, const FontRenderMode *,
+                                const FontColor *, const FontColor *);
+#endif
+
+/* Entries held by the render cache of a font before it is emptied */
+#define PGFT_RENDER_CACHE_SIZE 64
 
 /*
  * Auxiliar defines
@@ -420,6 +434,47 @@ free_string(PGFT_String *p) {
     if (p) _PGFT_FreeString(p);
 }
 
+#ifdef HAVE_PYGAME_SDL_VIDEO
+/** Return a (text, bytes) dictionary key for a Font.render call */
+static PyObject *
+get_render_key(PyObject *textobj, const FontRenderMode *mode,
+               const FontColor *fg_color, const FontColor *bg_color)
+{
+    struct {
+        FontRenderMode mode;
+        FontColor fg_color;
+        FontColor bg_color;
+        int has_bg_color;
+    } fields;
+    PyObject *params;
+    PyObject *key;
+
+    /* Set field by field, so that padding bytes stay zeroed */
+    memset(&fields, 0, sizeof(fields));
+    fields.mode.face_size.x = mode->face_size.x;
+    fields.mode.face_size.y = mode->face_size.y;
+    fields.mode.rotation_angle = mode->rotation_angle;
+    fields.mode.render_flags = mode->render_flags;
+    fields.mode.style = mode->style;
+    fields.mode.strength = mode->strength;
+    fields.mode.underline_adjustment = mode->underline_adjustment;
+    fields.mode.transform = mode->transform;
+    fields.fg_color = *fg_color;
+    if (bg_color) {
+        fields.bg_color = *bg_color;
+        fields.has_bg_color = 1;
+    }
+
+    params = Bytes_FromStringAndSize((char *)&fields, sizeof(fields));
+    if (!params) {
+        return 0;
+    }
+    key = PyTuple_Pack(2, textobj, params);
+    Py_DECREF(params);
+    return key;
+}
+#endif
+
 /*
  * FREETYPE MODULE METHODS TABLE
  */
@@ -466,6 +521,24 @@ static PyMethodDef _ft_methods[] = {
         METH_NOARGS,
         DOC_PYGAMEFREETYPEGETCACHESIZE
     },
+    {
+        "get_cache_budget",
+        (PyCFunction) _ft_get_cache_budget,
+        METH_NOARGS,
+        DOC_PYGAMEFREETYPEGETCACHEBUDGET
+    },
+    {
+        "set_cache_budget",
+        (PyCFunction) _ft_set_cache_budget,
+        METH_VARARGS,
+        DOC_PYGAMEFREETYPESETCACHEBUDGET
+    },
+    {
+        "get_cache_stats",
+        (PyCFunction) _ft_get_cache_stats,
+        METH_NOARGS,
+        DOC_PYGAMEFREETYPEGETCACHESTATS
+    },
     {
         "get_default_resolution",
         (PyCFunction) _ft_get_default_resolution,
@@ -529,6 +602,12 @@ static PyMethodDef _ftfont_methods[] = {
         METH_VARARGS | METH_KEYWORDS,
         DOC_FONTGETMETRICS
     },
+    {
+        "preload",
+        (PyCFunction) _ftfont_preload,
+        METH_VARARGS | METH_KEYWORDS,
+        DOC_FONTPRELOAD
+    },
     {
         "get_sizes",
         (PyCFunction) _ftfont_getsizes,
@@ -749,6 +828,13 @@ static PyGetSetDef _ftfont_getsets[] = {
         DOC_FONTORIGIN,
         (void *)FT_RFLAG_ORIGIN
     },
+    {
+        "render_cache",
+        (getter)_ftfont_getrendercache,
+        (setter)_ftfont_setrendercache,
+        DOC_FONTRENDERCACHE,
+        0
+    },
 #if defined(PGFT_DEBUG_CACHE)
     {
         "_debug_cache_stats",
@@ -852,6 +938,13 @@ _ftfont_new(PyTypeObject *subtype, PyObject *args, PyObject *kwds)
         obj->fgcolor[1] = 0;
         obj->fgcolor[2] = 0;
         obj->fgcolor[3] = 255;
+        obj->render_cache = 0;
+        obj->lock = SDL_CreateMutex();
+        if (!obj->lock) {
+            PyErr_SetString(PyExc_SDLError, SDL_GetError());
+            Py_DECREF(obj);
+            return 0;
+        }
     }
     return (PyObject *)obj;
 }
@@ -863,6 +956,10 @@ _ftfont_dealloc(PgFontObject *self)
     _PGFT_Quit(self->freetype);
 
     Py_XDECREF(self->path);
+    Py_XDECREF(self->render_cache);
+    if (self->lock) {
+        SDL_DestroyMutex(self->lock);
+    }
     ((PyObject *)self)->ob_type->tp_free((PyObject *)self);
 }
 
@@ -899,13 +996,25 @@ _ftfont_init(PgFontObject *self, PyObject *args, PyObject *kwds)
 
     if (self->freetype) {
         /* Font.__init__ was previously called on this object. Reset */
-        _PGFT_UnloadFont(self->freetype, self);
+        if (PgFont_IS_ALIVE(self)) {
+            if (_PGFT_LockFont(self)) {
+                return -1;
+            }
+            _PGFT_UnloadFont(self->freetype, self);
+            _PGFT_UnlockFont(self);
+        }
+        else {
+            _PGFT_UnloadFont(self->freetype, self);
+        }
         _PGFT_Quit(self->freetype);
         self->freetype = 0;
     }
     Py_XDECREF(self->path);
     self->path = 0;
     self->is_scalable = 0;
+    if (self->render_cache) {
+        PyDict_Clear(self->render_cache);
+    }
 
     self->face_size = face_size;
     if (ucs4) {
@@ -1330,6 +1439,37 @@ _ftfont_setrender_flag(PgFontObject *self, PyObject *value, void *closure)
 }
 
 
+/** render result cache attribute */
+static PyObject *
+_ftfont_getrendercache(PgFontObject *self, void *closure)
+{
+    return PyBool_FromLong(self->render_cache != 0);
+}
+
+static int
+_ftfont_setrendercache(PgFontObject *self, PyObject *value, void *closure)
+{
+    if (!PyBool_Check(value)) {
+        PyErr_SetString(PyExc_TypeError,
+                "The render_cache value must be a boolean");
+        return -1;
+    }
+
+    if (!PyObject_IsTrue(value)) {
+        Py_XDECREF(self->render_cache);
+        self->render_cache = 0;
+    }
+    else if (!self->render_cache) {
+        self->render_cache = PyDict_New();
+        if (!self->render_cache) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
 /** resolution pixel size attribute */
 static PyObject *
 _ftfont_getresolution(PgFontObject *self, void *closure)
@@ -1425,6 +1565,7 @@ _ftfont_getrect(PgFontObject *self, PyObject *args, PyObject *kwds)
     FontRenderMode render;
     Angle_t rotation = self->rotation;
     int style = FT_STYLE_DEFAULT;
+    int rcode;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|iO&O&", kwlist,
                                      &textobj, &style,
@@ -1445,7 +1586,10 @@ _ftfont_getrect(PgFontObject *self, PyObject *args, PyObject *kwds)
     if (_PGFT_BuildRenderMode(self->freetype, self, &render,
                               face_size, style, rotation)) goto error;
 
-    if (_PGFT_GetTextRect(self->freetype, self, &render, text, &r)) goto error;
+    if (_PGFT_LockFont(self)) goto error;
+    rcode = _PGFT_GetTextRect(self->freetype, self, &render, text, &r);
+    _PGFT_UnlockFont(self);
+    if (rcode) goto error;
     free_string(text);
 
     return PyRect_New(&r);
@@ -1468,11 +1612,18 @@ get_metrics(FontRenderMode *render, PgFontObject *font, PGFT_String *text)
     double advance_y;
     Py_ssize_t i;
     Layout *ftext = &font->_internals->active_text;
-    FT_Face face = _PGFT_GetFontSized(font->freetype, font, render->face_size);
-    raqm_t *rq ;
+    FT_Face face;
+    raqm_t *rq = 0;
     raqm_glyph_t *glyphs;
     size_t  nglyphs;
 
+    _PGFT_LockInstance(font->freetype);
+    face = _PGFT_GetFontSized(font->freetype, font, render->face_size);
+    if (!face) {
+        PyErr_SetString(PyExc_SDLError, _PGFT_GetError(font->freetype));
+        goto cleanup;
+    }
+
     rq = raqm_create();
     if (!rq)
         goto cleanup;
@@ -1534,6 +1685,7 @@ get_metrics(FontRenderMode *render, PgFontObject *font, PGFT_String *text)
     }
     ftext->length = nglyphs;
     raqm_destroy(rq);
+    _PGFT_UnlockInstance(font->freetype);
 
     return list;
     /*
@@ -1541,6 +1693,7 @@ get_metrics(FontRenderMode *render, PgFontObject *font, PGFT_String *text)
      */
 cleanup:
     raqm_destroy(rq);
+    _PGFT_UnlockInstance(font->freetype);
     return 0;
 }
 
@@ -1580,7 +1733,9 @@ _ftfont_getmetrics(PgFontObject *self, PyObject *args, PyObject *kwds)
                               face_size, FT_STYLE_NORMAL, 0)) goto error;
 
     /* get metrics */
+    if (_PGFT_LockFont(self)) goto error;
     list = get_metrics(&render, self, text);
+    _PGFT_UnlockFont(self);
     if (!list) goto error;
     free_string(text);
 
@@ -1592,6 +1747,111 @@ _ftfont_getmetrics(PgFontObject *self, PyObject *args, PyObject *kwds)
     return 0;
 }
 
+/* Glyphs preloaded per hold of the font lock. Taking the lock gives up
+ * the GIL, so a long preload on a background thread keeps yielding to
+ * the others.
+ */
+#define PGFT_PRELOAD_CHUNK 32
+
+/* Returns a fast sequence of the options in o: None, a single value, or
+ * a sequence of values. A tuple is a single size, not a sequence of them.
+ */
+static PyObject *
+get_preload_options(PyObject *o, int tuple_is_value)
+{
+    if (!o || o == Py_None || PyNumber_Check(o) ||
+        (tuple_is_value && PyTuple_Check(o))) {
+        return PyTuple_Pack(1, o ? o : Py_None);
+    }
+    return PySequence_Fast(o, "expected a value or a sequence of values");
+}
+
+static PyObject *
+_ftfont_preload(PgFontObject *self, PyObject *args, PyObject *kwds)
+{
+    /* keyword list */
+    static char *kwlist[] =  {
+        "text", "sizes", "styles", 0
+    };
+
+    FontRenderMode mode;
+    PyObject *sizes = 0;
+    PyObject *styles = 0;
+    PyObject *item;
+    Scale_t face_size;
+    int style;
+    Py_ssize_t i, j, start, length;
+    long count = 0;
+    long loaded;
+    size_t bytes;
+
+    /* arguments */
+    PyObject *textobj;
+    PyObject *sizesobj = 0;
+    PyObject *stylesobj = 0;
+    PGFT_String *text = 0;
+
+    /* parse args */
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OO", kwlist, &textobj,
+                                     &sizesobj, &stylesobj))
+        goto error;
+
+    ASSERT_SELF_IS_ALIVE(self);
+
+    sizes = get_preload_options(sizesobj, 1);
+    if (!sizes) goto error;
+    styles = get_preload_options(stylesobj, 0);
+    if (!styles) goto error;
+
+    /* Encode text */
+    text = _PGFT_EncodePyString(textobj,
+                                self->render_flags & FT_RFLAG_UCS4);
+    if (!text) goto error;
+    length = PGFT_String_GET_LENGTH(text);
+
+    for (i = 0; i < PySequence_Fast_GET_SIZE(sizes); ++i) {
+        item = PySequence_Fast_GET_ITEM(sizes, i);
+        face_size = FACE_SIZE_NONE;
+        if (item != Py_None && !obj_to_scale(item, &face_size)) goto error;
+        for (j = 0; j < PySequence_Fast_GET_SIZE(styles); ++j) {
+            item = PySequence_Fast_GET_ITEM(styles, j);
+            style = FT_STYLE_DEFAULT;
+            if (item != Py_None) {
+                style = (int)PyInt_AsLong(item);
+                if (style == -1 && PyErr_Occurred()) goto error;
+            }
+            if (_PGFT_BuildRenderMode(self->freetype, self, &mode,
+                                      face_size, style, self->rotation))
+                goto error;
+            for (start = 0; start < length; start += PGFT_PRELOAD_CHUNK) {
+                if (_PGFT_LockFont(self)) goto error;
+                loaded = _PGFT_PreloadGlyphs(
+                    self->freetype, self, &mode,
+                    PGFT_String_GET_DATA(text) + start,
+                    MIN(length - start, PGFT_PRELOAD_CHUNK));
+                _PGFT_UnlockFont(self);
+                if (loaded < 0) goto error;
+                count += loaded;
+            }
+        }
+    }
+
+    if (_PGFT_LockFont(self)) goto error;
+    bytes = self->_internals->glyph_cache.bytes;
+    _PGFT_UnlockFont(self);
+
+    free_string(text);
+    Py_DECREF(sizes);
+    Py_DECREF(styles);
+    return Py_BuildValue("(ln)", count, (Py_ssize_t)bytes);
+
+  error:
+    free_string(text);
+    Py_XDECREF(sizes);
+    Py_XDECREF(styles);
+    return 0;
+}
+
 static PyObject *
 _ftfont_getsizedascender(PgFontObject *self, PyObject *args)
 {
@@ -1783,9 +2043,11 @@ _ftfont_render_raw(PgFontObject *self, PyObject *args, PyObject *kwds)
                               &mode, face_size, style, rotation))
         goto error;
 
+    if (_PGFT_LockFont(self)) goto error;
     rbuffer = _PGFT_Render_PixelArray(self->freetype, self,
                                       &mode, text, invert,
                                       &width, &height);
+    _PGFT_UnlockFont(self);
     if (!rbuffer) goto error;
     free_string(text);
     rtuple = Py_BuildValue("O(ii)", rbuffer, width, height);
@@ -1825,6 +2087,7 @@ _ftfont_render_raw_to(PgFontObject *self, PyObject *args, PyObject *kwds)
 
     /* output arguments */
     SDL_Rect r;
+    int rcode;
 
     ASSERT_SELF_IS_ALIVE(self);
 
@@ -1855,8 +2118,11 @@ _ftfont_render_raw_to(PgFontObject *self, PyObject *args, PyObject *kwds)
                               &mode, face_size, style, rotation))
         goto error;
 
-    if (_PGFT_Render_Array(self->freetype, self, &mode,
-                           arrayobj, text, invert, xpos, ypos, &r)) goto error;
+    if (_PGFT_LockFont(self)) goto error;
+    rcode = _PGFT_Render_Array(self->freetype, self, &mode,
+                               arrayobj, text, invert, xpos, ypos, &r);
+    _PGFT_UnlockFont(self);
+    if (rcode) goto error;
     free_string(text);
 
     return PyRect_New(&r);
@@ -1896,6 +2162,8 @@ _ftfont_render(PgFontObject *self, PyObject *args, PyObject *kwds)
     PyObject *rtuple = 0;
     SDL_Rect r;
     PyObject *rect_obj = 0;
+    PyObject *cache_key = 0;
+    PyObject *cached;
 
     FontColor fg_color;
     FontColor bg_color;
@@ -1949,11 +2217,38 @@ _ftfont_render(PgFontObject *self, PyObject *args, PyObject *kwds)
                               &render, face_size, style, rotation))
         goto error;
 
+    /* Strings are immutable, so an identical call can share the surface
+     * rendered before. Only the rect is new, as it may be changed.
+     */
+    if (self->render_cache &&
+        (Py_TYPE(textobj) == &PyUnicode_Type ||
+         Py_TYPE(textobj) == &Bytes_Type)) {
+        cache_key = get_render_key(textobj, &render, &fg_color,
+                                   bg_color_obj ? &bg_color : 0);
+        if (!cache_key) goto error;
+        cached = PyDict_GetItem(self->render_cache, cache_key);
+        if (cached) {
+            GAME_Rect *cached_r = &PyRect_AsRect(PyTuple_GET_ITEM(cached, 1));
+
+            free_string(text);
+            Py_DECREF(cache_key);
+            rect_obj = PyRect_New4(cached_r->x, cached_r->y,
+                                   cached_r->w, cached_r->h);
+            if (!rect_obj) return 0;
+            rtuple = PyTuple_Pack(2, PyTuple_GET_ITEM(cached, 0), rect_obj);
+            Py_DECREF(rect_obj);
+            return rtuple;
+        }
+    }
+
+    if (_PGFT_LockFont(self)) goto error;
     surface = _PGFT_Render_NewSurface(self->freetype, self,
                                       &render, text, &fg_color,
                                       bg_color_obj ? &bg_color : 0, &r);
+    _PGFT_UnlockFont(self);
     if (!surface) goto error;
     free_string(text);
+    text = 0;
     surface_obj = PySurface_New(surface);
     if (!surface_obj) goto error;
 
@@ -1964,9 +2259,29 @@ _ftfont_render(PgFontObject *self, PyObject *args, PyObject *kwds)
     Py_DECREF(surface_obj);
     Py_DECREF(rect_obj);
 
+    if (cache_key) {
+        /* Start over rather than grow without bound */
+        if (PyDict_Size(self->render_cache) >= PGFT_RENDER_CACHE_SIZE) {
+            PyDict_Clear(self->render_cache);
+        }
+        rect_obj = PyRect_New(&r);
+        cached = rect_obj ? PyTuple_Pack(2, surface_obj, rect_obj) : 0;
+        Py_XDECREF(rect_obj);
+        if (!cached ||
+            PyDict_SetItem(self->render_cache, cache_key, cached)) {
+            Py_XDECREF(cached);
+            Py_DECREF(cache_key);
+            Py_DECREF(rtuple);
+            return 0;
+        }
+        Py_DECREF(cached);
+        Py_DECREF(cache_key);
+    }
+
     return rtuple;
 
   error:
+    Py_XDECREF(cache_key);
     free_string(text);
     if (surface_obj) {
         Py_DECREF(surface_obj);
@@ -2010,6 +2325,7 @@ _ftfont_render_to(PgFontObject *self, PyObject *args, PyObject *kwds)
     Angle_t rotation = self->rotation;
     int style = FT_STYLE_DEFAULT;
     SDL_Surface *surface = 0;
+    int rcode;
 
     /* output arguments */
     SDL_Rect r;
@@ -2069,11 +2385,13 @@ _ftfont_render_to(PgFontObject *self, PyObject *args, PyObject *kwds)
         goto error;
 
     surface = PySurface_AsSurface(surface_obj);
-    if (_PGFT_Render_ExistingSurface(self->freetype, self,
-                                     &render, text, surface,
-                                     xpos, ypos, &fg_color,
-                                     bg_color_obj ? &bg_color : 0, &r))
-        goto error;
+    if (_PGFT_LockFont(self)) goto error;
+    rcode = _PGFT_Render_ExistingSurface(self->freetype, self,
+                                         &render, text, surface,
+                                         xpos, ypos, &fg_color,
+                                         bg_color_obj ? &bg_color : 0, &r);
+    _PGFT_UnlockFont(self);
+    if (rcode) goto error;
     free_string(text);
 
     return PyRect_New(&r);
@@ -2234,6 +2552,46 @@ _ft_get_cache_size(PyObject *self)
     return PyLong_FromUnsignedLong((unsigned long)(FREETYPE_STATE->cache_size));
 }
 
+static PyObject *
+_ft_get_cache_budget(PyObject *self)
+{
+    FreeTypeInstance *ft;
+    ASSERT_GRAB_FREETYPE(ft, 0);
+
+    return PyLong_FromSize_t(ft->cache_budget);
+}
+
+static PyObject *
+_ft_set_cache_budget(PyObject *self, PyObject *args)
+{
+    Py_ssize_t budget = PGFT_DEFAULT_CACHE_BUDGET;
+    FreeTypeInstance *ft;
+    ASSERT_GRAB_FREETYPE(ft, 0);
+
+    if (!PyArg_ParseTuple(args, "|n", &budget)) {
+        return 0;
+    }
+    if (budget < 0) {
+        return RAISE(PyExc_ValueError, "cache budget must not be negative");
+    }
+
+    ft->cache_budget = (size_t)budget;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+_ft_get_cache_stats(PyObject *self)
+{
+    FreeTypeInstance *ft;
+    ASSERT_GRAB_FREETYPE(ft, 0);
+
+    return Py_BuildValue("kkkn",
+                         ft->cache_stats.hits,
+                         ft->cache_stats.misses,
+                         ft->cache_stats.evictions,
+                         (Py_ssize_t)ft->cache_stats.bytes);
+}
+
 static PyObject *
 _ft_get_default_resolution(PyObject *self)
 {
@@ -522,12 +522,20 @@ typedef struct
 /* EVENT */
 #define PYGAMEAPI_EVENT_FIRSTSLOT                                       \
     (PYGAMEAPI_SURFLOCK_FIRSTSLOT + PYGAMEAPI_SURFLOCK_NUMSLOTS)
-#define PYGAMEAPI_EVENT_NUMSLOTS 4
-
+#define PYGAMEAPI_EVENT_NUMSLOTS 5
+
+/* The attribute dict of an event taken from the SDL queue is built on
+ * first use, so dict may be NULL. Use PyEvent_GetDict rather than
+ * reading it directly. Events made by PyEvent_New and PyEvent_New2
+ * through this API always have their dict. The pending field was added
+ * with the lazy dict, so extensions built against older headers must
+ * be rebuilt.
+ */
 typedef struct {
     PyObject_HEAD
     int type;
-    PyObject* dict;
+    PyObject* dict;     /* NULL until first used; built from pending */
+    SDL_Event pending;
 } PyEventObject;
 
 #ifndef PYGAMEAPI_EVENT_INTERNAL
@@ -542,6 +550,8 @@ typedef struct {
 #define PyEvent_FillUserEvent                           \
     (*(int (*)(PyEventObject*, SDL_Event*))             \
      PyGAME_C_API[PYGAMEAPI_EVENT_FIRSTSLOT + 3])
+#define PyEvent_GetDict                                                 \
+    (*(PyObject*(*)(PyObject*))PyGAME_C_API[PYGAMEAPI_EVENT_FIRSTSLOT + 4])
 #define import_pygame_event() IMPORT_PYGAME_MODULE(event, EVENT)
 #endif
 
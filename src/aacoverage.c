@@ -0,0 +1,574 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include "aacoverage.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* Rows of coverage accumulated at once; bounds the buffer size. */
+#define AA_BAND_HEIGHT 64
+
+/* Maximum distance in pixels between an ellipse and its polygon. */
+#define AA_FLATNESS 0.1
+
+typedef struct {
+    float *cells;           /* (width + 2) * height signed area deltas */
+    int *rowmin;            /* first and last touched cell of each row */
+    int *rowmax;
+    int width;
+    int height;
+} AABand;
+
+void
+aapath_init (AAPath *path)
+{
+    path->edges = NULL;
+    path->count = 0;
+    path->allocated = 0;
+    path->minx = path->miny = 1e30f;
+    path->maxx = path->maxy = -1e30f;
+}
+
+void
+aapath_free (AAPath *path)
+{
+    free (path->edges);
+    aapath_init (path);
+}
+
+static int
+aapath_add_edge (AAPath *path, float x0, float y0, float x1, float y1)
+{
+    float *edge;
+
+    if (y0 == y1)
+        return 0; /* horizontal edges cover no area */
+
+    if (path->count == path->allocated)
+    {
+        int allocated = path->allocated ? path->allocated * 2 : 64;
+        float *edges = realloc (path->edges, sizeof (float) * 4 * allocated);
+        if (!edges)
+            return -1;
+        path->edges = edges;
+        path->allocated = allocated;
+    }
+    edge = path->edges + 4 * path->count++;
+    edge[0] = x0;
+    edge[1] = y0;
+    edge[2] = x1;
+    edge[3] = y1;
+
+    if (x0 < path->minx) path->minx = x0;
+    if (x1 < path->minx) path->minx = x1;
+    if (x0 > path->maxx) path->maxx = x0;
+    if (x1 > path->maxx) path->maxx = x1;
+    if (y0 < path->miny) path->miny = y0;
+    if (y1 < path->miny) path->miny = y1;
+    if (y0 > path->maxy) path->maxy = y0;
+    if (y1 > path->maxy) path->maxy = y1;
+    return 0;
+}
+
+int
+aapath_add_polygon (AAPath *path, const float *xy, int n, int reverse)
+{
+    int i, j, k;
+
+    for (i = 0; i < n; i++)
+    {
+        j = reverse ? n - 1 - i : i;
+        k = reverse ? (j + n - 1) % n : (j + 1) % n;
+        if (aapath_add_edge (path, xy[2 * j], xy[2 * j + 1],
+                             xy[2 * k], xy[2 * k + 1]))
+            return -1;
+    }
+    return 0;
+}
+
+int
+aapath_add_line (AAPath *path, float x1, float y1, float x2, float y2,
+                 float width)
+{
+    float quad[8];
+    float dx = x2 - x1, dy = y2 - y1;
+    float len = (float) sqrt (dx * dx + dy * dy);
+    float nx, ny;
+
+    if (len == 0.0f)
+    {
+        /* A dot: a square of the line width around the point. */
+        nx = 0.0f;
+        ny = width / 2;
+        dx = width / 2;
+        dy = 0.0f;
+    }
+    else
+    {
+        /* The normal keeps every line quad in the same orientation, so
+         * overlapping segments of one path add up instead of cancelling.
+         */
+        nx = -dy * width / (2 * len);
+        ny = dx * width / (2 * len);
+        dx = 0.0f;
+        dy = 0.0f;
+    }
+    quad[0] = x1 - dx + nx; quad[1] = y1 - dy + ny;
+    quad[2] = x2 + dx + nx; quad[3] = y2 + dy + ny;
+    quad[4] = x2 + dx - nx; quad[5] = y2 + dy - ny;
+    quad[6] = x1 - dx - nx; quad[7] = y1 - dy - ny;
+    return aapath_add_polygon (path, quad, 4, 0);
+}
+
+int
+aapath_add_ellipse (AAPath *path, float cx, float cy, float rx, float ry,
+                    int reverse)
+{
+    double r = rx > ry ? rx : ry;
+    double step, angle;
+    float x0, y0, x1, y1;
+    int n, i;
+
+    if (rx <= 0.0f || ry <= 0.0f)
+        return 0;
+
+    if (r <= AA_FLATNESS * 2)
+        n = 8;
+    else
+        n = (int) ceil (M_PI / acos (1.0 - AA_FLATNESS / r));
+    if (n < 8)
+        n = 8;
+    else if (n > 2048)
+        n = 2048;
+
+    step = (reverse ? -2.0 : 2.0) * M_PI / n;
+    x0 = cx + rx;
+    y0 = cy;
+    for (i = 1; i <= n; i++)
+    {
+        angle = step * i;
+        if (i == n)
+        {
+            x1 = cx + rx;
+            y1 = cy;
+        }
+        else
+        {
+            x1 = cx + (float) (rx * cos (angle));
+            y1 = cy + (float) (ry * sin (angle));
+        }
+        if (aapath_add_edge (path, x0, y0, x1, y1))
+            return -1;
+        x0 = x1;
+        y0 = y1;
+    }
+    return 0;
+}
+
+/* Accumulates the signed area of an edge lying within the band, with
+ * 0 <= x <= width and 0 <= y <= height, into the cells it crosses.
+ */
+static void
+aaband_accumulate (AABand *band, float px0, float py0, float px1, float py1)
+{
+    float dir, dxdy, x, xnext, dy, d, x0, x1, x0f, x1f, s, a0, a1, a2, am, xmf;
+    int y, yend, x0i, x1i, xi;
+    float *row;
+
+    if (py0 == py1)
+        return;
+    if (py0 < py1)
+    {
+        dir = 1.0f;
+    }
+    else
+    {
+        dir = -1.0f;
+        x = px0; px0 = px1; px1 = x;
+        x = py0; py0 = py1; py1 = x;
+    }
+
+    dxdy = (px1 - px0) / (py1 - py0);
+    x = px0;
+    yend = (int) ceil (py1);
+    if (yend > band->height)
+        yend = band->height;
+
+    for (y = (int) py0; y < yend; y++)
+    {
+        row = band->cells + y * (band->width + 2);
+        dy = ((y + 1 < py1) ? y + 1 : py1) - ((y > py0) ? y : py0);
+        xnext = x + dxdy * dy;
+        d = dy * dir;
+        if (x < xnext)
+        {
+            x0 = x;
+            x1 = xnext;
+        }
+        else
+        {
+            x0 = xnext;
+            x1 = x;
+        }
+        x0i = (int) floor (x0);
+        x1i = (int) ceil (x1);
+        if (x1i <= x0i + 1)
+        {
+            xmf = 0.5f * (x + xnext) - x0i;
+            row[x0i] += d - d * xmf;
+            row[x0i + 1] += d * xmf;
+            x1i = x0i + 1;
+        }
+        else
+        {
+            s = 1.0f / (x1 - x0);
+            x0f = x0 - x0i;
+            a0 = 0.5f * s * (1.0f - x0f) * (1.0f - x0f);
+            x1f = x1 - x1i + 1.0f;
+            am = 0.5f * s * x1f * x1f;
+            row[x0i] += d * a0;
+            if (x1i == x0i + 2)
+            {
+                row[x0i + 1] += d * (1.0f - a0 - am);
+            }
+            else
+            {
+                a1 = s * (1.5f - x0f);
+                row[x0i + 1] += d * (a1 - a0);
+                for (xi = x0i + 2; xi < x1i - 1; xi++)
+                    row[xi] += d * s;
+                a2 = a1 + (x1i - x0i - 3) * s;
+                row[x1i - 1] += d * (1.0f - a2 - am);
+            }
+            row[x1i] += d * am;
+        }
+        if (x0i < band->rowmin[y])
+            band->rowmin[y] = x0i;
+        if (x1i > band->rowmax[y])
+            band->rowmax[y] = x1i;
+        x = xnext;
+    }
+}
+
+/* Clips an edge to the band rows, then splits it at the left and right
+ * band borders.  The parts outside are pushed onto the border, which
+ * leaves the coverage to their right unchanged.
+ */
+static void
+aaband_add_edge (AABand *band, float x0, float y0, float x1, float y1)
+{
+    float w = (float) band->width, h = (float) band->height;
+    float t[4], xa, ya, xb, yb, tmp;
+    int n = 0, i, j;
+
+    /* Clip in y */
+    if ((y0 <= 0.0f && y1 <= 0.0f) || (y0 >= h && y1 >= h))
+        return;
+    if (y0 < 0.0f || y1 < 0.0f)
+    {
+        tmp = x0 + (x1 - x0) * (0.0f - y0) / (y1 - y0);
+        if (y0 < 0.0f) { x0 = tmp; y0 = 0.0f; }
+        else { x1 = tmp; y1 = 0.0f; }
+    }
+    if (y0 > h || y1 > h)
+    {
+        tmp = x0 + (x1 - x0) * (h - y0) / (y1 - y0);
+        if (y0 > h) { x0 = tmp; y0 = h; }
+        else { x1 = tmp; y1 = h; }
+    }
+
+    /* Split where the edge crosses x = 0 and x = width */
+    t[n++] = 0.0f;
+    if ((x0 < 0.0f) != (x1 < 0.0f))
+        t[n++] = (0.0f - x0) / (x1 - x0);
+    if ((x0 > w) != (x1 > w))
+        t[n++] = (w - x0) / (x1 - x0);
+    if (n == 3 && t[2] < t[1])
+    {
+        tmp = t[1]; t[1] = t[2]; t[2] = tmp;
+    }
+    t[n++] = 1.0f;
+
+    for (i = 0; i + 1 < n; i++)
+    {
+        xa = x0 + (x1 - x0) * t[i];
+        ya = y0 + (y1 - y0) * t[i];
+        xb = x0 + (x1 - x0) * t[i + 1];
+        yb = y0 + (y1 - y0) * t[i + 1];
+        if (i + 2 == n)
+        {
+            xb = x1;
+            yb = y1;
+        }
+        for (j = 0; j < 2; j++)
+        {
+            float *xp = j ? &xb : &xa;
+            if (*xp < 0.0f)
+                *xp = 0.0f;
+            else if (*xp > w)
+                *xp = w;
+        }
+        aaband_accumulate (band, xa, ya, xb, yb);
+    }
+}
+
+static Uint32
+aa_get_pixel (Uint8 *p, int bpp)
+{
+    switch (bpp)
+    {
+    case 1:
+        return *p;
+    case 2:
+        return *(Uint16 *) p;
+    case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        return p[0] | (p[1] << 8) | (p[2] << 16);
+#else
+        return (p[0] << 16) | (p[1] << 8) | p[2];
+#endif
+    default:
+        return *(Uint32 *) p;
+    }
+}
+
+static void
+aa_set_pixel (Uint8 *p, int bpp, Uint32 pixel)
+{
+    switch (bpp)
+    {
+    case 1:
+        *p = (Uint8) pixel;
+        break;
+    case 2:
+        *(Uint16 *) p = (Uint16) pixel;
+        break;
+    case 3:
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+        p[0] = pixel & 0xff;
+        p[1] = (pixel >> 8) & 0xff;
+        p[2] = (pixel >> 16) & 0xff;
+#else
+        p[0] = (pixel >> 16) & 0xff;
+        p[1] = (pixel >> 8) & 0xff;
+        p[2] = pixel & 0xff;
+#endif
+        break;
+    default:
+        *(Uint32 *) p = pixel;
+        break;
+    }
+}
+
+/* Composites a run of n pixels sharing the coverage alpha a. */
+static void
+aa_composite_run (SDL_Surface *surf, Uint8 *p, int n, const Uint8 *rgba,
+                  Uint32 mapped, Uint8 a, int blend, int packed)
+{
+    SDL_PixelFormat *fmt = surf->format;
+    int bpp = fmt->BytesPerPixel;
+    Uint32 d, rb, ag, da;
+    Uint8 c[4];
+    int i;
+
+    if (a == 255)
+    {
+        /* Fully covered, opaque: a plain store */
+        for (; n > 0; n--, p += bpp)
+            aa_set_pixel (p, bpp, mapped);
+        return;
+    }
+
+    if (packed)
+    {
+        for (; n > 0; n--, p += 4)
+        {
+            d = blend ? *(Uint32 *) p : 0;
+            rb = (((d & 0x00ff00ff) * (256 - a) +
+                   (mapped & 0x00ff00ff) * a) >> 8) & 0x00ff00ff;
+            ag = (((d >> 8) & 0x00ff00ff) * (256 - a) +
+                  ((mapped >> 8) & 0x00ff00ff) * a) & 0xff00ff00;
+            if (fmt->Amask)
+            {
+                da = (d & fmt->Amask) >> fmt->Ashift;
+                da += ((255 - da) * a + 127) / 255;
+                *(Uint32 *) p = ((rb | ag) & ~fmt->Amask) | (da << fmt->Ashift);
+            }
+            else
+                *(Uint32 *) p = rb | ag;
+        }
+        return;
+    }
+
+    for (; n > 0; n--, p += bpp)
+    {
+        if (blend)
+            SDL_GetRGBA (aa_get_pixel (p, bpp), fmt, &c[0], &c[1], &c[2], &c[3]);
+        else
+            c[0] = c[1] = c[2] = c[3] = 0;
+        for (i = 0; i < 3; i++)
+            c[i] = (c[i] * (256 - a) + rgba[i] * a) >> 8;
+        c[3] += ((255 - c[3]) * a + 127) / 255;
+        aa_set_pixel (p, bpp, SDL_MapRGBA (fmt, c[0], c[1], c[2], c[3]));
+    }
+}
+
+int
+aapath_fill (SDL_Surface *surf, AAPath *path, const Uint8 *rgba,
+             int blend, SDL_Rect *drawn)
+{
+    SDL_PixelFormat *fmt = surf->format;
+    SDL_Rect *clip = &surf->clip_rect;
+    AABand band;
+    int left, top, right, bottom, bandtop;
+    int x, y, i, start, last;
+    int dminx = INT_MAX, dminy = INT_MAX, dmaxx = -1, dmaxy = -1;
+    int packed, locked = 0;
+    float acc, cov, *row, *edge;
+    Uint32 mapped;
+    Uint8 a = 0, runa = 0;
+
+    if (path->count == 0 || rgba[3] == 0)
+        return 0;
+
+    /* The pixels the path may touch, within the clip rect */
+    left = (int) floor (path->minx);
+    top = (int) floor (path->miny);
+    right = (int) ceil (path->maxx);
+    bottom = (int) ceil (path->maxy);
+    if (left < clip->x) left = clip->x;
+    if (top < clip->y) top = clip->y;
+    if (right > clip->x + clip->w) right = clip->x + clip->w;
+    if (bottom > clip->y + clip->h) bottom = clip->y + clip->h;
+    if (left >= right || top >= bottom)
+        return 0;
+
+    band.width = right - left;
+    band.height = bottom - top < AA_BAND_HEIGHT ? bottom - top : AA_BAND_HEIGHT;
+    band.cells = calloc ((band.width + 2) * band.height, sizeof (float));
+    band.rowmin = malloc (sizeof (int) * band.height);
+    band.rowmax = malloc (sizeof (int) * band.height);
+    if (!band.cells || !band.rowmin || !band.rowmax)
+    {
+        free (band.cells);
+        free (band.rowmin);
+        free (band.rowmax);
+        SDL_SetError ("Out of memory");
+        return -1;
+    }
+
+    mapped = SDL_MapRGBA (fmt, rgba[0], rgba[1], rgba[2], 255);
+    packed = fmt->BytesPerPixel == 4 &&
+        fmt->Rloss == 0 && fmt->Gloss == 0 && fmt->Bloss == 0 &&
+        fmt->Rshift % 8 == 0 && fmt->Gshift % 8 == 0 && fmt->Bshift % 8 == 0 &&
+        (fmt->Amask == 0 || (fmt->Aloss == 0 && fmt->Ashift % 8 == 0));
+
+    if (SDL_MUSTLOCK (surf))
+    {
+        if (SDL_LockSurface (surf) < 0)
+        {
+            free (band.cells);
+            free (band.rowmin);
+            free (band.rowmax);
+            return -1;
+        }
+        locked = 1;
+    }
+
+    for (bandtop = top; bandtop < bottom; bandtop += AA_BAND_HEIGHT)
+    {
+        if (bottom - bandtop < band.height)
+            band.height = bottom - bandtop;
+        for (y = 0; y < band.height; y++)
+        {
+            band.rowmin[y] = INT_MAX;
+            band.rowmax[y] = -1;
+        }
+
+        for (i = 0, edge = path->edges; i < path->count; i++, edge += 4)
+            aaband_add_edge (&band, edge[0] - left, edge[1] - bandtop,
+                             edge[2] - left, edge[3] - bandtop);
+
+        for (y = 0; y < band.height; y++)
+        {
+            if (band.rowmax[y] < 0)
+                continue;
+            row = band.cells + y * (band.width + 2);
+            last = band.rowmax[y] < band.width ? band.rowmax[y] : band.width - 1;
+
+            /* Sum the area deltas along the row and composite each run
+             * of pixels that ends up with the same coverage at once.
+             */
+            acc = 0.0f;
+            start = band.rowmin[y];
+            runa = 0;
+            for (x = band.rowmin[y]; x <= last + 1; x++)
+            {
+                if (x <= last)
+                {
+                    acc += row[x];
+                    cov = acc < 0.0f ? -acc : acc;
+                    if (cov > 1.0f)
+                        cov = 1.0f;
+                    a = (Uint8) (cov * rgba[3] + 0.5f);
+                    if (x > start && a == runa)
+                        continue;
+                }
+                if (x > start && runa)
+                {
+                    aa_composite_run (surf, (Uint8 *) surf->pixels +
+                                      (bandtop + y) * surf->pitch +
+                                      (left + start) * fmt->BytesPerPixel,
+                                      x - start, rgba, mapped, runa, blend,
+                                      packed);
+                    if (left + start < dminx) dminx = left + start;
+                    if (left + x - 1 > dmaxx) dmaxx = left + x - 1;
+                    if (bandtop + y < dminy) dminy = bandtop + y;
+                    if (bandtop + y > dmaxy) dmaxy = bandtop + y;
+                }
+                start = x;
+                runa = a;
+            }
+            memset (row + band.rowmin[y], 0,
+                    sizeof (float) * (band.rowmax[y] - band.rowmin[y] + 1));
+        }
+    }
+
+    if (locked)
+        SDL_UnlockSurface (surf);
+    free (band.cells);
+    free (band.rowmin);
+    free (band.rowmax);
+
+    if (dmaxx < 0)
+        return 0;
+    if (drawn)
+    {
+        drawn->x = dminx;
+        drawn->y = dminy;
+        drawn->w = dmaxx - dminx + 1;
+        drawn->h = dmaxy - dminy + 1;
+    }
+    return 1;
+}
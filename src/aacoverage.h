@@ -0,0 +1,69 @@
+/*
+  pygame - Python Game Library
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+  Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public
+  License along with this library; if not, write to the Free
+  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/* Anti-aliased outline rasterizer with analytic area coverage.
+ *
+ * Shapes are collected as closed outlines of directed edges in an
+ * AAPath, then filled in one pass: the exact area each edge covers in
+ * every pixel is accumulated into a coverage buffer, and every scanline
+ * is composited as runs of equal coverage.  Overlapping outlines of the
+ * same orientation saturate rather than blending twice, so a whole
+ * polyline or ring touches each pixel once.
+ *
+ * Coordinates are continuous: pixel (x, y) covers [x, x+1) x [y, y+1).
+ */
+#ifndef AACOVERAGE_H
+#define AACOVERAGE_H
+
+#include <SDL.h>
+
+/* Values of the quality argument of the anti-aliased draw functions. */
+#define AA_QUALITY_FAST      0   /* per pixel Wu style stepping */
+#define AA_QUALITY_COVERAGE  1   /* analytic area coverage */
+#define AA_QUALITY_IS_VALID(q) \
+    ((q) == AA_QUALITY_FAST || (q) == AA_QUALITY_COVERAGE)
+#define AA_QUALITY_ERROR_MSG "quality must be 0 or 1"
+
+typedef struct {
+    float *edges;           /* x0, y0, x1, y1 for each edge */
+    int count;
+    int allocated;
+    float minx, miny, maxx, maxy;
+} AAPath;
+
+void aapath_init (AAPath *path);
+void aapath_free (AAPath *path);
+
+/* Each returns 0 on success or -1 when out of memory. */
+int aapath_add_polygon (AAPath *path, const float *xy, int n, int reverse);
+int aapath_add_line (AAPath *path, float x1, float y1, float x2, float y2,
+                     float width);
+int aapath_add_ellipse (AAPath *path, float cx, float cy, float rx, float ry,
+                        int reverse);
+
+/* Composites the path onto surf in the color rgba, whose alpha scales
+ * the coverage.  With blend false the color is written scaled by coverage
+ * over black, as the fast aaline does.  The surface is locked by the
+ * caller or here if needed.  Returns 1 if any pixel was touched, storing
+ * their bounds in drawn when given, 0 if nothing was drawn and -1 with the
+ * SDL error set when out of memory or the surface cannot be locked.
+ */
+int aapath_fill (SDL_Surface *surf, AAPath *path, const Uint8 *rgba,
+                 int blend, SDL_Rect *drawn);
+
+#endif /* AACOVERAGE_H */
@@ -66,6 +66,9 @@
 #ifndef V4L2_PIX_FMT_YUYV
     #define V4L2_PIX_FMT_YUYV 'YUYV'
 #endif
+#ifndef V4L2_PIX_FMT_YUV420
+    #define V4L2_PIX_FMT_YUV420 'YU12'
+#endif
 
 #define CLEAR(x) memset (&(x), 0, sizeof (x))
 #define SAT(c) if (c & (~255)) { if (c < 0) c = 0; else c = 255; }
@@ -1,7 +1,7 @@
 /* Auto generated file: with makeref.py .  Docs go in src/ *.doc . */
 #define DOC_PYGAMECAMERA "pygame module for camera use"
 
-#define DOC_PYGAMECAMERACOLORSPACE "colorspace(Surface, format, DestSurface = None) -> Surface\nSurface colorspace conversion"
+#define DOC_PYGAMECAMERACOLORSPACE "colorspace(Surface, format, DestSurface = None) -> Surface\ncolorspace(buffer, format, DestSurface, source) -> Surface\nSurface colorspace conversion"
 
 #define DOC_PYGAMECAMERALISTCAMERAS "list_cameras() -> [cameras]\nreturns a list of available cameras"
 
@@ -34,6 +34,7 @@ pygame module for camera use
 
 pygame.camera.colorspace
  colorspace(Surface, format, DestSurface = None) -> Surface
+ colorspace(buffer, format, DestSurface, source) -> Surface
 Surface colorspace conversion
 
 pygame.camera.list_cameras
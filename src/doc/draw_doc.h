@@ -15,9 +15,9 @@
 
 #define DOC_PYGAMEDRAWLINES "lines(Surface, color, closed, pointlist, width=1) -> Rect\ndraw multiple contiguous line segments"
 
-#define DOC_PYGAMEDRAWAALINE "aaline(Surface, color, startpos, endpos, blend=1) -> Rect\ndraw fine antialiased lines"
+#define DOC_PYGAMEDRAWAALINE "aaline(Surface, color, startpos, endpos, blend=1, quality=0) -> Rect\ndraw fine antialiased lines"
 
-#define DOC_PYGAMEDRAWAALINES "aalines(Surface, color, closed, pointlist, blend=1) -> Rect\ndraw a connected sequence of antialiased lines"
+#define DOC_PYGAMEDRAWAALINES "aalines(Surface, color, closed, pointlist, blend=1, quality=0) -> Rect\ndraw a connected sequence of antialiased lines"
 
 
 
@@ -57,11 +57,11 @@ pygame.draw.lines
 draw multiple contiguous line segments
 
 pygame.draw.aaline
- aaline(Surface, color, startpos, endpos, blend=1) -> Rect
+ aaline(Surface, color, startpos, endpos, blend=1, quality=0) -> Rect
 draw fine antialiased lines
 
 pygame.draw.aalines
- aalines(Surface, color, closed, pointlist, blend=1) -> Rect
+ aalines(Surface, color, closed, pointlist, blend=1, quality=0) -> Rect
 draw a connected sequence of antialiased lines
 
 */
\ No newline at end of file
@@ -5,6 +5,8 @@
 
 #define DOC_PYGAMEEVENTGET "get() -> Eventlist\nget(type) -> Eventlist\nget(typelist) -> Eventlist\nget events from the queue"
 
+#define DOC_PYGAMEEVENTGETINTO "get_into(buffer, types=None) -> count\nmove events from the queue into a buffer of records"
+
 #define DOC_PYGAMEEVENTPOLL "poll() -> EventType instance\nget a single event from the queue"
 
 #define DOC_PYGAMEEVENTWAIT "wait() -> EventType instance\nwait for a single event from the queue"
@@ -15,6 +17,16 @@
 
 #define DOC_PYGAMEEVENTEVENTNAME "event_name(type) -> string\nget the string name from and event id"
 
+#define DOC_PYGAMEEVENTSTARTRECORDING "start_recording() -> None\nrecord the events taken from the queue"
+
+#define DOC_PYGAMEEVENTSTOPRECORDING "stop_recording() -> bytes\nstop recording and get the recorded events"
+
+#define DOC_PYGAMEEVENTSTARTREPLAY "start_replay(data, speed=1.0) -> None\nfeed recorded events back through the queue"
+
+#define DOC_PYGAMEEVENTSTOPREPLAY "stop_replay() -> None\nstop replaying recorded events"
+
+#define DOC_PYGAMEEVENTISREPLAYING "is_replaying() -> bool\ntest if recorded events are being replayed"
+
 #define DOC_PYGAMEEVENTSETBLOCKED "set_blocked(type) -> None\nset_blocked(typelist) -> None\nset_blocked(None) -> None\ncontrol which events are allowed on the queue"
 
 #define DOC_PYGAMEEVENTSETALLOWED "set_allowed(type) -> None\nset_allowed(typelist) -> None\nset_allowed(None) -> None\ncontrol which events are allowed on the queue"
@@ -54,6 +66,10 @@ pygame.event.get
  get(typelist) -> Eventlist
 get events from the queue
 
+pygame.event.get_into
+ get_into(buffer, types=None) -> count
+move events from the queue into a buffer of records
+
 pygame.event.poll
  poll() -> EventType instance
 get a single event from the queue
@@ -77,6 +93,26 @@ pygame.event.event_name
  event_name(type) -> string
 get the string name from and event id
 
+pygame.event.start_recording
+ start_recording() -> None
+record the events taken from the queue
+
+pygame.event.stop_recording
+ stop_recording() -> bytes
+stop recording and get the recorded events
+
+pygame.event.start_replay
+ start_replay(data, speed=1.0) -> None
+feed recorded events back through the queue
+
+pygame.event.stop_replay
+ stop_replay() -> None
+stop replaying recorded events
+
+pygame.event.is_replaying
+ is_replaying() -> bool
+test if recorded events are being replayed
+
 pygame.event.set_blocked
  set_blocked(type) -> None
  set_blocked(typelist) -> None
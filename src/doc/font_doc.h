@@ -19,6 +19,8 @@
 
 #define DOC_FONTRENDER "render(text, antialias, color, background=None) -> Surface\ndraw text on a new Surface"
 
+#define DOC_FONTRENDERTO "render_to(surface, dest, text, antialias, color, background=None) -> Rect\ndraw text on an existing Surface"
+
 #define DOC_FONTSIZE "size(text) -> (width, height)\ndetermine the amount of space needed to render text"
 
 #define DOC_FONTSETUNDERLINE "set_underline(bool) -> None\ncontrol if text is rendered with an underline"
@@ -43,6 +45,12 @@
 
 #define DOC_FONTGETDESCENT "get_descent() -> int\nget the descent of the font"
 
+#define DOC_FONTSETCACHEBUDGET "set_cache_budget(bytes) -> None\nkeep rendered text surfaces for reuse"
+
+#define DOC_FONTGETCACHEBUDGET "get_cache_budget() -> int\nget the memory allowed for rendered text surfaces"
+
+#define DOC_FONTGETCACHESTATS "get_cache_stats() -> (hits, misses, evictions, bytes)\nget the counters of the rendered text cache"
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -89,6 +97,10 @@ pygame.font.Font.render
  render(text, antialias, color, background=None) -> Surface
 draw text on a new Surface
 
+pygame.font.Font.render_to
+ render_to(surface, dest, text, antialias, color, background=None) -> Rect
+draw text on an existing Surface
+
 pygame.font.Font.size
  size(text) -> (width, height)
 determine the amount of space needed to render text
@@ -137,4 +149,16 @@ pygame.font.Font.get_descent
  get_descent() -> int
 get the descent of the font
 
+pygame.font.Font.set_cache_budget
+ set_cache_budget(bytes) -> None
+keep rendered text surfaces for reuse
+
+pygame.font.Font.get_cache_budget
+ get_cache_budget() -> int
+get the memory allowed for rendered text surfaces
+
+pygame.font.Font.get_cache_stats
+ get_cache_stats() -> (hits, misses, evictions, bytes)
+get the counters of the rendered text cache
+
 */
\ No newline at end of file
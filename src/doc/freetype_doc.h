@@ -13,6 +13,12 @@
 
 #define DOC_PYGAMEFREETYPEGETCACHESIZE "get_cache_size() -> long\nReturn the glyph case size"
 
+#define DOC_PYGAMEFREETYPEGETCACHEBUDGET "get_cache_budget() -> long\nReturn the glyph cache budget in bytes"
+
+#define DOC_PYGAMEFREETYPESETCACHEBUDGET "set_cache_budget([budget])\nSet the glyph cache budget in bytes"
+
+#define DOC_PYGAMEFREETYPEGETCACHESTATS "get_cache_stats() -> (hits, misses, evictions, bytes)\nReturn glyph cache statistics"
+
 #define DOC_PYGAMEFREETYPEGETDEFAULTRESOLUTION "get_default_resolution() -> long\nReturn the default pixel size in dots per inch"
 
 #define DOC_PYGAMEFREETYPESETDEFAULTRESOLUTION "set_default_resolution([resolution])\nSet the default pixel size in dots per inch for the module"
@@ -33,6 +39,8 @@
 
 #define DOC_FONTGETMETRICS "get_metrics(text, size=0) -> [(...), ...]\nReturn the glyph metrics for the given text"
 
+#define DOC_FONTPRELOAD "preload(text, sizes=None, styles=None) -> (count, bytes)\nLoad the glyphs of the given text into the glyph cache"
+
 #define DOC_FONTHEIGHT "height -> int\nThe unscaled height of the font in font units"
 
 #define DOC_FONTASCENDER "ascender -> int\nThe unscaled ascent of the font in font units"
@@ -91,6 +99,8 @@
 
 #define DOC_FONTORIGIN "origin -> bool\nFont render to text origin mode"
 
+#define DOC_FONTRENDERCACHE "render_cache -> bool\nFont render result caching mode"
+
 #define DOC_FONTPAD "pad -> bool\npadded boundary mode"
 
 #define DOC_FONTUCS4 "ucs4 -> bool\nEnable UCS-4 mode"
@@ -130,6 +140,18 @@ pygame.freetype.get_cache_size
  get_cache_size() -> long
 Return the glyph case size
 
+pygame.freetype.get_cache_budget
+ get_cache_budget() -> long
+Return the glyph cache budget in bytes
+
+pygame.freetype.set_cache_budget
+ set_cache_budget([budget])
+Set the glyph cache budget in bytes
+
+pygame.freetype.get_cache_stats
+ get_cache_stats() -> (hits, misses, evictions, bytes)
+Return glyph cache statistics
+
 pygame.freetype.get_default_resolution
  get_default_resolution() -> long
 Return the default pixel size in dots per inch
@@ -171,6 +193,10 @@ pygame.freetype.Font.get_metrics
  get_metrics(text, size=0) -> [(...), ...]
 Return the glyph metrics for the given text
 
+pygame.freetype.Font.preload
+ preload(text, sizes=None, styles=None) -> (count, bytes)
+Load the glyphs of the given text into the glyph cache
+
 pygame.freetype.Font.height
  height -> int
 The unscaled height of the font in font units
@@ -288,6 +314,10 @@ pygame.freetype.Font.origin
  origin -> bool
 Font render to text origin mode
 
+pygame.freetype.Font.render_cache
+ render_cache -> bool
+Font render result caching mode
+
 pygame.freetype.Font.pad
  pad -> bool
 padded boundary mode
@@ -17,13 +17,13 @@
 
 #define DOC_PYGAMEGFXDRAWARC "arc(surface, x, y, r, start, end, color) -> None\ndraw an arc"
 
-#define DOC_PYGAMEGFXDRAWAACIRCLE "aacircle(surface, x, y, r, color) -> None\ndraw an anti-aliased circle"
+#define DOC_PYGAMEGFXDRAWAACIRCLE "aacircle(surface, x, y, r, color, quality=0) -> None\ndraw an anti-aliased circle"
 
 #define DOC_PYGAMEGFXDRAWFILLEDCIRCLE "filled_circle(surface, x, y, r, color) -> None\ndraw a filled circle"
 
 #define DOC_PYGAMEGFXDRAWELLIPSE "ellipse(surface, x, y, rx, ry, color) -> None\ndraw an ellipse"
 
-#define DOC_PYGAMEGFXDRAWAAELLIPSE "aaellipse(surface, x, y, rx, ry, color) -> None\ndraw an anti-aliased ellipse"
+#define DOC_PYGAMEGFXDRAWAAELLIPSE "aaellipse(surface, x, y, rx, ry, color, quality=0) -> None\ndraw an anti-aliased ellipse"
 
 #define DOC_PYGAMEGFXDRAWFILLEDELLIPSE "filled_ellipse(surface, x, y, rx, ry, color) -> None\ndraw a filled ellipse"
 
@@ -31,18 +31,22 @@
 
 #define DOC_PYGAMEGFXDRAWTRIGON "trigon(surface, x1, y1, x2, y2, x3, y3, color) -> None\ndraw a triangle"
 
-#define DOC_PYGAMEGFXDRAWAATRIGON "aatrigon(surface, x1, y1, x2, y2, x3, y3, color) -> None\ndraw an anti-aliased triangle"
+#define DOC_PYGAMEGFXDRAWAATRIGON "aatrigon(surface, x1, y1, x2, y2, x3, y3, color, quality=0) -> None\ndraw an anti-aliased triangle"
 
 #define DOC_PYGAMEGFXDRAWFILLEDTRIGON "filled_trigon(surface, x1, y1, x2, y2, x3, y3, color) -> None\ndraw a filled trigon"
 
 #define DOC_PYGAMEGFXDRAWPOLYGON "polygon(surface, points, color) -> None\ndraw a polygon"
 
-#define DOC_PYGAMEGFXDRAWAAPOLYGON "aapolygon(surface, points, color) -> None\ndraw an anti-aliased polygon"
+#define DOC_PYGAMEGFXDRAWAAPOLYGON "aapolygon(surface, points, color, quality=0) -> None\ndraw an anti-aliased polygon"
 
 #define DOC_PYGAMEGFXDRAWFILLEDPOLYGON "filled_polygon(surface, points, color) -> None\ndraw a filled polygon"
 
 #define DOC_PYGAMEGFXDRAWTEXTUREDPOLYGON "textured_polygon(surface, points, texture, tx, ty) -> None\ndraw a textured polygon"
 
+#define DOC_PYGAMEGFXDRAWTEXTUREDTRIANGLES "textured_triangles(surface, points, texcoords, texture, bilinear=False) -> None\ndraw a batch of affinely textured triangles"
+
+#define DOC_PYGAMEGFXDRAWTEXTUREDQUADS "textured_quads(surface, points, texcoords, texture, bilinear=False) -> None\ndraw a batch of affinely textured quadrilaterals"
+
 #define DOC_PYGAMEGFXDRAWBEZIER "bezier(surface, points, steps, color) -> None\ndraw a bezier curve"
 
 
@@ -87,7 +91,7 @@ pygame.gfxdraw.arc
 draw an arc
 
 pygame.gfxdraw.aacircle
- aacircle(surface, x, y, r, color) -> None
+ aacircle(surface, x, y, r, color, quality=0) -> None
 draw an anti-aliased circle
 
 pygame.gfxdraw.filled_circle
@@ -99,7 +103,7 @@ pygame.gfxdraw.ellipse
 draw an ellipse
 
 pygame.gfxdraw.aaellipse
- aaellipse(surface, x, y, rx, ry, color) -> None
+ aaellipse(surface, x, y, rx, ry, color, quality=0) -> None
 draw an anti-aliased ellipse
 
 pygame.gfxdraw.filled_ellipse
@@ -115,7 +119,7 @@ pygame.gfxdraw.trigon
 draw a triangle
 
 pygame.gfxdraw.aatrigon
- aatrigon(surface, x1, y1, x2, y2, x3, y3, color) -> None
+ aatrigon(surface, x1, y1, x2, y2, x3, y3, color, quality=0) -> None
 draw an anti-aliased triangle
 
 pygame.gfxdraw.filled_trigon
@@ -127,7 +131,7 @@ pygame.gfxdraw.polygon
 draw a polygon
 
 pygame.gfxdraw.aapolygon
- aapolygon(surface, points, color) -> None
+ aapolygon(surface, points, color, quality=0) -> None
 draw an anti-aliased polygon
 
 pygame.gfxdraw.filled_polygon
@@ -138,6 +142,14 @@ pygame.gfxdraw.textured_polygon
  textured_polygon(surface, points, texture, tx, ty) -> None
 draw a textured polygon
 
+pygame.gfxdraw.textured_triangles
+ textured_triangles(surface, points, texcoords, texture, bilinear=False) -> None
+draw a batch of affinely textured triangles
+
+pygame.gfxdraw.textured_quads
+ textured_quads(surface, points, texcoords, texture, bilinear=False) -> None
+draw a batch of affinely textured quadrilaterals
+
 pygame.gfxdraw.bezier
  bezier(surface, points, steps, color) -> None
 draw a bezier curve
@@ -9,10 +9,24 @@
 
 #define DOC_PYGAMEIMAGETOSTRING "tostring(Surface, format, flipped=False) -> string\ntransfer image to string buffer"
 
+#define DOC_PYGAMEIMAGETOBUFFER "tobuffer(Surface, format) -> BufferProxy\nshare the Surface pixels as a buffer in a string format"
+
 #define DOC_PYGAMEIMAGEFROMSTRING "fromstring(string, size, format, flipped=False) -> Surface\ncreate new Surface from a string buffer"
 
 #define DOC_PYGAMEIMAGEFROMBUFFER "frombuffer(string, size, format) -> Surface\ncreate a new Surface that shares data inside a string buffer"
 
+#define DOC_PYGAMEIMAGESAVEPNG "save_png(Surface, filename, level=-1, filter=None, fast=False) -> None\nsave a PNG image with chosen encoder settings"
+
+#define DOC_PYGAMEIMAGELOADASYNC "load_async(filename) -> AsyncLoad\nstart loading an image on a background thread"
+
+#define DOC_PYGAMEIMAGESETASYNCTHREADS "set_async_threads(count) -> None\nlimit how many images load_async decodes at once"
+
+#define DOC_PYGAMEIMAGEASYNCLOAD "pending result of pygame.image.load_async()"
+
+#define DOC_ASYNCLOADDONE "done() -> bool\ntest if the image has finished loading"
+
+#define DOC_ASYNCLOADRESULT "result() -> Surface\nwait for the loaded image"
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -39,6 +53,10 @@ pygame.image.tostring
  tostring(Surface, format, flipped=False) -> string
 transfer image to string buffer
 
+pygame.image.tobuffer
+ tobuffer(Surface, format) -> BufferProxy
+share the Surface pixels as a buffer in a string format
+
 pygame.image.fromstring
  fromstring(string, size, format, flipped=False) -> Surface
 create new Surface from a string buffer
@@ -47,4 +65,27 @@ pygame.image.frombuffer
  frombuffer(string, size, format) -> Surface
 create a new Surface that shares data inside a string buffer
 
+pygame.image.save_png
+ save_png(Surface, filename, level=-1, filter=None, fast=False) -> None
+save a PNG image with chosen encoder settings
+
+pygame.image.load_async
+ load_async(filename) -> AsyncLoad
+start loading an image on a background thread
+
+pygame.image.set_async_threads
+ set_async_threads(count) -> None
+limit how many images load_async decodes at once
+
+pygame.image.AsyncLoad
+pending result of pygame.image.load_async()
+
+pygame.image.AsyncLoad.done
+ done() -> bool
+test if the image has finished loading
+
+pygame.image.AsyncLoad.result
+ result() -> Surface
+wait for the loaded image
+
 */
\ No newline at end of file
@@ -27,7 +27,7 @@
 
 #define DOC_PYGAMEMIXERGETBUSY "get_busy() -> bool\ntest if any sound is being mixed"
 
-#define DOC_PYGAMEMIXERSOUND "Sound(filename) -> Sound\nSound(file=filename) -> Sound\nSound(buffer) -> Sound\nSound(buffer=buffer) -> Sound\nSound(object) -> Sound\nSound(file=object) -> Sound\nSound(array=object) -> Sound\nCreate a new Sound object from a file or buffer object"
+#define DOC_PYGAMEMIXERSOUND "Sound(filename) -> Sound\nSound(file=filename) -> Sound\nSound(buffer) -> Sound\nSound(buffer=buffer) -> Sound\nSound(object) -> Sound\nSound(file=object) -> Sound\nSound(array=object) -> Sound\nSound(buffer=buffer, copy=False) -> Sound\nSound(array=object, copy=False) -> Sound\nCreate a new Sound object from a file or buffer object"
 
 #define DOC_SOUNDPLAY "play(loops=0, maxtime=0, fade_ms=0) -> Channel\nbegin sound playback"
 
@@ -45,6 +45,18 @@
 
 #define DOC_SOUNDGETRAW "get_raw() -> bytes\nreturn a bytestring copy of the Sound samples."
 
+#define DOC_PYGAMEMIXERSOUNDSTREAM "SoundStream(file, budget=262144) -> SoundStream\nplay a long WAV file while it is read in the background"
+
+#define DOC_SOUNDSTREAMPLAY "play(loops=0) -> Channel\nbegin playback from the start of the stream"
+
+#define DOC_SOUNDSTREAMSTOP "stop() -> None\nstop stream playback"
+
+#define DOC_SOUNDSTREAMGETBUSY "get_busy() -> bool\ntest if the stream is playing"
+
+#define DOC_SOUNDSTREAMGETLENGTH "get_length() -> seconds\nget the length of the stream"
+
+#define DOC_SOUNDSTREAMGETBUDGET "get_budget() -> bytes\nget the size of the stream buffer"
+
 #define DOC_PYGAMEMIXERCHANNEL "Channel(id) -> Channel\nCreate a Channel object for controlling playback"
 
 #define DOC_CHANNELPLAY "play(Sound, loops=0, maxtime=0, fade_ms=0) -> None\nplay a Sound on a specific Channel"
@@ -142,6 +154,8 @@ pygame.mixer.Sound
  Sound(object) -> Sound
  Sound(file=object) -> Sound
  Sound(array=object) -> Sound
+ Sound(buffer=buffer, copy=False) -> Sound
+ Sound(array=object, copy=False) -> Sound
 Create a new Sound object from a file or buffer object
 
 pygame.mixer.Sound.play
@@ -176,6 +190,30 @@ pygame.mixer.Sound.get_raw
  get_raw() -> bytes
 return a bytestring copy of the Sound samples.
 
+pygame.mixer.SoundStream
+ SoundStream(file, budget=262144) -> SoundStream
+play a long WAV file while it is read in the background
+
+pygame.mixer.SoundStream.play
+ play(loops=0) -> Channel
+begin playback from the start of the stream
+
+pygame.mixer.SoundStream.stop
+ stop() -> None
+stop stream playback
+
+pygame.mixer.SoundStream.get_busy
+ get_busy() -> bool
+test if the stream is playing
+
+pygame.mixer.SoundStream.get_length
+ get_length() -> seconds
+get the length of the stream
+
+pygame.mixer.SoundStream.get_budget
+ get_budget() -> bytes
+get the size of the stream buffer
+
 pygame.mixer.Channel
  Channel(id) -> Channel
 Create a Channel object for controlling playback
@@ -25,7 +25,13 @@
 
 #define DOC_PYGAMEMIXERMUSICGETPOS "get_pos() -> time\nget the music play time"
 
-#define DOC_PYGAMEMIXERMUSICQUEUE "queue(filename) -> None\nqueue a music file to follow the current"
+#define DOC_PYGAMEMIXERMUSICQUEUE "queue(filename, loops=0, fade_ms=0) -> None\nqueue a music file to follow the current"
+
+#define DOC_PYGAMEMIXERMUSICCLEARQUEUE "clear_queue() -> None\nremove all queued music files"
+
+#define DOC_PYGAMEMIXERMUSICGETQUEUELENGTH "get_queue_length() -> count\nget the number of queued music files"
+
+#define DOC_PYGAMEMIXERMUSICSETQUEUEAHEAD "set_queue_ahead(count) -> None\nset how many queued music files are opened in advance"
 
 #define DOC_PYGAMEMIXERMUSICSETENDEVENT "set_endevent() -> None\nset_endevent(type) -> None\nhave the music send an event when playback stops"
 
@@ -90,9 +96,21 @@ pygame.mixer.music.get_pos
 get the music play time
 
 pygame.mixer.music.queue
- queue(filename) -> None
+ queue(filename, loops=0, fade_ms=0) -> None
 queue a music file to follow the current
 
+pygame.mixer.music.clear_queue
+ clear_queue() -> None
+remove all queued music files
+
+pygame.mixer.music.get_queue_length
+ get_queue_length() -> count
+get the number of queued music files
+
+pygame.mixer.music.set_queue_ahead
+ set_queue_ahead(count) -> None
+set how many queued music files are opened in advance
+
 pygame.mixer.music.set_endevent
  set_endevent() -> None
  set_endevent(type) -> None
@@ -29,6 +29,12 @@
 
 #define DOC_PYGAMEVERSIONREV "rev = 'a6f89747b551+'\nrepository revision of the build"
 
+#define DOC_PYGAMERWOBJECT "small module for reading Python file objects from SDL"
+
+#define DOC_PYGAMERWOBJECTSETRWOPSBUFFERSIZE "set_rwops_buffer_size(size) -> None\nset the read ahead size for Python file objects"
+
+#define DOC_PYGAMERWOBJECTGETRWOPSBUFFERSIZE "get_rwops_buffer_size() -> int\nget the read ahead size for Python file objects"
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -93,4 +99,15 @@ pygame.version.rev
  rev = 'a6f89747b551+'
 repository revision of the build
 
+pygame.rwobject
+small module for reading Python file objects from SDL
+
+pygame.rwobject.set_rwops_buffer_size
+ set_rwops_buffer_size(size) -> None
+set the read ahead size for Python file objects
+
+pygame.rwobject.get_rwops_buffer_size
+ get_rwops_buffer_size() -> int
+get the read ahead size for Python file objects
+
 */
\ No newline at end of file
@@ -9,18 +9,28 @@
 
 #define DOC_PYGAMETIMESETTIMER "set_timer(eventid, milliseconds) -> None\nrepeatedly create an event on the event queue"
 
-#define DOC_PYGAMETIMECLOCK "Clock() -> Clock\ncreate an object to help track time"
+#define DOC_PYGAMETIMECLOCK "Clock(history=256) -> Clock\ncreate an object to help track time"
 
 #define DOC_CLOCKTICK "tick(framerate=0) -> milliseconds\nupdate the clock"
 
 #define DOC_CLOCKTICKBUSYLOOP "tick_busy_loop(framerate=0) -> milliseconds\nupdate the clock"
 
+#define DOC_CLOCKTICKPRECISE "tick_precise(framerate=0) -> milliseconds\nupdate the clock with sub-millisecond frame pacing"
+
 #define DOC_CLOCKGETTIME "get_time() -> milliseconds\ntime used in the previous tick"
 
 #define DOC_CLOCKGETRAWTIME "get_rawtime() -> milliseconds\nactual time used in the previous tick"
 
 #define DOC_CLOCKGETFPS "get_fps() -> float\ncompute the clock framerate"
 
+#define DOC_CLOCKBEGINSECTION "begin_section(name) -> None\nstart timing a named part of the frame"
+
+#define DOC_CLOCKENDSECTION "end_section(name) -> None\nstop timing a named part of the frame"
+
+#define DOC_CLOCKGETFRAMEPERCENTILES "get_frame_percentiles(percents=(50, 95, 99), section=None) -> tuple\nget percentiles of the recent frame times"
+
+#define DOC_CLOCKGETFRAMEHISTOGRAM "get_frame_histogram(bin_ms=1.0, bins=32, section=None) -> list\ncount the recent frame times by duration"
+
 
 
 /* Docs in a comment... slightly easier to read. */
@@ -47,7 +57,7 @@ pygame.time.set_timer
 repeatedly create an event on the event queue
 
 pygame.time.Clock
- Clock() -> Clock
+ Clock(history=256) -> Clock
 create an object to help track time
 
 pygame.time.Clock.tick
@@ -58,6 +68,10 @@ pygame.time.Clock.tick_busy_loop
  tick_busy_loop(framerate=0) -> milliseconds
 update the clock
 
+pygame.time.Clock.tick_precise
+ tick_precise(framerate=0) -> milliseconds
+update the clock with sub-millisecond frame pacing
+
 pygame.time.Clock.get_time
  get_time() -> milliseconds
 time used in the previous tick
@@ -70,4 +84,20 @@ pygame.time.Clock.get_fps
  get_fps() -> float
 compute the clock framerate
 
+pygame.time.Clock.begin_section
+ begin_section(name) -> None
+start timing a named part of the frame
+
+pygame.time.Clock.end_section
+ end_section(name) -> None
+stop timing a named part of the frame
+
+pygame.time.Clock.get_frame_percentiles
+ get_frame_percentiles(percents=(50, 95, 99), section=None) -> tuple
+get percentiles of the recent frame times
+
+pygame.time.Clock.get_frame_histogram
+ get_frame_histogram(bin_ms=1.0, bins=32, section=None) -> list
+count the recent frame times by duration
+
 */
\ No newline at end of file
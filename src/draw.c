@@ -26,8 +26,17 @@
 #include "pygame.h"
 #include "pgcompat.h"
 #include "doc/draw_doc.h"
+#include "aacoverage.h"
 #include <math.h>
 
+/* SSE2 is part of the x86-64 baseline; 32-bit builds only get it when the
+ * compiler targets it. */
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define DRAW_SSE2_SUPPORT
+#endif
+
 /* Many C libraries seem to lack the trunc call (added in C99) */
 #define trunc(d)   (((d) >= 0.0) ? (floor(d)) : (ceil(d)))
 #define FRAC(z)    ((z) - trunc(z))
@@ -42,6 +51,7 @@ static void drawline(SDL_Surface* surf, Uint32 color, int startx, int starty, in
 static void drawaaline(SDL_Surface* surf, Uint32 color, float startx, float starty, float endx, float endy,
                        int blend);
 static void drawhorzline(SDL_Surface* surf, Uint32 color, int startx, int starty, int endx);
+static void fill_span(Uint8* pixel, int bpp, int count, Uint32 color);
 static void drawvertline(SDL_Surface* surf, Uint32 color, int x1, int y1, int y2);
 static void draw_arc(SDL_Surface *dst, int x, int y, int radius1, int radius2, double angle_start, double angle_stop, Uint32 color);
 static void draw_ellipse(SDL_Surface *dst, int x, int y, int rx, int ry, Uint32 color);
@@ -50,23 +60,119 @@ static void draw_fillpoly(SDL_Surface *dst, int *vx, int *vy, int n, Uint32 colo
 
 
 
+/* Draws aaline (points NULL, start and end given) or aalines with
+ * analytic coverage: all segments go into one path which is composited
+ * in a single pass, so joints are not blended twice.
+ */
+static PyObject* aalines_coverage(PyObject* surfobj, PyObject* colorobj, int closed,
+                                  PyObject* points, PyObject* start, PyObject* end, int blend)
+{
+    SDL_Surface* surf = PySurface_AsSurface(surfobj);
+    PyObject* item;
+    AAPath path;
+    SDL_Rect drawn;
+    Uint8 rgba[4];
+    float x, y, startx, starty, firstx, firsty;
+    int loop, length, result, count = 0;
+
+    if(!RGBAFromColorObj(colorobj, rgba))
+        return RAISE(PyExc_TypeError, "invalid color argument");
+
+    aapath_init(&path);
+    if(!points)
+    {
+        if(!TwoFloatsFromObj(start, &startx, &starty))
+            return RAISE(PyExc_TypeError, "Invalid start position argument");
+        if(!TwoFloatsFromObj(end, &x, &y))
+            return RAISE(PyExc_TypeError, "Invalid end position argument");
+        /* Integer positions are pixel centers, as with the fast aaline */
+        if(aapath_add_line(&path, startx + 0.5f, starty + 0.5f, x + 0.5f, y + 0.5f, 1.0f))
+            goto nomem;
+    }
+    else
+    {
+        if(!PySequence_Check(points))
+            return RAISE(PyExc_TypeError, "points argument must be a sequence of number pairs");
+        length = PySequence_Length(points);
+        if(length < 2)
+            return RAISE(PyExc_ValueError, "points argument must contain more than 1 points");
+
+        item = PySequence_GetItem(points, 0);
+        result = TwoFloatsFromObj(item, &startx, &starty);
+        Py_XDECREF(item);
+        if(!result) return RAISE(PyExc_TypeError, "points must be number pairs");
+        firstx = startx;
+        firsty = starty;
+
+        for(loop = 1; loop <= length; ++loop)
+        {
+            if(loop == length)
+            {
+                if(!closed || count < 2)
+                    break;
+                x = firstx;
+                y = firsty;
+            }
+            else
+            {
+                item = PySequence_GetItem(points, loop);
+                result = TwoFloatsFromObj(item, &x, &y);
+                Py_XDECREF(item);
+                if(!result) continue; /* skip bad points like aalines does */
+            }
+            if(aapath_add_line(&path, startx + 0.5f, starty + 0.5f, x + 0.5f, y + 0.5f, 1.0f))
+                goto nomem;
+            ++count;
+            startx = x;
+            starty = y;
+        }
+        startx = firstx;
+        starty = firsty;
+    }
+
+    if(!PySurface_Lock(surfobj))
+    {
+        aapath_free(&path);
+        return NULL;
+    }
+    result = aapath_fill(surf, &path, rgba, blend, &drawn);
+    aapath_free(&path);
+    if(!PySurface_Unlock(surfobj)) return NULL;
+
+    if(result < 0)
+        return RAISE(PyExc_SDLError, SDL_GetError());
+    if(!result)
+        return PyRect_New4((int)startx, (int)starty, 0, 0);
+    return PyRect_New(&drawn);
+
+nomem:
+    aapath_free(&path);
+    return PyErr_NoMemory();
+}
+
+
 static PyObject* aaline(PyObject* self, PyObject* arg)
 {
     PyObject *surfobj, *colorobj, *start, *end;
     SDL_Surface* surf;
     float startx, starty, endx, endy;
     int top, left, bottom, right;
-    int blend=1;
+    int blend=1, quality=AA_QUALITY_FAST;
     float pts[4];
     Uint8 rgba[4];
     Uint32 color;
     int anydraw;
 
     /*get all the arguments*/
-    if(!PyArg_ParseTuple(arg, "O!OOO|i", &PySurface_Type, &surfobj, &colorobj, &start, &end, &blend))
+    if(!PyArg_ParseTuple(arg, "O!OOO|ii", &PySurface_Type, &surfobj, &colorobj, &start, &end, &blend, &quality))
         return NULL;
+    if(!AA_QUALITY_IS_VALID(quality))
+        return RAISE(PyExc_ValueError, AA_QUALITY_ERROR_MSG);
     surf = PySurface_AsSurface(surfobj);
 
+    if(quality == AA_QUALITY_COVERAGE)
+        return aalines_coverage(surfobj, colorobj, 0, NULL, start, end, blend);
+
     if(surf->format->BytesPerPixel !=3 && surf->format->BytesPerPixel != 4)
         return RAISE(PyExc_ValueError, "unsupported bit depth for aaline draw (supports 32 & 24 bit)");
 
@@ -191,16 +297,26 @@ static PyObject* aalines(PyObject* self, PyObject* arg)
     float pts[4];
     Uint8 rgba[4];
     Uint32 color;
-    int closed, blend;
+    int closed, blend=1, quality=AA_QUALITY_FAST;
     int result, loop, length, drawn;
     float startx, starty;
 
     /*get all the arguments*/
-    if(!PyArg_ParseTuple(arg, "O!OOO|i", &PySurface_Type, &surfobj, &colorobj, &closedobj,
-                         &points, &blend))
+    if(!PyArg_ParseTuple(arg, "O!OOO|ii", &PySurface_Type, &surfobj, &colorobj, &closedobj,
+                         &points, &blend, &quality))
         return NULL;
+    if(!AA_QUALITY_IS_VALID(quality))
+        return RAISE(PyExc_ValueError, AA_QUALITY_ERROR_MSG);
     surf = PySurface_AsSurface(surfobj);
 
+    if(quality == AA_QUALITY_COVERAGE)
+    {
+        closed = PyObject_IsTrue(closedobj);
+        if(closed == -1)
+            return NULL;
+        return aalines_coverage(surfobj, colorobj, closed, points, NULL, NULL, blend);
+    }
+
     if(surf->format->BytesPerPixel !=3 && surf->format->BytesPerPixel != 4)
         return RAISE(PyExc_ValueError, "unsupported bit depth for aaline draw (supports 32 & 24 bit)");
 
@@ -1111,53 +1227,89 @@ static void drawline(SDL_Surface* surf, Uint32 color, int x1, int y1, int x2, in
 
 
 
-static void drawhorzline(SDL_Surface* surf, Uint32 color, int x1, int y1, int x2)
+/* Fill count pixels of a row, starting at pixel, with an already mapped
+ * color. The interior of the span is written with the widest stores the pixel
+ * size allows, so filled shapes are bound by memory bandwidth rather than by
+ * a per pixel loop. */
+static void fill_span(Uint8* pixel, int bpp, int count, Uint32 color)
 {
-    Uint8 *pixel, *end;
+    Uint8 pattern[12];
     Uint8 *colorptr;
 
-    if(x1 == x2)
-    {
-        set_at(surf, x1, y1, color);
-        return;
-    }
-
-    pixel = ((Uint8*)surf->pixels) + surf->pitch * y1;
-    if(x1 < x2)
-    {
-        end = pixel + x2 * surf->format->BytesPerPixel;
-        pixel += x1 * surf->format->BytesPerPixel;
-    }
-    else
-    {
-        end = pixel + x1 * surf->format->BytesPerPixel;
-        pixel += x2 * surf->format->BytesPerPixel;
-    }
-    switch(surf->format->BytesPerPixel)
+    switch(bpp)
     {
     case 1:
-        for(; pixel <= end; ++pixel) {
-            *pixel = (Uint8)color;
-        }break;
+        memset(pixel, (Uint8)color, count);
+        break;
     case 2:
-        for(; pixel <= end; pixel+=2) {
+        color &= 0xFFFF;
+        if(count > 0 && ((size_t)pixel & 2)) {
             *(Uint16*)pixel = (Uint16)color;
-        }break;
+            pixel += 2;
+            --count;
+        }
+        color |= color << 16;
+#ifdef DRAW_SSE2_SUPPORT
+        if(count >= 8) {
+            __m128i c128 = _mm_set1_epi32((int)color);
+            for(; count >= 8; count -= 8, pixel += 16)
+                _mm_storeu_si128((__m128i*)pixel, c128);
+        }
+#endif
+        for(; count >= 2; count -= 2, pixel += 4)
+            *(Uint32*)pixel = color;
+        if(count)
+            *(Uint16*)pixel = (Uint16)color;
+        break;
     case 3:
+        /* four pixels make up three whole 32 bit words */
         if(SDL_BYTEORDER == SDL_BIG_ENDIAN) color <<= 8;
         colorptr = (Uint8*)&color;
-        for(; pixel <= end; pixel+=3) {
-            pixel[0] = colorptr[0];
-            pixel[1] = colorptr[1];
-            pixel[2] = colorptr[2];
-        }break;
+        pattern[0] = colorptr[0];
+        pattern[1] = colorptr[1];
+        pattern[2] = colorptr[2];
+        memcpy(pattern + 3, pattern, 3);
+        memcpy(pattern + 6, pattern, 6);
+        for(; count >= 4; count -= 4, pixel += 12)
+            memcpy(pixel, pattern, 12);
+        for(; count > 0; --count, pixel += 3) {
+            pixel[0] = pattern[0];
+            pixel[1] = pattern[1];
+            pixel[2] = pattern[2];
+        }
+        break;
     default: /*case 4*/
-        for(; pixel <= end; pixel+=4) {
+#ifdef DRAW_SSE2_SUPPORT
+        if(count >= 4) {
+            __m128i c128 = _mm_set1_epi32((int)color);
+            for(; count >= 4; count -= 4, pixel += 16)
+                _mm_storeu_si128((__m128i*)pixel, c128);
+        }
+#endif
+        for(; count > 0; --count, pixel += 4)
             *(Uint32*)pixel = color;
-          }break;
+        break;
     }
 }
 
+static void drawhorzline(SDL_Surface* surf, Uint32 color, int x1, int y1, int x2)
+{
+    Uint8 *pixel;
+    int bpp = surf->format->BytesPerPixel;
+
+    if(x1 == x2)
+    {
+        set_at(surf, x1, y1, color);
+        return;
+    }
+
+    pixel = ((Uint8*)surf->pixels) + surf->pitch * y1;
+    if(x1 < x2)
+        fill_span(pixel + x1 * bpp, bpp, x2 - x1 + 1, color);
+    else
+        fill_span(pixel + x2 * bpp, bpp, x1 - x2 + 1, color);
+}
+
 static void drawhorzlineclip(SDL_Surface* surf, Uint32 color, int x1, int y1, int x2)
 {
     if(y1 < surf->clip_rect.y || y1 >= surf->clip_rect.y + surf->clip_rect.h)
@@ -34,6 +34,11 @@
 //          include it there for now.
 #include <SDL_syswm.h>
 
+#include <time.h>
+#ifndef WIN32
+#include <sys/time.h>
+#endif
+
 /*this user event object is for safely passing
  *objects through the event queue.
  */
@@ -49,6 +54,14 @@ typedef struct UserEventObject
 
 static UserEventObject* user_event_objects = NULL;
 
+/* Events posted from Python carry their dict in a UserEventObject */
+static int
+is_python_user_event (SDL_Event* event)
+{
+    return event->user.code == (int)USEROBJECT_CHECK1
+        && event->user.data1 == (void*)USEROBJECT_CHECK2;
+}
+
 /*must pass dictionary as this object*/
 static UserEventObject*
 user_event_addobject (PyObject* obj)
@@ -113,9 +126,16 @@ user_event_cleanup (void)
     }
 }
 
+static PyObject* event_dict (PyEventObject *e);
+
 static int PyEvent_FillUserEvent (PyEventObject *e, SDL_Event *event)
 {
-    UserEventObject *userobj = user_event_addobject (e->dict);
+    UserEventObject *userobj;
+    PyObject *dict = event_dict (e);
+    if (!dict)
+        return -1;
+
+    userobj = user_event_addobject (dict);
     if (!userobj)
         return -1;
 
@@ -129,6 +149,7 @@ static int PyEvent_FillUserEvent (PyEventObject *e, SDL_Event *event)
 static PyTypeObject PyEvent_Type;
 static PyObject* PyEvent_New (SDL_Event*);
 static PyObject* PyEvent_New2 (int, PyObject*);
+static PyObject* PyEvent_GetDict (PyObject*);
 #define PyEvent_Check(x) ((x)->ob_type == &PyEvent_Type)
 
 static char*
@@ -249,8 +270,7 @@ dict_from_event (SDL_Event* event)
     int hx, hy;
 
     /*check if it is an event the user posted*/
-    if (event->user.code == USEROBJECT_CHECK1
-        && event->user.data1 == (void*)USEROBJECT_CHECK2)
+    if (is_python_user_event (event))
     {
         dict = user_event_getobject ((UserEventObject*)event->user.data2);
         if (dict)
@@ -371,8 +391,31 @@ dict_from_event (SDL_Event* event)
     return dict;
 }
 
+/* Events posted from Python and drop events carry data that must be
+ * claimed at once, and window manager messages are only valid until the
+ * next event. Other events build their dict when it is first used.
+ */
+static int
+event_needs_dict_now (SDL_Event* event)
+{
+    if (is_python_user_event (event))
+        return 1;
+    if (event->type == SDL_USEREVENT && event->user.code == 0x1000)
+        return 1;
+    return event->type == SDL_SYSWMEVENT;
+}
+
 /* event object internals */
 
+/* Return the event dict, a borrowed reference, building it if needed */
+static PyObject*
+event_dict (PyEventObject *e)
+{
+    if (!e->dict)
+        e->dict = dict_from_event (&e->pending);
+    return e->dict;
+}
+
 static void
 event_dealloc (PyObject* self)
 {
@@ -394,6 +437,9 @@ event_str (PyObject* self)
     PyObject *encodedobj;
 #endif
 
+    if (!event_dict (e)) {
+        return NULL;
+    }
     strobj = PyObject_Str (e->dict);
     if (strobj == NULL) {
         return NULL;
@@ -462,12 +508,72 @@ static PyNumberMethods event_as_number = {
 #define OFF(x) offsetof(PyEventObject, x)
 
 static PyMemberDef event_members[] = {
-    {"__dict__",  T_OBJECT, OFF(dict), READONLY},
     {"type",      T_INT,    OFF(type), READONLY},
-    {"dict",      T_OBJECT, OFF(dict), READONLY},
     {NULL}  /* Sentinel */
 };
 
+static PyObject*
+event_get_dict (PyObject* self, void* closure)
+{
+    PyObject *dict = event_dict ((PyEventObject*)self);
+    Py_XINCREF (dict);
+    return dict;
+}
+
+static PyGetSetDef event_getsets[] = {
+    {"__dict__", event_get_dict, NULL, NULL, NULL},
+    {"dict", event_get_dict, NULL, NULL, NULL},
+    {NULL, NULL, NULL, NULL, NULL}  /* Sentinel */
+};
+
+static PyObject*
+event_sizeof (PyObject* self, PyObject* args)
+{
+    PyEventObject *e = (PyEventObject*)self;
+    Py_ssize_t size = sizeof (PyEventObject);
+    PyObject *dictsize;
+
+    /*the attribute dict counts once it has been built*/
+    if (e->dict)
+    {
+        dictsize = PyObject_CallMethod (e->dict, "__sizeof__", NULL);
+        if (!dictsize)
+            return NULL;
+        size += PyNumber_AsSsize_t (dictsize, NULL);
+        Py_DECREF (dictsize);
+    }
+    return PyLong_FromSsize_t (size);
+}
+
+static PyMethodDef event_methods[] = {
+    {"__sizeof__", event_sizeof, METH_NOARGS,
+     "__sizeof__() -> int\nsize of the event in memory, in bytes"},
+    {NULL, NULL, 0, NULL}  /* Sentinel */
+};
+
+/* The generic attribute functions find the dict through tp_dictoffset,
+ * so it has to exist first. Names found on the type, like type and the
+ * methods, are looked up without building it; the dict of an event from
+ * SDL never holds those names.
+ */
+static PyObject*
+event_getattro (PyObject* self, PyObject* name)
+{
+    if (!((PyEventObject*)self)->dict
+        && !_PyType_Lookup (Py_TYPE (self), name)
+        && !event_dict ((PyEventObject*)self))
+        return NULL;
+    return PyObject_GenericGetAttr (self, name);
+}
+
+static int
+event_setattro (PyObject* self, PyObject* name, PyObject* value)
+{
+    if (!event_dict ((PyEventObject*)self))
+        return -1;
+    return PyObject_GenericSetAttr (self, name, value);
+}
+
 /*
  * eventA == eventB
  * eventA != eventB
@@ -484,6 +590,10 @@ event_richcompare(PyObject *o1, PyObject *o2, int opid)
 
     e1 = (PyEventObject *) o1;
     e2 = (PyEventObject *) o2;
+    if (!event_dict (e1) || !event_dict (e2))
+    {
+        return NULL;
+    }
     switch (opid)
     {
     case Py_EQ:
@@ -524,8 +634,8 @@ static PyTypeObject PyEvent_Type =
     (hashfunc)NULL,                  /*hash*/
     (ternaryfunc)NULL,               /*call*/
     (reprfunc)NULL,                  /*str*/
-    PyObject_GenericGetAttr,         /* tp_getattro */
-    PyObject_GenericSetAttr,         /* tp_setattro */
+    event_getattro,                  /* tp_getattro */
+    event_setattro,                  /* tp_setattro */
     0,                               /* tp_as_buffer */
 #if PY3
     0,
@@ -539,9 +649,9 @@ static PyTypeObject PyEvent_Type =
     0,                               /* tp_weaklistoffset */
     0,                               /* tp_iter */
     0,                               /* tp_iternext */
-    0,                               /* tp_methods */
+    event_methods,                   /* tp_methods */
     event_members,                   /* tp_members */
-    0,                               /* tp_getset */
+    event_getsets,                   /* tp_getset */
     0,                               /* tp_base */
     0,                               /* tp_dict */
     0,                               /* tp_descr_get */
@@ -563,7 +673,20 @@ PyEvent_New (SDL_Event* event)
     if (event)
     {
         e->type = event->type;
-        e->dict = dict_from_event (event);
+        e->pending = *event;
+        if (event_needs_dict_now (event))
+        {
+            e->dict = dict_from_event (event);
+            if (!e->dict)
+            {
+                Py_DECREF (e);
+                return NULL;
+            }
+        }
+        else
+        {
+            e->dict = NULL;
+        }
     }
     else
     {
@@ -573,6 +696,31 @@ PyEvent_New (SDL_Event* event)
     return (PyObject*)e;
 }
 
+/* PyEvent_New as exported through the C API: callers there may read
+ * the dict field directly, so build it now.
+ */
+static PyObject*
+event_new_with_dict (SDL_Event* event)
+{
+    PyObject* e = PyEvent_New (event);
+
+    if (e && !event_dict ((PyEventObject*)e))
+    {
+        Py_DECREF (e);
+        return NULL;
+    }
+    return e;
+}
+
+/* Return an event's dict, a borrowed reference, building it if needed */
+static PyObject*
+PyEvent_GetDict (PyObject* obj)
+{
+    if (Py_TYPE (obj) != &PyEvent_Type)
+        return RAISE (PyExc_TypeError, "expected an Event object");
+    return event_dict ((PyEventObject*)obj);
+}
+
 static PyObject*
 PyEvent_New2 (int type, PyObject* dict)
 {
@@ -590,6 +738,472 @@ PyEvent_New2 (int type, PyObject* dict)
     return (PyObject*)e;
 }
 
+/* get_into() writes each event as one fixed size record */
+#define EVENT_RECORD_SIZE 32
+#define EVENT_BATCH 64
+
+typedef struct {
+    Sint32 type;
+    Uint32 time;
+    Sint32 data[6];
+} EventRecord;
+
+/* Fill the record fields of a system event */
+static void
+fields_from_event (SDL_Event* event, Sint32* data)
+{
+    switch (event->type)
+    {
+    case SDL_ACTIVEEVENT:
+        data[0] = event->active.gain;
+        data[1] = event->active.state;
+        break;
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+        data[0] = event->key.keysym.sym;
+        data[1] = event->key.keysym.mod;
+        data[2] = event->key.keysym.scancode;
+        data[3] = event->key.keysym.unicode;
+        break;
+    case SDL_MOUSEMOTION:
+        data[0] = event->motion.x;
+        data[1] = event->motion.y;
+        data[2] = event->motion.xrel;
+        data[3] = event->motion.yrel;
+        data[4] = event->motion.state;
+        break;
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+        data[0] = event->button.x;
+        data[1] = event->button.y;
+        data[2] = event->button.button;
+        break;
+    case SDL_JOYAXISMOTION:
+        data[0] = event->jaxis.which;
+        data[1] = event->jaxis.axis;
+        data[2] = event->jaxis.value;
+        break;
+    case SDL_JOYBALLMOTION:
+        data[0] = event->jball.which;
+        data[1] = event->jball.ball;
+        data[2] = event->jball.xrel;
+        data[3] = event->jball.yrel;
+        break;
+    case SDL_JOYHATMOTION:
+        data[0] = event->jhat.which;
+        data[1] = event->jhat.hat;
+        if (event->jhat.value&SDL_HAT_RIGHT)
+            data[2] = 1;
+        else if (event->jhat.value&SDL_HAT_LEFT)
+            data[2] = -1;
+        if (event->jhat.value&SDL_HAT_UP)
+            data[3] = 1;
+        else if (event->jhat.value&SDL_HAT_DOWN)
+            data[3] = -1;
+        break;
+    case SDL_JOYBUTTONUP:
+    case SDL_JOYBUTTONDOWN:
+        data[0] = event->jbutton.which;
+        data[1] = event->jbutton.button;
+        break;
+    case SDL_VIDEORESIZE:
+        data[0] = event->resize.w;
+        data[1] = event->resize.h;
+        break;
+    }
+}
+
+/* Rebuild a system event from its record fields */
+static void
+event_from_fields (int type, const Sint32* data, SDL_Event* event)
+{
+    memset (event, 0, sizeof (SDL_Event));
+    event->type = type;
+    switch (type)
+    {
+    case SDL_ACTIVEEVENT:
+        event->active.gain = data[0];
+        event->active.state = data[1];
+        break;
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+        event->key.state = type == SDL_KEYDOWN ? SDL_PRESSED : SDL_RELEASED;
+        event->key.keysym.sym = (SDLKey)data[0];
+        event->key.keysym.mod = (SDLMod)data[1];
+        event->key.keysym.scancode = data[2];
+        event->key.keysym.unicode = data[3];
+        break;
+    case SDL_MOUSEMOTION:
+        event->motion.x = data[0];
+        event->motion.y = data[1];
+        event->motion.xrel = data[2];
+        event->motion.yrel = data[3];
+        event->motion.state = data[4];
+        break;
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+        event->button.state =
+            type == SDL_MOUSEBUTTONDOWN ? SDL_PRESSED : SDL_RELEASED;
+        event->button.x = data[0];
+        event->button.y = data[1];
+        event->button.button = data[2];
+        break;
+    case SDL_JOYAXISMOTION:
+        event->jaxis.which = data[0];
+        event->jaxis.axis = data[1];
+        event->jaxis.value = data[2];
+        break;
+    case SDL_JOYBALLMOTION:
+        event->jball.which = data[0];
+        event->jball.ball = data[1];
+        event->jball.xrel = data[2];
+        event->jball.yrel = data[3];
+        break;
+    case SDL_JOYHATMOTION:
+        event->jhat.which = data[0];
+        event->jhat.hat = data[1];
+        if (data[2] > 0)
+            event->jhat.value |= SDL_HAT_RIGHT;
+        else if (data[2] < 0)
+            event->jhat.value |= SDL_HAT_LEFT;
+        if (data[3] > 0)
+            event->jhat.value |= SDL_HAT_UP;
+        else if (data[3] < 0)
+            event->jhat.value |= SDL_HAT_DOWN;
+        break;
+    case SDL_JOYBUTTONUP:
+    case SDL_JOYBUTTONDOWN:
+        event->jbutton.state =
+            type == SDL_JOYBUTTONDOWN ? SDL_PRESSED : SDL_RELEASED;
+        event->jbutton.which = data[0];
+        event->jbutton.button = data[1];
+        break;
+    case SDL_VIDEORESIZE:
+        event->resize.w = data[0];
+        event->resize.h = data[1];
+        break;
+    }
+}
+
+static void
+record_from_event (SDL_Event* event, Uint32 now, EventRecord* rec)
+{
+    PyObject *dict;
+
+    memset (rec, 0, sizeof (EventRecord));
+    rec->type = event->type;
+    rec->time = now;
+
+    /*events posted from Python keep their attributes in a dict*/
+    if (is_python_user_event (event))
+    {
+        dict = user_event_getobject ((UserEventObject*)event->user.data2);
+        if (dict)
+        {
+            Py_DECREF (dict);
+            return;
+        }
+    }
+
+    fields_from_event (event, rec->data);
+    if (event->type == SDL_USEREVENT && event->user.code == 0x1000) {
+        free (event->user.data1);
+        event->user.data1 = NULL;
+    }
+    if (event->type >= SDL_USEREVENT && event->type < SDL_NUMEVENTS)
+        rec->data[0] = event->user.code;
+}
+
+/* A recording starts with "PGER" and a little endian version number,
+ * followed by records in the get_into() layout, also little endian, whose
+ * time field holds the microseconds since the previous record. Only
+ * system events are kept: the program posts its own events again when it
+ * is replayed. A NOEVENT record ends each call that takes events off the
+ * queue, so a fast forward replay hands every call the events it took
+ * when recording.
+ */
+#define RECORDING_MAGIC "PGER"
+#define RECORDING_VERSION 1
+#define RECORDING_HEADER 8
+
+/* how replay_feed() was called */
+#define FEED_PUMP 0
+#define FEED_PEEK 1
+#define FEED_READ 2
+
+static Uint8 *rec_buf = NULL;
+static size_t rec_len = 0;
+static size_t rec_cap = 0;
+static int recording = 0;
+static int rec_failed = 0;
+static double rec_last_us;
+
+static Uint8 *play_buf = NULL;
+static size_t play_len = 0;
+static size_t play_pos = 0;
+static int replaying = 0;
+static int play_fed = 0;        /* peek() already fed the next batch */
+static double play_speed;
+static double play_start_us;
+static double play_due_us;      /* recorded time of the record at play_pos */
+static SDL_EventFilter play_old_filter = NULL;
+static int record_quit_registered = 0;
+
+/* A monotonic clock in microseconds */
+static double
+event_clock_us (void)
+{
+#if defined(WIN32)
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER count;
+
+    if (!freq.QuadPart)
+        QueryPerformanceFrequency (&freq);
+    QueryPerformanceCounter (&count);
+    return (double)count.QuadPart * 1000000.0 / (double)freq.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000000.0 + (double)ts.tv_nsec / 1000.0;
+#else
+    struct timeval tv;
+
+    gettimeofday (&tv, NULL);
+    return (double)tv.tv_sec * 1000000.0 + (double)tv.tv_usec;
+#endif
+}
+
+static void
+record_append (int type, const Sint32* data)
+{
+    Uint32 fields[EVENT_RECORD_SIZE / 4];
+    double delta;
+    Uint8 *buf;
+    size_t cap;
+    int i;
+
+    if (rec_len + EVENT_RECORD_SIZE > rec_cap)
+    {
+        cap = rec_cap * 2;
+        buf = (Uint8*)PyMem_Realloc (rec_buf, cap);
+        if (!buf)
+        {
+            recording = 0;
+            rec_failed = 1;
+            return;
+        }
+        rec_buf = buf;
+        rec_cap = cap;
+    }
+
+    delta = event_clock_us () - rec_last_us;
+    if (delta < 0)
+        delta = 0;
+    else if (delta > 4294967295.0)
+        delta = 4294967295.0;
+    delta = (double)(Uint32)delta;
+    rec_last_us += delta;
+
+    fields[0] = SDL_SwapLE32 ((Uint32)type);
+    fields[1] = SDL_SwapLE32 ((Uint32)delta);
+    for (i = 0; i < 6; ++i)
+        fields[i + 2] = SDL_SwapLE32 ((Uint32)data[i]);
+    memcpy (rec_buf + rec_len, fields, EVENT_RECORD_SIZE);
+    rec_len += EVENT_RECORD_SIZE;
+}
+
+/* Note an event taken off the queue */
+static void
+record_event (SDL_Event* event)
+{
+    Sint32 data[6] = {0, 0, 0, 0, 0, 0};
+
+    if (!recording || event->type == SDL_NOEVENT
+        || event->type == SDL_SYSWMEVENT || event->type >= SDL_USEREVENT)
+        return;
+    /*events posted from Python are posted again when replaying*/
+    if (is_python_user_event (event))
+        return;
+    fields_from_event (event, data);
+    record_append (event->type, data);
+}
+
+/* Note the end of a call that takes events off the queue */
+static void
+record_end_read (void)
+{
+    static const Sint32 data[6] = {0, 0, 0, 0, 0, 0};
+
+    if (recording)
+        record_append (SDL_NOEVENT, data);
+}
+
+static void
+record_stop (void)
+{
+    recording = 0;
+    rec_failed = 0;
+    if (rec_buf)
+    {
+        PyMem_Free (rec_buf);
+        rec_buf = NULL;
+    }
+    rec_len = rec_cap = 0;
+}
+
+/* While replaying, live input is dropped so only recorded input is seen.
+ * The window events are recorded too, so their live copies go as well:
+ * otherwise a program would see each focus change, resize and expose
+ * twice. QUIT still gets through so a replay can be closed.
+ * SDL_PushEvent() does not pass through the filter.
+ */
+static int
+replay_filter (const SDL_Event* event)
+{
+    switch (event->type)
+    {
+    case SDL_KEYDOWN:
+    case SDL_KEYUP:
+    case SDL_MOUSEMOTION:
+    case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
+    case SDL_JOYAXISMOTION:
+    case SDL_JOYBALLMOTION:
+    case SDL_JOYHATMOTION:
+    case SDL_JOYBUTTONDOWN:
+    case SDL_JOYBUTTONUP:
+    case SDL_ACTIVEEVENT:
+    case SDL_VIDEORESIZE:
+    case SDL_VIDEOEXPOSE:
+        return 0;
+    }
+    return play_old_filter ? play_old_filter (event) : 1;
+}
+
+static Uint32
+replay_field (size_t pos, int index)
+{
+    Uint32 field;
+
+    memcpy (&field, play_buf + pos + index * 4, 4);
+    return SDL_SwapLE32 (field);
+}
+
+static void
+replay_stop (void)
+{
+    if (!replaying)
+        return;
+    replaying = 0;
+    if (SDL_GetEventFilter () == replay_filter)
+        SDL_SetEventFilter (play_old_filter);
+    play_old_filter = NULL;
+    PyMem_Free (play_buf);
+    play_buf = NULL;
+    play_len = play_pos = 0;
+}
+
+/* Take the record at play_pos, returning 0 if it could not be queued */
+static int
+replay_next (void)
+{
+    SDL_Event event;
+    Sint32 data[6];
+    int type, i;
+
+    type = (int)replay_field (play_pos, 0);
+    if (type != SDL_NOEVENT)
+    {
+        for (i = 0; i < 6; ++i)
+            data[i] = (Sint32)replay_field (play_pos, i + 2);
+        event_from_fields (type, data, &event);
+        if (SDL_PushEvent (&event) < 0)
+            return 0;
+    }
+    play_pos += EVENT_RECORD_SIZE;
+    if (play_pos < play_len)
+        play_due_us += replay_field (play_pos, 1);
+    return 1;
+}
+
+/* Move recorded events that are due onto the queue */
+static void
+replay_feed (int how)
+{
+    double elapsed;
+
+    if (!replaying)
+        return;
+
+    if (play_speed > 0)
+    {
+        elapsed = (event_clock_us () - play_start_us) * play_speed;
+        while (play_pos < play_len && play_due_us <= elapsed)
+            if (!replay_next ())
+                break;
+    }
+    else if (how == FEED_READ && play_fed)
+    {
+        play_fed = 0;
+    }
+    else if (how != FEED_PUMP && !play_fed)
+    {
+        /* fast forward: queue the events of the next recorded call */
+        play_fed = how == FEED_PEEK;
+        while (play_pos < play_len)
+        {
+            int end = replay_field (play_pos, 0) == SDL_NOEVENT;
+
+            /* on a full queue the rest is fed by the next call */
+            if (!replay_next ())
+            {
+                play_fed = 0;
+                break;
+            }
+            if (end)
+                break;
+        }
+    }
+
+    if (play_pos >= play_len)
+        replay_stop ();
+}
+
+/* wait() while replaying; returns 0 if the replay ended first */
+static int
+replay_wait (SDL_Event* event)
+{
+    double wait_us;
+    Uint32 delay;
+
+    while (replaying)
+    {
+        replay_feed (FEED_READ);
+        if (SDL_PollEvent (event) == 1)
+            return 1;
+        if (!replaying || play_speed <= 0)
+            continue;
+
+        wait_us = play_due_us / play_speed
+            - (event_clock_us () - play_start_us);
+        delay = wait_us < 1000.0 ? 1 : (Uint32)(wait_us / 1000.0);
+        if (delay > 10)
+            delay = 10;
+        Py_BEGIN_ALLOW_THREADS;
+        SDL_Delay (delay);
+        Py_END_ALLOW_THREADS;
+    }
+    return 0;
+}
+
+static void
+record_cleanup (void)
+{
+    record_stop ();
+    replay_stop ();
+}
+
 /* event module functions */
 static PyObject*
 Event (PyObject* self, PyObject* arg, PyObject* keywords)
@@ -660,6 +1274,7 @@ static PyObject*
 pygame_pump (PyObject* self, PyObject* args)
 {
     VIDEO_INIT_CHECK ();
+    replay_feed (FEED_PUMP);
     SDL_PumpEvents ();
     Py_RETURN_NONE;
 }
@@ -672,13 +1287,19 @@ pygame_wait (PyObject* self, PyObject* args)
 
     VIDEO_INIT_CHECK ();
 
-    Py_BEGIN_ALLOW_THREADS;
-    status = SDL_WaitEvent (&event);
-    Py_END_ALLOW_THREADS;
+    status = replay_wait (&event);
+    if (!status)
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        status = SDL_WaitEvent (&event);
+        Py_END_ALLOW_THREADS;
+    }
 
     if (!status)
         return RAISE (PyExc_SDLError, SDL_GetError ());
 
+    record_event (&event);
+    record_end_read ();
     return PyEvent_New (&event);
 }
 
@@ -689,8 +1310,14 @@ pygame_poll (PyObject* self, PyObject* args)
 
     VIDEO_INIT_CHECK ();
 
+    replay_feed (FEED_READ);
     if (SDL_PollEvent (&event))
+    {
+        record_event (&event);
+        record_end_read ();
         return PyEvent_New (&event);
+    }
+    record_end_read ();
     return PyEvent_New (NULL);
 }
 
@@ -782,10 +1409,12 @@ event_get (PyObject* self, PyObject* args)
     if (!list)
         return NULL;
 
+    replay_feed (FEED_READ);
     SDL_PumpEvents ();
 
     while (SDL_PeepEvents (&event, 1, SDL_GETEVENT, mask) == 1)
     {
+        record_event (&event);
         e = PyEvent_New (&event);
         if (!e)
         {
@@ -796,9 +1425,223 @@ event_get (PyObject* self, PyObject* args)
         PyList_Append (list, e);
         Py_DECREF (e);
     }
+    record_end_read ();
     return list;
 }
 
+static PyObject*
+event_get_into (PyObject* self, PyObject* args, PyObject* kwds)
+{
+    SDL_Event events[EVENT_BATCH];
+    EventRecord rec;
+    PyObject *buffer, *type = Py_None;
+    char *buf = NULL;
+    Py_ssize_t buflen = 0;
+    int capacity, count = 0, want, got, i;
+    int mask = 0;
+    int loop, num, val;
+    Uint32 now;
+#if HAVE_NEW_BUFPROTO
+    Py_buffer view;
+    int have_view = 0;
+#endif
+    static char *kwids[] = {"buffer", "types", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "O|O", kwids,
+                                      &buffer, &type))
+        return NULL;
+
+    VIDEO_INIT_CHECK ();
+
+    if (type == Py_None)
+        mask = SDL_ALLEVENTS;
+    else if (PySequence_Check (type))
+    {
+        num = PySequence_Size (type);
+        for(loop = 0; loop < num; ++loop)
+        {
+            if (!IntFromObjIndex (type, loop, &val))
+                return RAISE
+                    (PyExc_TypeError,
+                     "type sequence must contain valid event types");
+            mask |= SDL_EVENTMASK (val);
+        }
+    }
+    else if (IntFromObj (type, &val))
+        mask = SDL_EVENTMASK (val);
+    else
+        return RAISE (PyExc_TypeError,
+                      "get_into type must be numeric or a sequence");
+
+#if HAVE_NEW_BUFPROTO
+#if PY2
+    if (PyObject_CheckBuffer (buffer)) {
+#endif
+        if (PyObject_GetBuffer (buffer, &view, PyBUF_WRITABLE))
+            return NULL;
+        have_view = 1;
+        buf = (char*)view.buf;
+        buflen = view.len;
+#if PY2
+    }
+#endif
+#endif
+#if PY2
+    if (!buf && PyObject_AsWriteBuffer (buffer, (void**)&buf, &buflen))
+        return NULL;
+#endif
+
+    if (buflen / EVENT_RECORD_SIZE > 0x7fffffff / EVENT_RECORD_SIZE)
+        capacity = 0x7fffffff / EVENT_RECORD_SIZE;
+    else
+        capacity = (int)(buflen / EVENT_RECORD_SIZE);
+
+    replay_feed (FEED_READ);
+    SDL_PumpEvents ();
+    now = SDL_GetTicks ();
+
+    while (count < capacity)
+    {
+        want = capacity - count;
+        if (want > EVENT_BATCH)
+            want = EVENT_BATCH;
+        got = SDL_PeepEvents (events, want, SDL_GETEVENT, mask);
+        if (got <= 0)
+            break;
+        for (i = 0; i < got; ++i)
+        {
+            record_event (&events[i]);
+            record_from_event (&events[i], now, &rec);
+            memcpy (buf + (Py_ssize_t)count * EVENT_RECORD_SIZE, &rec,
+                    EVENT_RECORD_SIZE);
+            ++count;
+        }
+        if (got < want)
+            break;
+    }
+
+#if HAVE_NEW_BUFPROTO
+    if (have_view)
+        PyBuffer_Release (&view);
+#endif
+    record_end_read ();
+    return PyInt_FromLong (count);
+}
+
+static void
+register_record_cleanup (void)
+{
+    if (!record_quit_registered)
+    {
+        PyGame_RegisterQuit (record_cleanup);
+        record_quit_registered = 1;
+    }
+}
+
+static PyObject*
+start_recording (PyObject* self)
+{
+    Uint32 version = SDL_SwapLE32 (RECORDING_VERSION);
+
+    record_stop ();
+    rec_cap = 64 * 1024;
+    rec_buf = (Uint8*)PyMem_Malloc (rec_cap);
+    if (!rec_buf)
+    {
+        rec_cap = 0;
+        return PyErr_NoMemory ();
+    }
+    memcpy (rec_buf, RECORDING_MAGIC, 4);
+    memcpy (rec_buf + 4, &version, 4);
+    rec_len = RECORDING_HEADER;
+    rec_last_us = event_clock_us ();
+    recording = 1;
+    register_record_cleanup ();
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+stop_recording (PyObject* self)
+{
+    PyObject *data;
+
+    if (!recording && !rec_failed)
+        return RAISE (PyExc_SDLError, "events are not being recorded");
+    if (rec_failed)
+    {
+        record_stop ();
+        return RAISE (PyExc_MemoryError, "out of memory while recording");
+    }
+    data = Bytes_FromStringAndSize ((char*)rec_buf, (Py_ssize_t)rec_len);
+    record_stop ();
+    return data;
+}
+
+static PyObject*
+start_replay (PyObject* self, PyObject* args, PyObject* kwds)
+{
+    const char *data;
+    int len;
+    double speed = 1.0;
+    Uint32 version;
+    static char *kwids[] = {"data", "speed", NULL};
+
+#if PY3
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "y#|d", kwids,
+                                      &data, &len, &speed))
+#else
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "s#|d", kwids,
+                                      &data, &len, &speed))
+#endif
+        return NULL;
+
+    VIDEO_INIT_CHECK ();
+
+    if (len < RECORDING_HEADER || memcmp (data, RECORDING_MAGIC, 4)
+        || (len - RECORDING_HEADER) % EVENT_RECORD_SIZE)
+        return RAISE (PyExc_ValueError, "not an event recording");
+    memcpy (&version, data + 4, 4);
+    if (SDL_SwapLE32 (version) != RECORDING_VERSION)
+        return PyErr_Format (PyExc_ValueError,
+                             "unsupported event recording version %u",
+                             (unsigned)SDL_SwapLE32 (version));
+    if (speed < 0)
+        return RAISE (PyExc_ValueError, "speed must not be negative");
+
+    replay_stop ();
+    if (len == RECORDING_HEADER)
+        Py_RETURN_NONE;
+    play_buf = (Uint8*)PyMem_Malloc (len);
+    if (!play_buf)
+        return PyErr_NoMemory ();
+    memcpy (play_buf, data, len);
+    play_len = len;
+    play_pos = RECORDING_HEADER;
+    play_due_us = replay_field (play_pos, 1);
+    play_speed = speed;
+    play_start_us = event_clock_us ();
+    play_fed = 0;
+    replaying = 1;
+
+    play_old_filter = SDL_GetEventFilter ();
+    SDL_SetEventFilter (replay_filter);
+    register_record_cleanup ();
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+stop_replay (PyObject* self)
+{
+    replay_stop ();
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+is_replaying (PyObject* self)
+{
+    return PyBool_FromLong (replaying);
+}
+
 static PyObject*
 event_peek (PyObject* self, PyObject* args)
 {
@@ -841,6 +1684,7 @@ event_peek (PyObject* self, PyObject* args)
                           "peek type must be numeric or a sequence");
     }
 
+    replay_feed (FEED_PEEK);
     SDL_PumpEvents ();
     result = SDL_PeepEvents (&event, 1, SDL_PEEKEVENT, mask);
 
@@ -1017,9 +1861,22 @@ static PyMethodDef _event_methods[] =
     { "poll", (PyCFunction) pygame_poll, METH_NOARGS, DOC_PYGAMEEVENTPOLL },
     { "clear", event_clear, METH_VARARGS, DOC_PYGAMEEVENTCLEAR },
     { "get", event_get, METH_VARARGS, DOC_PYGAMEEVENTGET },
+    { "get_into", (PyCFunction) event_get_into, METH_VARARGS | METH_KEYWORDS,
+      DOC_PYGAMEEVENTGETINTO },
     { "peek", event_peek, METH_VARARGS, DOC_PYGAMEEVENTPEEK },
     { "post", event_post, METH_VARARGS, DOC_PYGAMEEVENTPOST },
 
+    { "start_recording", (PyCFunction) start_recording, METH_NOARGS,
+      DOC_PYGAMEEVENTSTARTRECORDING },
+    { "stop_recording", (PyCFunction) stop_recording, METH_NOARGS,
+      DOC_PYGAMEEVENTSTOPRECORDING },
+    { "start_replay", (PyCFunction) start_replay,
+      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEEVENTSTARTREPLAY },
+    { "stop_replay", (PyCFunction) stop_replay, METH_NOARGS,
+      DOC_PYGAMEEVENTSTOPREPLAY },
+    { "is_replaying", (PyCFunction) is_replaying, METH_NOARGS,
+      DOC_PYGAMEEVENTISREPLAYING },
+
     { "set_allowed", set_allowed, METH_VARARGS, DOC_PYGAMEEVENTSETALLOWED },
     { "set_blocked", set_blocked, METH_VARARGS, DOC_PYGAMEEVENTSETBLOCKED },
     { "get_blocked", get_blocked, METH_VARARGS, DOC_PYGAMEEVENTGETBLOCKED },
@@ -1071,11 +1928,17 @@ MODINIT_DEFINE (event)
         MODINIT_ERROR;
     }
 
+    if (PyModule_AddIntConstant (module, "RECORD_SIZE", EVENT_RECORD_SIZE)) {
+        DECREF_MOD (module);
+        MODINIT_ERROR;
+    }
+
     /* export the c api */
     c_api[0] = &PyEvent_Type;
-    c_api[1] = PyEvent_New;
+    c_api[1] = event_new_with_dict;
     c_api[2] = PyEvent_New2;
     c_api[3] = PyEvent_FillUserEvent;
+    c_api[4] = PyEvent_GetDict;
     apiobj = encapsulate_api (c_api, "event");
     if (apiobj == NULL) {
         DECREF_MOD (module);
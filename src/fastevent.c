@@ -30,6 +30,13 @@
 
 static int FE_WasInit = 0;
 
+/* posting ring size limits for init() */
+#define FE_DEFAULT_QUEUE 4096
+#define FE_MAX_QUEUE (1 << 20)
+
+/* events taken per FE_GetEvents call in get() */
+#define FE_BATCH 64
+
 #define FE_INIT_CHECK()                                                 \
     do                                                                  \
     {                                                                   \
@@ -52,12 +59,29 @@ fastevent_cleanup (void)
 /* fastevent module functions */
 
 /* DOC */ static char doc_init[] =
-/* DOC */ "pygame.fastevent.init() -> None\n"
+/* DOC */ "pygame.fastevent.init(queue_size=4096) -> None\n"
 /* DOC */ "initialize pygame.fastevent.\n"
+/* DOC */ "\n"
+/* DOC */ "Events posted with post() go into a queue of queue_size slots\n"
+/* DOC */ "that any number of threads can fill without taking a lock. The\n"
+/* DOC */ "size is rounded up to a power of two. When the queue is full,\n"
+/* DOC */ "posts fall back to the SDL event queue and are counted as\n"
+/* DOC */ "overflows; a queue_size of 0 always uses the SDL queue. The size\n"
+/* DOC */ "only takes effect the first time fastevent is initialized.\n"
 /* DOC */ ;
 static PyObject *
-fastevent_init (PyObject * self)
+fastevent_init (PyObject * self, PyObject * args, PyObject * kwds)
 {
+    int queue_size = FE_DEFAULT_QUEUE;
+    static char *kwids[] = {"queue_size", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "|i", kwids, &queue_size))
+        return NULL;
+    if (queue_size < 0 || queue_size > FE_MAX_QUEUE)
+        return PyErr_Format (PyExc_ValueError,
+                             "queue_size must be from 0 to %d",
+                             FE_MAX_QUEUE);
+
     VIDEO_INIT_CHECK ();
 
 #ifndef WITH_THREAD
@@ -66,7 +90,7 @@ fastevent_init (PyObject * self)
 #else
     if (!FE_WasInit)
     {
-        if (FE_Init () == -1)
+        if (FE_Init (queue_size) == -1)
             return RAISE (PyExc_SDLError, FE_GetError ());
 
         PyGame_RegisterQuit (fastevent_cleanup);
@@ -159,13 +183,17 @@ fastevent_poll (PyObject * self)
 /* DOC */ static char doc_get[] =
 /* DOC */ "pygame.fastevent.get() -> list of Events\n"
 /* DOC */ "get all events from the queue\n"
+/* DOC */ "\n"
+/* DOC */ "Events are taken in batches, from the SDL queue first and then\n"
+/* DOC */ "from the posting queue. Events posted by one thread keep their\n"
+/* DOC */ "order, unless some of them overflowed to the SDL queue.\n"
 /* DOC */ ;
 static PyObject *
 fastevent_get (PyObject * self)
 {
-    SDL_Event event;
+    SDL_Event events[FE_BATCH];
     PyObject  *list, *e;
-    int       status;
+    int       count, i;
 
     FE_INIT_CHECK ();
 
@@ -175,25 +203,48 @@ fastevent_get (PyObject * self)
 
     FE_PumpEvents ();
 
-    while (1)
+    do
     {
-        status = FE_PollEvent (&event);
-        if (status != 1)
-            break;
-        e = PyEvent_New (&event);
-        if (!e)
+        count = FE_GetEvents (events, FE_BATCH);
+        for (i = 0; i < count; ++i)
         {
-            Py_DECREF (list);
-            return NULL;
-        }
+            e = PyEvent_New (&events[i]);
+            if (!e)
+            {
+                Py_DECREF (list);
+                return NULL;
+            }
 
-        PyList_Append (list, e);
-        Py_DECREF (e);
+            PyList_Append (list, e);
+            Py_DECREF (e);
+        }
     }
+    while (count == FE_BATCH);
 
     return list;
 }
 
+/* DOC */ static char doc_get_queue_stats[] =
+/* DOC */ "pygame.fastevent.get_queue_stats() -> (capacity, queued, peak, overflows)\n"
+/* DOC */ "get posting queue statistics\n"
+/* DOC */ "\n"
+/* DOC */ "capacity is the number of slots in the posting queue and queued\n"
+/* DOC */ "the events now waiting in it. peak is the most events found\n"
+/* DOC */ "waiting when the queue was read, and overflows counts the posts\n"
+/* DOC */ "that found it full and went to the SDL queue instead.\n"
+/* DOC */ ;
+static PyObject *
+fastevent_get_queue_stats (PyObject * self)
+{
+    FE_Stats stats;
+
+    FE_INIT_CHECK ();
+
+    FE_GetStats (&stats);
+    return Py_BuildValue ("(iiik)", stats.capacity, stats.queued,
+                          stats.peak, (unsigned long) stats.overflows);
+}
+
 /*DOC*/ static char doc_post[] =
 /*DOC*/ "pygame.fastevent.post(Event) -> None\n"
 /*DOC*/ "place an event on the queue\n"
@@ -205,11 +256,12 @@ fastevent_get (PyObject * self)
 /*DOC*/ "the standard MOUSEBUTTONDOWN attributes to be available, like\n"
 /*DOC*/ "'pos' and 'button'.\n"
 /*DOC*/ "\n"
-/*DOC*/ "Because pygame.fastevent.post() may have to wait for the queue\n"
-/*DOC*/ "to empty, you can get into a dead lock if you try to append an\n"
-/*DOC*/ "event on to a full queue from the thread that processes events.\n"
-/*DOC*/ "For that reason I do not recommend using this function in the\n"
-/*DOC*/ "main thread of an SDL program.\n"
+/*DOC*/ "Posting takes no lock while the posting queue has room. When it\n"
+/*DOC*/ "is full, pygame.fastevent.post() may have to wait for the SDL\n"
+/*DOC*/ "queue to empty, so you can get into a dead lock if you post to\n"
+/*DOC*/ "full queues from the thread that processes events. For that\n"
+/*DOC*/ "reason I do not recommend using this function in the main\n"
+/*DOC*/ "thread of an SDL program.\n"
 /*DOC*/ ;
 static PyObject *
 fastevent_post (PyObject * self, PyObject * arg)
@@ -240,8 +292,11 @@ fastevent_post (PyObject * self, PyObject * arg)
 
 static PyMethodDef _fastevent_methods[] =
 {
-    {"init", (PyCFunction) fastevent_init, METH_NOARGS, doc_init},
+    {"init", (PyCFunction) fastevent_init, METH_VARARGS | METH_KEYWORDS,
+     doc_init},
     {"get", (PyCFunction) fastevent_get, METH_NOARGS, doc_get},
+    {"get_queue_stats", (PyCFunction) fastevent_get_queue_stats, METH_NOARGS,
+     doc_get_queue_stats},
     {"pump", (PyCFunction) fastevent_pump, METH_NOARGS, doc_pump},
     {"wait", (PyCFunction) fastevent_wait, METH_NOARGS, doc_wait},
     {"poll", (PyCFunction) fastevent_poll, METH_NOARGS, doc_poll},
@@ -60,6 +60,119 @@ FE_GetError ()
 static SDL_mutex *eventLock = NULL;
 static SDL_cond *eventWait = NULL;
 static SDL_TimerID eventTimer = 0;
+static volatile int eventWaiters = 0;
+
+//----------------------------------------
+//
+//Atomic operations for the posting ring. Without them every
+//event goes through the SDL queue under eventLock.
+//
+
+#if defined(__GNUC__) && \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 1))
+#define FE_HAVE_ATOMICS 1
+#define FE_CAS(p, o, n) __sync_bool_compare_and_swap ((p), (o), (n))
+#define FE_ADD(p, v) __sync_fetch_and_add ((p), (v))
+#define FE_FENCE() __sync_synchronize ()
+#elif defined(_MSC_VER)
+#include <windows.h>
+#define FE_HAVE_ATOMICS 1
+#define FE_CAS(p, o, n)                                                 \
+    (InterlockedCompareExchange ((volatile LONG*)(p), (LONG)(n), (LONG)(o)) \
+     == (LONG)(o))
+#define FE_ADD(p, v) InterlockedExchangeAdd ((volatile LONG*)(p), (LONG)(v))
+#define FE_FENCE() MemoryBarrier ()
+#else
+#define FE_HAVE_ATOMICS 0
+#endif
+
+//----------------------------------------
+//
+//Posting ring: a bounded queue where any number of threads post
+//without locking and the event reader drains it. Each cell's
+//sequence number says whose turn it is: pos when free for the
+//producer claiming pos, pos + 1 once the event is stored.
+//
+
+typedef struct
+{
+    volatile Uint32 seq;
+    SDL_Event event;
+} FE_Cell;
+
+static struct
+{
+    FE_Cell *cells;
+    Uint32 mask;
+    char pad0[64];              /* keep producers off the reader's line */
+    volatile Uint32 head;       /* next position producers claim */
+    char pad1[64];
+    Uint32 tail;                /* next position read, under eventLock */
+    Uint32 peak;
+    volatile Uint32 overflows;
+} ring;
+
+#if FE_HAVE_ATOMICS
+static int
+ringPush (SDL_Event * ev)
+{
+    FE_Cell *cell;
+    Uint32 pos;
+    Sint32 diff;
+
+    pos = ring.head;
+    for (;;)
+    {
+        cell = &ring.cells[pos & ring.mask];
+        diff = (Sint32) (cell->seq - pos);
+        if (diff == 0)
+        {
+            if (FE_CAS (&ring.head, pos, pos + 1))
+                break;
+        }
+        else if (diff < 0)
+            return 0;           /* full */
+        pos = ring.head;
+    }
+
+    cell->event = *ev;
+    FE_FENCE ();
+    cell->seq = pos + 1;
+    return 1;
+}
+#endif
+
+static int
+ringPop (SDL_Event * events, int numevents)
+{
+    FE_Cell *cell;
+    Uint32 queued;
+    int n;
+
+    if (!ring.cells)
+        return 0;
+
+    queued = ring.head - ring.tail;
+    if (queued > ring.peak)
+        ring.peak = queued;
+
+    for (n = 0; n < numevents; ++n)
+    {
+        cell = &ring.cells[ring.tail & ring.mask];
+        if (cell->seq != ring.tail + 1)
+            break;              /* empty, or the producer is still writing */
+#if FE_HAVE_ATOMICS
+        FE_FENCE ();
+#endif
+        events[n] = cell->event;
+#if FE_HAVE_ATOMICS
+        FE_FENCE ();
+#endif
+        cell->seq = ring.tail + ring.mask + 1;
+        ring.tail++;
+    }
+    return n;
+}
 
 //----------------------------------------
 //
@@ -69,6 +182,29 @@ static SDL_TimerID eventTimer = 0;
 int
 FE_PushEvent (SDL_Event * ev)
 {
+#if FE_HAVE_ATOMICS
+    if (ring.cells)
+    {
+        if (ringPush (ev))
+        {
+            FE_FENCE ();
+            if (eventWaiters)
+            {
+                /* A waiter that found the ring empty holds eventLock
+                 * until it sleeps, so taking the lock here keeps the
+                 * signal from landing before its SDL_CondWait.
+                 */
+                SDL_LockMutex (eventLock);
+                SDL_UnlockMutex (eventLock);
+                SDL_CondSignal (eventWait);
+            }
+            return 1;
+        }
+        FE_ADD (&ring.overflows, 1);
+    }
+#endif
+
+    /* no ring, or it is full: wait for room on the SDL queue */
     SDL_LockMutex (eventLock);
     while (-1 == SDL_PushEvent (ev))
         SDL_CondWait (eventWait, eventLock);
@@ -91,6 +227,19 @@ FE_PumpEvents ()
     SDL_UnlockMutex (eventLock);
 }
 
+//----------------------------------------
+//
+//Take one event, SDL queue first, with eventLock held
+//
+
+static int
+pollLocked (SDL_Event * event)
+{
+    if (0 < SDL_PollEvent (event))
+        return 1;
+    return ringPop (event, 1);
+}
+
 //----------------------------------------
 //
 //
@@ -102,7 +251,7 @@ FE_PollEvent (SDL_Event * event)
     int val = 0;
 
     SDL_LockMutex (eventLock);
-    val = SDL_PollEvent (event);
+    val = pollLocked (event);
     SDL_UnlockMutex (eventLock);
 
     if (0 < val)
@@ -111,6 +260,31 @@ FE_PollEvent (SDL_Event * event)
     return val;
 }
 
+//----------------------------------------
+//
+//Take up to numevents events in one go, SDL queue first.
+//Events stay in order within each queue, not between them.
+//
+
+int
+FE_GetEvents (SDL_Event * events, int numevents)
+{
+    int n;
+
+    SDL_LockMutex (eventLock);
+    n = SDL_PeepEvents (events, numevents, SDL_GETEVENT, SDL_ALLEVENTS);
+    if (n < 0)
+        n = 0;
+    if (n < numevents)
+        n += ringPop (events + n, numevents - n);
+    SDL_UnlockMutex (eventLock);
+
+    if (0 < n)
+        SDL_CondBroadcast (eventWait);
+
+    return n;
+}
+
 //----------------------------------------
 //
 //Replacement for SDL_WaitEvent
@@ -122,8 +296,13 @@ FE_WaitEvent (SDL_Event * event)
     int val = 0;
 
     SDL_LockMutex (eventLock);
-    while (0 >= (val = SDL_PollEvent (event)))
+    eventWaiters++;
+#if FE_HAVE_ATOMICS
+    FE_FENCE ();
+#endif
+    while (0 >= (val = pollLocked (event)))
         SDL_CondWait (eventWait, eventLock);
+    eventWaiters--;
     SDL_UnlockMutex (eventLock);
     SDL_CondSignal (eventWait);
 
@@ -135,6 +314,22 @@ FE_WaitEvent (SDL_Event * event)
 //
 //
 
+void
+FE_GetStats (FE_Stats * stats)
+{
+    SDL_LockMutex (eventLock);
+    stats->capacity = ring.cells ? (int) ring.mask + 1 : 0;
+    stats->queued = (int) (ring.head - ring.tail);
+    stats->peak = (int) ring.peak;
+    stats->overflows = ring.overflows;
+    SDL_UnlockMutex (eventLock);
+}
+
+//----------------------------------------
+//
+//
+//
+
 static Uint32
 timerCallback (Uint32 interval, void *param)
 {
@@ -144,15 +339,36 @@ timerCallback (Uint32 interval, void *param)
 
 //----------------------------------------
 //
-//
+//queue_size is rounded up to a power of two; 0 posts straight
+//to the SDL queue.
 //
 
 int
-FE_Init ()
+FE_Init (int queue_size)
 {
     if (0 == (SDL_INIT_TIMER & SDL_WasInit (SDL_INIT_TIMER)))
         SDL_InitSubSystem (SDL_INIT_TIMER);
 
+    memset (&ring, 0, sizeof (ring));
+#if FE_HAVE_ATOMICS
+    if (0 < queue_size)
+    {
+        Uint32 size, i;
+
+        for (size = 2; size < (Uint32) queue_size; size <<= 1)
+            ;
+        ring.cells = (FE_Cell *) malloc (size * sizeof (FE_Cell));
+        if (NULL == ring.cells)
+        {
+            setError ("FE: can't allocate the event queue");
+            return -1;
+        }
+        for (i = 0; i < size; ++i)
+            ring.cells[i].seq = i;
+        ring.mask = size - 1;
+    }
+#endif
+
     eventLock = SDL_CreateMutex ();
     if (NULL == eventLock)
     {
@@ -192,4 +408,7 @@ FE_Quit ()
     eventWait = NULL;
 
     SDL_RemoveTimer (eventTimer);
+
+    free (ring.cells);
+    memset (&ring, 0, sizeof (ring));
 }
@@ -32,13 +32,22 @@
 extern "C" {
 #endif
 
-  int FE_Init(void);                     // Initialize FE
+  typedef struct {
+    int capacity;                        // slots in the posting ring
+    int queued;                          // events waiting in the ring
+    int peak;                            // most events seen waiting
+    Uint32 overflows;                    // posts that found the ring full
+  } FE_Stats;
+
+  int FE_Init(int queue_size);           // Initialize FE
   void FE_Quit(void);                    // shutdown FE
 
   void FE_PumpEvents(void);              // replacement for SDL_PumpEvents
   int FE_PollEvent(SDL_Event *event);    // replacement for SDL_PollEvent
   int FE_WaitEvent(SDL_Event *event);    // replacement for SDL_WaitEvent
   int FE_PushEvent(SDL_Event *event);    // replacement for SDL_PushEvent
+  int FE_GetEvents(SDL_Event *events, int numevents); // take many events
+  void FE_GetStats(FE_Stats *stats);     // posting ring statistics
 
   char *FE_GetError(void);               // get the last error
 #ifdef __cplusplus
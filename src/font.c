@@ -311,22 +311,16 @@ font_set_underline (PyObject* self, PyObject* args)
 }
 
 static PyObject*
-font_render(PyObject* self, PyObject* args)
+render_text(PyObject* self, PyObject* text, int aa,
+            PyObject* fg_rgba_obj, PyObject* bg_rgba_obj)
 {
     TTF_Font* font = PyFont_AsFont (self);
-    int aa;
-    PyObject* text, *final;
-    PyObject* fg_rgba_obj, *bg_rgba_obj = NULL;
+    PyObject* final;
     Uint8 rgba[] = {0, 0, 0, 0};
     SDL_Surface* surf;
     SDL_Color foreg, backg;
     int just_return;
 
-    if (!PyArg_ParseTuple(args, "OiO|O", &text, &aa, &fg_rgba_obj,
-                          &bg_rgba_obj)) {
-        return NULL;
-    }
-
     if (!RGBAFromColorObj(fg_rgba_obj, rgba)) {
         return RAISE(PyExc_TypeError, "Invalid foreground RGBA argument");
     }
@@ -450,6 +444,296 @@ font_render(PyObject* self, PyObject* args)
     return final;
 }
 
+/* The render cache
+ *
+ * Rendered surfaces are kept in a dict, keyed by the text, antialias
+ * flag, colors and font style. Each entry is a [surface, older, newer]
+ * list, where older and newer are the keys of its neighbours in least
+ * recently used order, or None at the ends. The font holds the oldest and
+ * newest keys, so a use or an eviction costs a few dict lookups; when the
+ * cached pixels would exceed the budget, the oldest entries are dropped.
+ */
+
+/* Returns a new cache key, or NULL, without an exception, for text
+ * that is not cached.
+ */
+static PyObject*
+get_cache_key(PyObject* self, PyObject* text, int aa,
+              PyObject* fg_rgba_obj, PyObject* bg_rgba_obj)
+{
+    Uint8 rgba[] = {0, 0, 0, 0};
+    int fg, bg = -1;
+
+    if (Py_TYPE(text) != &PyUnicode_Type && Py_TYPE(text) != &Bytes_Type) {
+        return NULL;
+    }
+    if (!RGBAFromColorObj(fg_rgba_obj, rgba)) {
+        return NULL;
+    }
+    fg = (rgba[0] << 16) | (rgba[1] << 8) | rgba[2];
+    if (bg_rgba_obj != NULL) {
+        if (!RGBAFromColorObj(bg_rgba_obj, rgba)) {
+            return NULL;
+        }
+        bg = (rgba[0] << 16) | (rgba[1] << 8) | rgba[2];
+    }
+    return Py_BuildValue("(Oiiii)", text, aa ? 1 : 0, fg, bg,
+                         TTF_GetFontStyle(PyFont_AsFont(self)));
+}
+
+static size_t
+get_cached_size(PyObject* entry)
+{
+    SDL_Surface* surf = PySurface_AsSurface(PyList_GET_ITEM(entry, 0));
+
+    return surf ? (size_t)surf->pitch * surf->h : 0;
+}
+
+/* Points the link in slot (1 older, 2 newer) of the entry for key at
+ * value. A key of None stands for the font's end of the list instead.
+ */
+static void
+set_cache_link(PyFontObject* self, PyObject* key, int slot, PyObject* value)
+{
+    PyObject** end;
+
+    if (key == Py_None) {
+        end = slot == 2 ? &self->cache_oldest : &self->cache_newest;
+        Py_XDECREF(*end);
+        *end = value == Py_None ? NULL : value;
+        Py_XINCREF(*end);
+    }
+    else {
+        Py_INCREF(value);
+        PyList_SetItem(PyDict_GetItem(self->render_cache, key), slot, value);
+    }
+}
+
+static void
+unlink_cache_entry(PyFontObject* self, PyObject* entry)
+{
+    PyObject* older = PyList_GET_ITEM(entry, 1);
+    PyObject* newer = PyList_GET_ITEM(entry, 2);
+
+    set_cache_link(self, older, 2, newer);
+    set_cache_link(self, newer, 1, older);
+}
+
+/* Makes the entry for key the newest, it must be unlinked. */
+static void
+push_cache_entry(PyFontObject* self, PyObject* key, PyObject* entry)
+{
+    PyObject* newest = self->cache_newest ? self->cache_newest : Py_None;
+
+    Py_INCREF(newest);
+    PyList_SetItem(entry, 1, newest);
+    Py_INCREF(Py_None);
+    PyList_SetItem(entry, 2, Py_None);
+    set_cache_link(self, newest, 2, key);
+    set_cache_link(self, Py_None, 1, key);
+}
+
+static int
+evict_oldest(PyFontObject* self)
+{
+    PyObject *key = self->cache_oldest, *entry;
+    int result;
+
+    if (key == NULL) {
+        return 0;
+    }
+    Py_INCREF(key);
+    entry = PyDict_GetItem(self->render_cache, key);
+    self->cache_bytes -= get_cached_size(entry);
+    ++self->cache_evictions;
+    unlink_cache_entry(self, entry);
+    result = PyDict_DelItem(self->render_cache, key);
+    Py_DECREF(key);
+    return result;
+}
+
+static void
+clear_cache(PyFontObject* self)
+{
+    PyDict_Clear(self->render_cache);
+    Py_CLEAR(self->cache_oldest);
+    Py_CLEAR(self->cache_newest);
+    self->cache_bytes = 0;
+}
+
+static int
+trim_cache(PyFontObject* self, size_t budget)
+{
+    while (self->cache_bytes > budget && PyDict_Size(self->render_cache)) {
+        if (evict_oldest(self)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static PyObject*
+render_cached(PyObject* self, PyObject* text, int aa,
+              PyObject* fg_rgba_obj, PyObject* bg_rgba_obj)
+{
+    PyFontObject* fontobj = (PyFontObject*)self;
+    PyObject *key, *entry, *surfobj;
+    size_t size;
+
+    if (!fontobj->cache_budget) {
+        return render_text(self, text, aa, fg_rgba_obj, bg_rgba_obj);
+    }
+    key = get_cache_key(self, text, aa, fg_rgba_obj, bg_rgba_obj);
+    if (key == NULL) {
+        if (PyErr_Occurred()) {
+            return NULL;
+        }
+        return render_text(self, text, aa, fg_rgba_obj, bg_rgba_obj);
+    }
+
+    entry = PyDict_GetItem(fontobj->render_cache, key);
+    if (entry != NULL) {
+        unlink_cache_entry(fontobj, entry);
+        push_cache_entry(fontobj, key, entry);
+        Py_DECREF(key);
+        ++fontobj->cache_hits;
+        surfobj = PyList_GET_ITEM(entry, 0);
+        Py_INCREF(surfobj);
+        return surfobj;
+    }
+
+    ++fontobj->cache_misses;
+    surfobj = render_text(self, text, aa, fg_rgba_obj, bg_rgba_obj);
+    if (surfobj == NULL) {
+        Py_DECREF(key);
+        return NULL;
+    }
+    entry = Py_BuildValue("[OOO]", surfobj, Py_None, Py_None);
+    if (entry == NULL) {
+        goto error;
+    }
+    size = get_cached_size(entry);
+    if (size <= fontobj->cache_budget) {
+        if (trim_cache(fontobj, fontobj->cache_budget - size) ||
+            PyDict_SetItem(fontobj->render_cache, key, entry)) {
+            goto error;
+        }
+        push_cache_entry(fontobj, key, entry);
+        fontobj->cache_bytes += size;
+    }
+    Py_DECREF(entry);
+    Py_DECREF(key);
+    return surfobj;
+
+error:
+    Py_XDECREF(entry);
+    Py_DECREF(key);
+    Py_DECREF(surfobj);
+    return NULL;
+}
+
+static PyObject*
+font_render(PyObject* self, PyObject* args)
+{
+    int aa;
+    PyObject* text;
+    PyObject* fg_rgba_obj, *bg_rgba_obj = NULL;
+
+    if (!PyArg_ParseTuple(args, "OiO|O", &text, &aa, &fg_rgba_obj,
+                          &bg_rgba_obj)) {
+        return NULL;
+    }
+    return render_cached(self, text, aa, fg_rgba_obj, bg_rgba_obj);
+}
+
+static PyObject*
+font_render_to(PyObject* self, PyObject* args)
+{
+    int aa, x, y, result;
+    PyObject* surfobj, *dest, *text, *textobj;
+    PyObject* fg_rgba_obj, *bg_rgba_obj = NULL;
+    GAME_Rect *rect, temp;
+    SDL_Surface* surf;
+    SDL_Rect dest_rect, src_rect;
+
+    if (!PyArg_ParseTuple(args, "O!OOiO|O", &PySurface_Type, &surfobj,
+                          &dest, &text, &aa, &fg_rgba_obj, &bg_rgba_obj)) {
+        return NULL;
+    }
+    if (!PySurface_AsSurface(surfobj)) {
+        return RAISE(PyExc_SDLError, "display Surface quit");
+    }
+    if ((rect = GameRect_FromObject(dest, &temp))) {
+        x = rect->x;
+        y = rect->y;
+    }
+    else if (!TwoIntsFromObj(dest, &x, &y)) {
+        return RAISE(PyExc_TypeError, "invalid destination position");
+    }
+
+    textobj = render_cached(self, text, aa, fg_rgba_obj, bg_rgba_obj);
+    if (textobj == NULL) {
+        return NULL;
+    }
+    surf = PySurface_AsSurface(textobj);
+    src_rect.x = 0;
+    src_rect.y = 0;
+    src_rect.w = (Uint16)surf->w;
+    src_rect.h = (Uint16)surf->h;
+    dest_rect.x = (Sint16)x;
+    dest_rect.y = (Sint16)y;
+    dest_rect.w = src_rect.w;
+    dest_rect.h = src_rect.h;
+    result = PySurface_Blit(surfobj, textobj, &dest_rect, &src_rect, 0);
+    Py_DECREF(textobj);
+    if (result != 0) {
+        return NULL;
+    }
+    return PyRect_New(&dest_rect);
+}
+
+static PyObject*
+font_set_cache_budget(PyObject* self, PyObject* args)
+{
+    PyFontObject* fontobj = (PyFontObject*)self;
+    Py_ssize_t budget;
+
+    if (!PyArg_ParseTuple(args, "n", &budget)) {
+        return NULL;
+    }
+    if (budget < 0) {
+        return RAISE(PyExc_ValueError, "the cache budget must be positive");
+    }
+    if (budget && fontobj->render_cache == NULL) {
+        fontobj->render_cache = PyDict_New();
+        if (fontobj->render_cache == NULL) {
+            return NULL;
+        }
+    }
+    fontobj->cache_budget = (size_t)budget;
+    if (fontobj->render_cache != NULL &&
+        trim_cache(fontobj, fontobj->cache_budget)) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+font_get_cache_budget(PyObject* self)
+{
+    return PyLong_FromSize_t(((PyFontObject*)self)->cache_budget);
+}
+
+static PyObject*
+font_get_cache_stats(PyObject* self)
+{
+    PyFontObject* fontobj = (PyFontObject*)self;
+
+    return Py_BuildValue("(kkkn)", fontobj->cache_hits,
+                         fontobj->cache_misses, fontobj->cache_evictions,
+                         (Py_ssize_t)fontobj->cache_bytes);
+}
+
 static PyObject*
 font_size(PyObject* self, PyObject* args)
 {
@@ -583,8 +867,16 @@ static PyMethodDef font_methods[] =
 
     { "metrics", font_metrics, METH_VARARGS, DOC_FONTMETRICS },
     { "render", font_render, METH_VARARGS, DOC_FONTRENDER },
+    { "render_to", font_render_to, METH_VARARGS, DOC_FONTRENDERTO },
     { "size", font_size, METH_VARARGS, DOC_FONTSIZE },
 
+    { "set_cache_budget", font_set_cache_budget, METH_VARARGS,
+      DOC_FONTSETCACHEBUDGET },
+    { "get_cache_budget", (PyCFunction) font_get_cache_budget, METH_NOARGS,
+      DOC_FONTGETCACHEBUDGET },
+    { "get_cache_stats", (PyCFunction) font_get_cache_stats, METH_NOARGS,
+      DOC_FONTGETCACHESTATS },
+
     { NULL, NULL, 0, NULL }
 };
 
@@ -596,6 +888,9 @@ font_dealloc (PyFontObject* self)
 
     if (font && font_initialized)
         TTF_CloseFont (font);
+    Py_XDECREF (self->render_cache);
+    Py_XDECREF (self->cache_oldest);
+    Py_XDECREF (self->cache_newest);
 
     if (self->weakreflist)
         PyObject_ClearWeakRefs ((PyObject*) self);
@@ -611,6 +906,9 @@ font_init(PyFontObject *self, PyObject *args, PyObject *kwds)
     PyObject *oencoded;
 
     self->font = NULL;
+    if (self->render_cache != NULL) {
+        clear_cache(self);
+    }
     if (!PyArg_ParseTuple(args, "Oi", &obj, &fontsize)) {
         return -1;
     }
@@ -843,6 +1141,10 @@ MODINIT_DEFINE (font)
     if (PyErr_Occurred ()) {
         MODINIT_ERROR;
     }
+    import_pygame_rect ();
+    if (PyErr_Occurred ()) {
+        MODINIT_ERROR;
+    }
     import_pygame_rwobject ();
     if (PyErr_Occurred ()) {
         MODINIT_ERROR;
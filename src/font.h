@@ -40,6 +40,14 @@ typedef struct {
   PyObject_HEAD
   TTF_Font* font;
   PyObject* weakreflist;
+  PyObject* render_cache;     /* key -> [surface, older, newer], or NULL */
+  PyObject* cache_oldest;     /* key of the least recently used entry */
+  PyObject* cache_newest;
+  size_t cache_budget;        /* bytes of cached pixels; 0 is no cache */
+  size_t cache_bytes;
+  unsigned long cache_hits;
+  unsigned long cache_misses;
+  unsigned long cache_evictions;
 } PyFontObject;
 #define PyFont_AsFont(x) (((PyFontObject*)x)->font)
 
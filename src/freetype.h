@@ -108,6 +108,8 @@ typedef struct {
     Angle_t rotation;
     FT_Matrix transform;
     FT_Byte fgcolor[4];
+    PyObject *render_cache;  /* dict of Font.render results, or 0 */
+    SDL_mutex *lock;  /* guards _internals while rendering without GIL */
 
     struct freetypeinstance_ *freetype;  /* Personal reference */
     struct fontinternals_ *_internals;
@@ -40,16 +40,47 @@ typedef union cachenodekey_ {
 
 typedef struct cachenode_ {
     FontGlyph glyph;
-    struct cachenode_ *next;
+    struct cachenode_ *next;    /* bucket chain, or the free node list */
+    struct cachenode_ *newer;   /* most recently used list */
+    struct cachenode_ *older;
     NodeKey key;
     FT_UInt32 hash;
+    int cell_class;             /* bitmap cell size, or one of below */
+    size_t bytes;               /* charged against the cache budget */
 } CacheNode;
 
+#define CELL_NONE      -1       /* empty bitmap */
+#define CELL_SEPARATE  -2       /* bitmap too large for a cell */
+
+/* Nodes are allocated this many at a time */
+#define SLAB_NODES 64
+
+typedef struct cacheslab_ {
+    struct cacheslab_ *next;
+    CacheNode nodes[SLAB_NODES];
+} CacheSlab;
+
+/* Bitmap cells step by about half a power of two, so at most a third
+ * of a cell is unused, and all of them divide the page size evenly.
+ */
+static const size_t cell_sizes[PGFT_CACHE_CELL_CLASSES] = {
+    32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096
+};
+#define CACHE_PAGE_SIZE 24576
+
+typedef struct cachepage_ {
+    struct cachepage_ *next;
+} CachePage;
+
 static FT_UInt32 get_hash(const NodeKey *);
 static CacheNode *allocate_node(FontCache *,
                                 const FontRenderMode *,
                                 GlyphIndex_t, void *);
 static void free_node(FontCache *, CacheNode *);
+static CacheNode *take_node(FontCache *);
+static int store_bitmap(FontCache *, CacheNode *);
+static void release_bitmap(FontCache *, CacheNode *);
+static void grow_buckets(FontCache *);
 static void set_node_key(NodeKey *, GlyphIndex_t, const FontRenderMode *);
 static int equal_node_keys(const NodeKey *, const NodeKey *);
 
@@ -144,20 +175,14 @@ _PGFT_Cache_Init(FreeTypeInstance *ft, FontCache *cache)
 
     cache_size = cache_size + 1;
 
-    cache->nodes = _PGFT_malloc((size_t)cache_size * sizeof(FontGlyph *));
+    memset(cache, 0, sizeof(*cache));
+    cache->nodes = _PGFT_malloc((size_t)cache_size * sizeof(CacheNode *));
     if (!cache->nodes)
         return -1;
     for (i=0; i < cache_size; ++i)
         cache->nodes[i] = 0;
-    cache->depths = _PGFT_malloc((size_t)cache_size);
-    if (!cache->depths) {
-        _PGFT_free(cache->nodes);
-        cache->nodes = 0;
-        return -1;
-    }
-    memset(cache->depths, 0, cache_size);
-    cache->free_nodes = 0;
     cache->size_mask = (FT_UInt32)(cache_size - 1);
+    cache->freetype = ft;
 
 #ifdef PGFT_DEBUG_CACHE
     cache->_debug_count = 0;
@@ -173,7 +198,9 @@ void
 _PGFT_Cache_Destroy(FontCache *cache)
 {
     FT_UInt i;
-    CacheNode *node, *next;
+    CacheNode *node;
+    CacheSlab *slab;
+    CachePage *page;
 
     if (!cache) {
         return;
@@ -185,48 +212,51 @@ _PGFT_Cache_Destroy(FontCache *cache)
 
     if (cache->nodes) {
         for (i = 0; i <= cache->size_mask; ++i) {
-            node = cache->nodes[i];
-
-            while (node) {
-                next = node->next;
-                free_node(cache, node);
-                node = next;
+            for (node = cache->nodes[i]; node; node = node->next) {
+                if (node->cell_class == CELL_SEPARATE) {
+                    _PGFT_free(node->glyph.bitmap.buffer);
+                }
             }
         }
         _PGFT_free(cache->nodes);
         cache->nodes = 0;
     }
-    _PGFT_free(cache->depths);
-    cache->depths = 0;
+    while (cache->slabs) {
+        slab = cache->slabs;
+        cache->slabs = slab->next;
+        _PGFT_free(slab);
+    }
+    while (cache->pages) {
+        page = cache->pages;
+        cache->pages = page->next;
+        _PGFT_free(page);
+    }
+    if (cache->freetype) {
+        cache->freetype->cache_stats.bytes -= cache->bytes;
+    }
+    cache->free_nodes = 0;
+    cache->newest = cache->oldest = 0;
+    memset(cache->free_cells, 0, sizeof(cache->free_cells));
+    cache->count = 0;
+    cache->bytes = 0;
 }
 
 void
 _PGFT_Cache_Cleanup(FontCache *cache)
 {
-    const FT_Byte MAX_BUCKET_DEPTH = 2;
-    CacheNode *node, *prev;
-    FT_UInt32 i;
-
-    for (i = 0; i <= cache->size_mask; ++i) {
-        while (cache->depths[i] > MAX_BUCKET_DEPTH) {
-            node = cache->nodes[i];
-            prev = 0;
+    size_t budget = cache->freetype->cache_budget;
+    CacheNode *node;
 
-            for (;;) {
-                if (!node->next) {
+    /* Glyphs are only evicted here, between layouts, so the glyphs of
+     * the layout being built stay valid even past the budget.
+     */
+    while (cache->bytes > budget && cache->oldest) {
+        node = cache->oldest;
+        cache->freetype->cache_stats.evictions++;
 #ifdef PGFT_DEBUG_CACHE
-                    cache->_debug_delete_count++;
+        cache->_debug_delete_count++;
 #endif
-
-                    prev->next = 0;
-                    free_node(cache, node);
-                    break;
-                }
-
-                prev = node;
-                node = node->next;
-            }
-        }
+        free_node(cache, node);
     }
 }
 
@@ -252,13 +282,29 @@ _PGFT_Cache_FindGlyph(GlyphIndex_t id, const FontRenderMode *render,
 #endif
 
     while (node) {
-        if (equal_node_keys(&node->key, &key)) {
+        if (node->hash == hash && equal_node_keys(&node->key, &key)) {
             if (prev) {
                 prev->next = node->next;
                 node->next = nodes[bucket];
                 nodes[bucket] = node;
             }
 
+            /* move to the front of the most recently used list */
+            if (node->newer) {
+                node->newer->older = node->older;
+                if (node->older) {
+                    node->older->newer = node->newer;
+                }
+                else {
+                    cache->oldest = node->newer;
+                }
+                node->older = cache->newest;
+                node->newer = 0;
+                cache->newest->newer = node;
+                cache->newest = node;
+            }
+
+            cache->freetype->cache_stats.hits++;
 #ifdef PGFT_DEBUG_CACHE
             cache->_debug_hit++;
 #endif
@@ -272,6 +318,7 @@ _PGFT_Cache_FindGlyph(GlyphIndex_t id, const FontRenderMode *render,
 
     node = allocate_node(cache, render, id, internal);
 
+    cache->freetype->cache_stats.misses++;
 #ifdef PGFT_DEBUG_CACHE
     cache->_debug_miss++;
 #endif
@@ -279,9 +326,14 @@ _PGFT_Cache_FindGlyph(GlyphIndex_t id, const FontRenderMode *render,
     return node ? &node->glyph : 0;
 }
 
+/* Unlinks a node from its bucket and the most recently used list,
+ * and returns it and its bitmap cell to the free lists.
+ */
 static void
 free_node(FontCache *cache, CacheNode *node)
 {
+    CacheNode **link;
+
     if (!node) {
         return;
     }
@@ -290,27 +342,53 @@ free_node(FontCache *cache, CacheNode *node)
     cache->_debug_count--;
 #endif
 
-    cache->depths[node->hash & cache->size_mask]--;
+    link = &cache->nodes[node->hash & cache->size_mask];
+    while (*link != node) {
+        link = &(*link)->next;
+    }
+    *link = node->next;
+
+    if (node->newer) {
+        node->newer->older = node->older;
+    }
+    else {
+        cache->newest = node->older;
+    }
+    if (node->older) {
+        node->older->newer = node->newer;
+    }
+    else {
+        cache->oldest = node->newer;
+    }
+
+    cache->count--;
+    cache->bytes -= node->bytes;
+    cache->freetype->cache_stats.bytes -= node->bytes;
+    release_bitmap(cache, node);
 
-    FT_Done_Glyph((FT_Glyph)(node->glyph.image));
-    _PGFT_free(node);
+    node->next = cache->free_nodes;
+    cache->free_nodes = node;
 }
 
 static CacheNode *
 allocate_node(FontCache *cache, const FontRenderMode *render,
               GlyphIndex_t id, void *internal)
 {
-    CacheNode *node = _PGFT_malloc(sizeof(CacheNode));
+    CacheNode *node = take_node(cache);
+    FT_Glyph image = 0;
     FT_UInt32 bucket;
 
     if (!node) {
         return 0;
     }
-    memset(node, 0, sizeof(CacheNode));
 
-    if (_PGFT_LoadGlyph(&node->glyph, id, render, internal)) {
+    if (_PGFT_LoadGlyph(&node->glyph, &image, id, render, internal)) {
+        goto cleanup;
+    }
+    if (store_bitmap(cache, node)) {
         goto cleanup;
     }
+    FT_Done_Glyph(image);
 
     set_node_key(&node->key, id, render);
     node->hash = get_hash(&node->key);
@@ -318,7 +396,22 @@ allocate_node(FontCache *cache, const FontRenderMode *render,
     node->next = cache->nodes[bucket];
     cache->nodes[bucket] = node;
 
-    cache->depths[bucket]++;
+    node->older = cache->newest;
+    node->newer = 0;
+    if (cache->newest) {
+        cache->newest->newer = node;
+    }
+    else {
+        cache->oldest = node;
+    }
+    cache->newest = node;
+
+    cache->count++;
+    cache->bytes += node->bytes;
+    cache->freetype->cache_stats.bytes += node->bytes;
+    if (cache->count > 2 * (cache->size_mask + 1)) {
+        grow_buckets(cache);
+    }
 
 #ifdef PGFT_DEBUG_CACHE
     cache->_debug_count++;
@@ -330,6 +423,139 @@ allocate_node(FontCache *cache, const FontRenderMode *render,
      * Cleanup on error
      */
 cleanup:
-    _PGFT_free(node);
+    if (image) {
+        FT_Done_Glyph(image);
+    }
+    node->next = cache->free_nodes;
+    cache->free_nodes = node;
+    return 0;
+}
+
+/* Returns a cleared node from the free list, adding a slab when empty.
+ */
+static CacheNode *
+take_node(FontCache *cache)
+{
+    CacheSlab *slab;
+    CacheNode *node;
+    int i;
+
+    if (!cache->free_nodes) {
+        slab = _PGFT_malloc(sizeof(CacheSlab));
+        if (!slab) {
+            return 0;
+        }
+        slab->next = cache->slabs;
+        cache->slabs = slab;
+        for (i = SLAB_NODES - 1; i >= 0; --i) {
+            slab->nodes[i].next = cache->free_nodes;
+            cache->free_nodes = &slab->nodes[i];
+        }
+    }
+
+    node = cache->free_nodes;
+    cache->free_nodes = node->next;
+    memset(node, 0, sizeof(CacheNode));
+    return node;
+}
+
+/* Copies the node's bitmap, which FreeType owns, into a cell of the
+ * smallest class that fits, and charges the node for it.
+ */
+static int
+store_bitmap(FontCache *cache, CacheNode *node)
+{
+    FT_Bitmap *bitmap = &node->glyph.bitmap;
+    size_t size = (size_t)bitmap->rows * (size_t)abs(bitmap->pitch);
+    CachePage *page;
+    FT_Byte *cell;
+    int c;
+    size_t i;
+
+    if (size == 0) {
+        node->cell_class = CELL_NONE;
+        node->bytes = sizeof(CacheNode);
+        bitmap->buffer = 0;
+        return 0;
+    }
+
+    c = 0;
+    while (c < PGFT_CACHE_CELL_CLASSES && cell_sizes[c] < size) {
+        ++c;
+    }
+
+    if (c == PGFT_CACHE_CELL_CLASSES) {
+        cell = _PGFT_malloc(size);
+        if (!cell) {
+            return -1;
+        }
+        node->cell_class = CELL_SEPARATE;
+        node->bytes = sizeof(CacheNode) + size;
+    }
+    else {
+        if (!cache->free_cells[c]) {
+            page = _PGFT_malloc(sizeof(CachePage) + CACHE_PAGE_SIZE);
+            if (!page) {
+                return -1;
+            }
+            page->next = cache->pages;
+            cache->pages = page;
+            cell = (FT_Byte *)(page + 1);
+            for (i = CACHE_PAGE_SIZE / cell_sizes[c]; i; --i) {
+                *(void **)cell = cache->free_cells[c];
+                cache->free_cells[c] = cell;
+                cell += cell_sizes[c];
+            }
+        }
+        cell = cache->free_cells[c];
+        cache->free_cells[c] = *(void **)cell;
+        node->cell_class = c;
+        node->bytes = sizeof(CacheNode) + cell_sizes[c];
+    }
+
+    memcpy(cell, bitmap->buffer, size);
+    bitmap->buffer = cell;
     return 0;
 }
+
+static void
+release_bitmap(FontCache *cache, CacheNode *node)
+{
+    void *cell = node->glyph.bitmap.buffer;
+
+    if (node->cell_class == CELL_SEPARATE) {
+        _PGFT_free(cell);
+    }
+    else if (node->cell_class >= 0) {
+        *(void **)cell = cache->free_cells[node->cell_class];
+        cache->free_cells[node->cell_class] = cell;
+    }
+    node->glyph.bitmap.buffer = 0;
+}
+
+/* Doubles the number of buckets, keeping chains short as the cache
+ * fills up to its budget.  On failure the cache keeps its old buckets.
+ */
+static void
+grow_buckets(FontCache *cache)
+{
+    FT_UInt32 size = (cache->size_mask + 1) * 2;
+    CacheNode **nodes = _PGFT_malloc((size_t)size * sizeof(CacheNode *));
+    CacheNode *node, *next;
+    FT_UInt32 i;
+
+    if (!nodes) {
+        return;
+    }
+    memset(nodes, 0, (size_t)size * sizeof(CacheNode *));
+    for (i = 0; i <= cache->size_mask; ++i) {
+        for (node = cache->nodes[i]; node; node = next) {
+            next = node->next;
+            node->next = nodes[node->hash & (size - 1)];
+            nodes[node->hash & (size - 1)] = node;
+        }
+    }
+    _PGFT_free(cache->nodes);
+    cache->nodes = nodes;
+    cache->size_mask = size - 1;
+}
@@ -68,6 +68,13 @@ typedef enum {
     UPDATE_GLYPHS
 } UpdateLevel_t;
 
+/* Errors from the part of a layout built without the GIL, raised as
+ * Python exceptions once the GIL is taken back.
+ */
+#define LAYOUT_ERR_MEMORY -1
+#define LAYOUT_ERR_SHAPE -2
+#define LAYOUT_ERR_GLYPH -3
+
 /** render modes requiring glyph reloading and repositioning */
 static const FT_UInt16 GLYPH_RENDER_FLAGS = (FT_RFLAG_ANTIALIAS |
                                              FT_RFLAG_AUTOHINT |
@@ -91,11 +98,13 @@ static void fill_context(TextContext *,
                          const PgFontObject *,
                          const FontRenderMode *,
                          const FT_Face);
+static int build_layout(Layout *, FontInternals *, const FontRenderMode *,
+                        TextContext *, FontCache *, const PGFT_String *,
+                        GlyphIndex_t *);
 static int size_text(Layout *,
-                     FreeTypeInstance *,
                      TextContext *,
                      const PGFT_String *);
-static int load_glyphs(Layout *, TextContext *, FontCache *);
+static int load_glyphs(Layout *, TextContext *, FontCache *, GlyphIndex_t *);
 static void position_glyphs(Layout *);
 static void fill_text_bounding_box(Layout *,
                                    FT_Vector,
@@ -105,17 +114,36 @@ static UpdateLevel_t mode_compare(const FontRenderMode *,
 static int same_sizes(const Scale_t *, const Scale_t * );
 static int same_transforms(const FT_Matrix *, const FT_Matrix *);
 static void copy_mode(FontRenderMode *, const FontRenderMode *);
+static int same_layout_modes(const FontRenderMode *, const FontRenderMode *);
+static FT_UInt32 get_text_hash(const PGFT_String *);
+static LayoutEntry *find_layout(FontInternals *, const FontRenderMode *,
+                                const PGFT_String *, FT_UInt32);
+static int restore_layout(Layout *, const LayoutEntry *,
+                          const FontRenderMode *);
+static void store_layout(FontInternals *, const Layout *,
+                         const PGFT_String *, FT_UInt32);
+static void free_layout_entry(LayoutEntry *);
 
 
 int
 _PGFT_LayoutInit(FreeTypeInstance *ft, PgFontObject *fontobj)
 {
-    Layout *ftext = &fontobj->_internals->active_text;
-    FontCache *cache = &fontobj->_internals->glyph_cache;
+    FontInternals *internals = fontobj->_internals;
+    Layout *ftext = &internals->active_text;
+    FontCache *cache = &internals->glyph_cache;
+    int i;
 
     ftext->buffer_size = 0;
     ftext->glyphs = 0;
 
+    for (i = 0; i < PGFT_LAYOUT_CACHE_SIZE; ++i) {
+        internals->layouts[i].text = 0;
+        internals->layouts[i].layout.buffer_size = 0;
+        internals->layouts[i].layout.glyphs = 0;
+        internals->layouts[i].stamp = 0;
+    }
+    internals->layout_clock = 0;
+
     if (_PGFT_Cache_Init(ft, cache)) {
         PyErr_NoMemory();
         return -1;
@@ -127,13 +155,18 @@ _PGFT_LayoutInit(FreeTypeInstance *ft, PgFontObject *fontobj)
 void
 _PGFT_LayoutFree(PgFontObject *fontobj)
 {
-    Layout *ftext = &(fontobj->_internals->active_text);
-    FontCache *cache = &fontobj->_internals->glyph_cache;
+    FontInternals *internals = fontobj->_internals;
+    Layout *ftext = &internals->active_text;
+    FontCache *cache = &internals->glyph_cache;
+    int i;
 
     if (ftext->buffer_size > 0) {
         _PGFT_free(ftext->glyphs);
         ftext->glyphs = 0;
     }
+    for (i = 0; i < PGFT_LAYOUT_CACHE_SIZE; ++i) {
+        free_layout_entry(&internals->layouts[i]);
+    }
     _PGFT_Cache_Destroy(cache);
 }
 
@@ -141,52 +174,113 @@ Layout *
 _PGFT_LoadLayout(FreeTypeInstance *ft, PgFontObject *fontobj,
                  const FontRenderMode *mode, PGFT_String *text)
 {
-    Layout *ftext = &fontobj->_internals->active_text;
-    FontCache *cache = &fontobj->_internals->glyph_cache;
+    FontInternals *internals = fontobj->_internals;
+    Layout *ftext = &internals->active_text;
+    FontCache *cache = &internals->glyph_cache;
     UpdateLevel_t level = (text ?
                            UPDATE_GLYPHS : mode_compare(&ftext->mode, mode));
     FT_Face font = 0;
     TextContext context;
+    GlyphIndex_t bad_id = 0;
+    int rcode = 0;
 
-    if (level != UPDATE_NONE) {
-        copy_mode(&ftext->mode, mode);
-        font = _PGFT_GetFontSized(ft, fontobj, mode->face_size);
-        if (!font) {
-            PyErr_SetString(PyExc_SDLError, _PGFT_GetError(ft));
-            return 0;
-        }
+    if (level == UPDATE_NONE) {
+        return ftext;
     }
 
-    switch (level) {
+    /* The caller holds the font lock. The instance lock keeps the sized
+     * face current until the glyphs are loaded.
+     */
+    _PGFT_LockInstance(ft);
+    copy_mode(&ftext->mode, mode);
+    font = _PGFT_GetFontSized(ft, fontobj, mode->face_size);
+    if (!font) {
+        _PGFT_UnlockInstance(ft);
+        PyErr_SetString(PyExc_SDLError, _PGFT_GetError(ft));
+        return 0;
+    }
 
-    case UPDATE_GLYPHS:
-        _PGFT_Cache_Cleanup(cache);
+    if (level == UPDATE_GLYPHS) {
         fill_context(&context, ft, fontobj, mode, font);
-        if (text) {
-            if (size_text(ftext, ft, &context, text)) {
-                return 0;
-            }
-        }
-        if (load_glyphs(ftext, &context, cache)) {
-            return 0;
-        }
-        /* fall through */
-
-    case UPDATE_LAYOUT:
+        Py_BEGIN_ALLOW_THREADS;
+        rcode = build_layout(ftext, internals, mode, &context, cache, text,
+                             &bad_id);
+        _PGFT_UnlockInstance(ft);
+        Py_END_ALLOW_THREADS;
+    }
+    else {
         position_glyphs(ftext);
-        break;
+        _PGFT_UnlockInstance(ft);
+    }
+
+    switch (rcode) {
+
+    case LAYOUT_ERR_MEMORY:
+        PyErr_NoMemory();
+        return 0;
+
+    case LAYOUT_ERR_SHAPE:
+        PyErr_SetString(PyExc_SDLError, "Unable to lay out text");
+        return 0;
+
+    case LAYOUT_ERR_GLYPH:
+        PyErr_Format(PyExc_SDLError, "Unable to load glyph for id %lu",
+                     (unsigned long)bad_id);
+        return 0;
 
     default:
-        assert(level == UPDATE_NONE);
+        assert(rcode == 0);
         break;
     }
 
     return ftext;
 }
 
+/* Shapes text, if given, and loads and renders the glyphs. Runs without
+ * the GIL, so errors are returned as LAYOUT_ERR_* codes rather than
+ * raised. A failed glyph's id is left in *bad_id.
+ */
+static int
+build_layout(Layout *ftext, FontInternals *internals,
+             const FontRenderMode *mode, TextContext *context,
+             FontCache *cache, const PGFT_String *text, GlyphIndex_t *bad_id)
+{
+    LayoutEntry *entry;
+    FT_UInt32 hash = 0;
+    int rcode;
+
+    _PGFT_Cache_Cleanup(cache);
+    if (text) {
+        /* A string laid out recently in the same mode only needs
+         * its glyphs looked up again; shaping and positioning are
+         * taken from the layout cache.
+         */
+        hash = get_text_hash(text);
+        entry = find_layout(internals, mode, text, hash);
+        if (entry) {
+            if (restore_layout(ftext, entry, mode)) {
+                return LAYOUT_ERR_MEMORY;
+            }
+            return load_glyphs(ftext, context, cache, bad_id);
+        }
+        rcode = size_text(ftext, context, text);
+        if (rcode) {
+            return rcode;
+        }
+    }
+    rcode = load_glyphs(ftext, context, cache, bad_id);
+    if (rcode) {
+        return rcode;
+    }
+    position_glyphs(ftext);
+    if (text) {
+        store_layout(internals, ftext, text, hash);
+    }
+    return 0;
+}
+
 static int
 size_text(Layout *ftext,
-          FreeTypeInstance *ft,
           TextContext *context,
           const PGFT_String *text)
 {
@@ -202,6 +296,7 @@ size_text(Layout *ftext,
     raqm_t *rq;
     raqm_glyph_t *glyphs;
     size_t  nglyphs;
+    int rcode = LAYOUT_ERR_SHAPE;
 
     rq = raqm_create();
     if (!rq)
@@ -225,7 +320,8 @@ size_text(Layout *ftext,
         ftext->glyphs = (GlyphSlot *)
             _PGFT_malloc((size_t) nglyphs * sizeof(GlyphSlot));
         if (!ftext->glyphs) {
-            PyErr_NoMemory();
+            ftext->buffer_size = 0;
+            rcode = LAYOUT_ERR_MEMORY;
             goto cleanup;
         }
         ftext->buffer_size = nglyphs;
@@ -269,11 +365,12 @@ size_text(Layout *ftext,
      */
 cleanup:
     raqm_destroy(rq);
-    return -1;
+    return rcode;
 }
 
 static int
-load_glyphs(Layout *ftext, TextContext *context, FontCache *cache)
+load_glyphs(Layout *ftext, TextContext *context, FontCache *cache,
+            GlyphIndex_t *bad_id)
 {
     GlyphSlot *slot = ftext->glyphs;
     Py_ssize_t length = ftext->length;
@@ -284,9 +381,8 @@ load_glyphs(Layout *ftext, TextContext *context, FontCache *cache)
     for (i = 0; i < length; ++i) {
         glyph = _PGFT_Cache_FindGlyph(slot[i].id, mode, cache, context);
         if (!glyph) {
-            PyErr_Format(PyExc_SDLError, "Unable to load glyph for id %lu",
-                         (unsigned long)slot[i].id);
-            return -1;
+            *bad_id = slot[i].id;
+            return LAYOUT_ERR_GLYPH;
         }
         slot[i].glyph = glyph;
     }
@@ -371,7 +467,7 @@ position_glyphs(Layout *ftext)
      * a trailing space gets left out. This adds it in.
      */
     if (n_glyphs > 0 &&  /* conditional && */
-        (glyph_array + n_glyphs - 1)->glyph->image->bitmap.width == 0) {
+        (glyph_array + n_glyphs - 1)->glyph->bitmap.width == 0) {
         if (pen.x < min_x) {
             min_x = pen.x;
         }
@@ -457,6 +553,7 @@ fill_text_bounding_box(Layout *ftext,
     ftext->advance.y = pen.y;
 }
 
+/* Called with the instance lock held */
 int _PGFT_GetMetrics(FreeTypeInstance *ft, PgFontObject *fontobj,
                     const FontRenderMode *mode, FT_UInt *gindex,
                     long *minx, long *maxx, long *miny, long *maxy,
@@ -496,18 +593,68 @@ int _PGFT_GetMetrics(FreeTypeInstance *ft, PgFontObject *fontobj,
     }
 
     *gindex = id;
-    *minx = (long)glyph->image->left;
-    *maxx = (long)(glyph->image->left + glyph->image->bitmap.width);
-    *maxy = (long)glyph->image->top;
-    *miny = (long)(glyph->image->top - glyph->image->bitmap.rows);
+    *minx = (long)glyph->left;
+    *maxx = (long)(glyph->left + glyph->bitmap.width);
+    *maxy = (long)glyph->top;
+    *miny = (long)(glyph->top - glyph->bitmap.rows);
     *advance_x = (double)(h_advance.x / 64.0);
     *advance_y = (double)(h_advance.y / 64.0);
 
     return 0;
 }
 
+/* Loads the glyphs of the given characters into the glyph cache, ready
+ * for later layouts in the same mode. Returns the number of glyphs that
+ * were not already cached, or -1 with a Python exception set.
+ */
+long
+_PGFT_PreloadGlyphs(FreeTypeInstance *ft, PgFontObject *fontobj,
+                    const FontRenderMode *mode, const PGFT_char *chars,
+                    Py_ssize_t length)
+{
+    FontCache *cache = &fontobj->_internals->glyph_cache;
+    FT_UInt32 count = cache->count;
+    TextContext context;
+    FT_Face font;
+    GlyphIndex_t id = 0;
+    Py_ssize_t i;
+    int failed = 0;
+
+    _PGFT_LockInstance(ft);
+    font = _PGFT_GetFontSized(ft, fontobj, mode->face_size);
+    if (!font) {
+        _PGFT_UnlockInstance(ft);
+        PyErr_SetString(PyExc_SDLError, _PGFT_GetError(ft));
+        return -1;
+    }
+
+    fill_context(&context, ft, fontobj, mode, font);
+    Py_BEGIN_ALLOW_THREADS;
+    _PGFT_Cache_Cleanup(cache);
+    for (i = 0; i < length; ++i) {
+        id = FTC_CMapCache_Lookup(context.charmap, context.id,
+                                  -1, (FT_UInt32)chars[i]);
+        if (!_PGFT_Cache_FindGlyph(id, mode, cache, &context)) {
+            failed = 1;
+            break;
+        }
+    }
+    _PGFT_UnlockInstance(ft);
+    Py_END_ALLOW_THREADS;
+
+    if (failed) {
+        PyErr_Format(PyExc_SDLError, "Unable to load glyph for id %lu",
+                     (unsigned long)id);
+        return -1;
+    }
+    return (long)(cache->count - count);
+}
+
+/* Loads and renders a glyph, filling in glyph.  Its bitmap still
+ * belongs to *image_out, which the caller must release with FT_Done_Glyph.
+ */
 int
-_PGFT_LoadGlyph(FontGlyph *glyph, GlyphIndex_t id,
+_PGFT_LoadGlyph(FontGlyph *glyph, FT_Glyph *image_out, GlyphIndex_t id,
                 const FontRenderMode *mode, void *internal)
 {
     static FT_Vector delta = {0, 0};
@@ -601,11 +748,13 @@ _PGFT_LoadGlyph(FontGlyph *glyph, GlyphIndex_t id,
     ft_metrics = &context->font->glyph->metrics;
 
 
-    glyph->image = (FT_BitmapGlyph)image;
-    glyph->width = INT_TO_FX6(glyph->image->bitmap.width);
-    glyph->height = INT_TO_FX6(glyph->image->bitmap.rows);
-    h_bearing_rotated.x = INT_TO_FX6(glyph->image->left);
-    h_bearing_rotated.y = INT_TO_FX6(glyph->image->top);
+    glyph->bitmap = ((FT_BitmapGlyph)image)->bitmap;
+    glyph->left = ((FT_BitmapGlyph)image)->left;
+    glyph->top = ((FT_BitmapGlyph)image)->top;
+    glyph->width = INT_TO_FX6(glyph->bitmap.width);
+    glyph->height = INT_TO_FX6(glyph->bitmap.rows);
+    h_bearing_rotated.x = INT_TO_FX6(glyph->left);
+    h_bearing_rotated.y = INT_TO_FX6(glyph->top);
     fill_metrics(&glyph->h_metrics,
                  ft_metrics->horiBearingX,
                  ft_metrics->horiBearingY,
@@ -635,6 +784,7 @@ _PGFT_LoadGlyph(FontGlyph *glyph, GlyphIndex_t id,
                  ft_metrics->vertBearingY,
                  &v_bearing_rotated);
 
+    *image_out = image;
     return 0;
 
     /*
@@ -766,3 +916,140 @@ copy_mode(FontRenderMode *d, const FontRenderMode *s)
 {
     memcpy(d, s, sizeof(FontRenderMode));
 }
+
+static int
+same_layout_modes(const FontRenderMode *a, const FontRenderMode *b)
+{
+    return (same_sizes(&a->face_size, &b->face_size) &&
+            a->rotation_angle == b->rotation_angle &&
+            a->render_flags == b->render_flags &&
+            a->style == b->style &&
+            a->strength == b->strength &&
+            (!(a->render_flags & FT_RFLAG_TRANSFORM) ||
+             same_transforms(&a->transform, &b->transform)));
+}
+
+static FT_UInt32
+get_text_hash(const PGFT_String *text)
+{
+    /* FNV-1a over the characters */
+    const PGFT_char *chars = PGFT_String_GET_DATA(text);
+    Py_ssize_t length = PGFT_String_GET_LENGTH(text);
+    FT_UInt32 hash = 2166136261U;
+    Py_ssize_t i;
+
+    for (i = 0; i < length; ++i) {
+        hash = (hash ^ chars[i]) * 16777619U;
+    }
+    return hash;
+}
+
+static LayoutEntry *
+find_layout(FontInternals *internals, const FontRenderMode *mode,
+            const PGFT_String *text, FT_UInt32 hash)
+{
+    Py_ssize_t length = PGFT_String_GET_LENGTH(text);
+    LayoutEntry *entry;
+    int i;
+
+    for (i = 0; i < PGFT_LAYOUT_CACHE_SIZE; ++i) {
+        entry = &internals->layouts[i];
+        if (entry->stamp != 0 &&
+            entry->hash == hash &&
+            entry->text_length == length &&
+            same_layout_modes(&entry->layout.mode, mode) &&
+            memcmp(entry->text, PGFT_String_GET_DATA(text),
+                   (size_t)length * sizeof(PGFT_char)) == 0) {
+            entry->stamp = ++internals->layout_clock;
+            return entry;
+        }
+    }
+    return 0;
+}
+
+static int
+restore_layout(Layout *ftext, const LayoutEntry *entry,
+               const FontRenderMode *mode)
+{
+    const Layout *saved = &entry->layout;
+    GlyphSlot *glyphs = ftext->glyphs;
+    int buffer_size = ftext->buffer_size;
+
+    if (saved->length > buffer_size) {
+        _PGFT_free(glyphs);
+        glyphs = (GlyphSlot *)
+            _PGFT_malloc((size_t)saved->length * sizeof(GlyphSlot));
+        if (!glyphs) {
+            ftext->glyphs = 0;
+            ftext->buffer_size = 0;
+            ftext->length = 0;
+            return -1;
+        }
+        buffer_size = saved->length;
+    }
+    *ftext = *saved;
+    ftext->glyphs = glyphs;
+    ftext->buffer_size = buffer_size;
+    copy_mode(&ftext->mode, mode);
+    if (saved->length > 0) {
+        memcpy(glyphs, saved->glyphs,
+               (size_t)saved->length * sizeof(GlyphSlot));
+    }
+    return 0;
+}
+
+static void
+store_layout(FontInternals *internals, const Layout *ftext,
+             const PGFT_String *text, FT_UInt32 hash)
+{
+    Py_ssize_t length = PGFT_String_GET_LENGTH(text);
+    LayoutEntry *entry = &internals->layouts[0];
+    PGFT_char *chars;
+    GlyphSlot *glyphs;
+    int i;
+
+    /* Replace the least recently used entry */
+    for (i = 1; i < PGFT_LAYOUT_CACHE_SIZE; ++i) {
+        if (internals->layouts[i].stamp < entry->stamp) {
+            entry = &internals->layouts[i];
+        }
+    }
+    free_layout_entry(entry);
+
+    /* The cache is only an optimization, so a failed allocation
+     * just leaves the entry empty.
+     */
+    chars = (PGFT_char *)_PGFT_malloc((length ? (size_t)length : 1) *
+                                      sizeof(PGFT_char));
+    if (!chars) {
+        return;
+    }
+    glyphs = (GlyphSlot *)
+        _PGFT_malloc((ftext->length ? (size_t)ftext->length : 1) *
+                     sizeof(GlyphSlot));
+    if (!glyphs) {
+        _PGFT_free(chars);
+        return;
+    }
+    memcpy(chars, PGFT_String_GET_DATA(text),
+           (size_t)length * sizeof(PGFT_char));
+    memcpy(glyphs, ftext->glyphs, (size_t)ftext->length * sizeof(GlyphSlot));
+    entry->hash = hash;
+    entry->text_length = length;
+    entry->text = chars;
+    entry->layout = *ftext;
+    entry->layout.glyphs = glyphs;
+    entry->layout.buffer_size = ftext->length;
+    entry->stamp = ++internals->layout_clock;
+}
+
+static void
+free_layout_entry(LayoutEntry *entry)
+{
+    _PGFT_free(entry->text);
+    entry->text = 0;
+    _PGFT_free(entry->layout.glyphs);
+    entry->layout.glyphs = 0;
+    entry->layout.buffer_size = 0;
+    entry->stamp = 0;
+}
@@ -359,6 +359,13 @@ _PGFT_Render_ExistingSurface(FreeTypeInstance *ft, PgFontObject *fontobj,
     font_surf.render_gray = __SDLrenderFuncs[surface->format->BytesPerPixel];
     font_surf.render_mono = __MONOrenderFuncs[surface->format->BytesPerPixel];
     font_surf.fill = __RGBfillFuncs[surface->format->BytesPerPixel];
+    _PGFT_SetSIMDCallbacks(&font_surf);
+
+    /*
+     * The caller holds the font lock, so the layout and glyph bitmaps
+     * stay put while the pixels are written without the GIL.
+     */
+    Py_BEGIN_ALLOW_THREADS;
 
     /*
      * if bg color exists, paint background
@@ -391,6 +398,8 @@ _PGFT_Render_ExistingSurface(FreeTypeInstance *ft, PgFontObject *fontobj,
     render(ft, font_text, mode, fgcolor, &font_surf,
            width, height, &surf_offset, underline_top, underline_size);
 
+    Py_END_ALLOW_THREADS;
+
     r->x = -(Sint16)FX6_TRUNC(FX6_FLOOR(offset.x));
     r->y = (Sint16)FX6_TRUNC(FX6_CEIL(offset.y));
     r->w = (Uint16)width;
@@ -481,6 +490,7 @@ SDL_Surface *_PGFT_Render_NewSurface(FreeTypeInstance *ft,
         font_surf.render_gray = __render_glyph_RGB4;
         font_surf.render_mono = __render_glyph_MONO4;
         font_surf.fill = __fill_glyph_RGB4;
+        _PGFT_SetSIMDCallbacks(&font_surf);
         /*
          * Fill our texture with the required bg color
          */
@@ -529,8 +539,10 @@ SDL_Surface *_PGFT_Render_NewSurface(FreeTypeInstance *ft,
     /*
      * Render the text!
      */
+    Py_BEGIN_ALLOW_THREADS;
     render(ft, font_text, mode, fgcolor, &font_surf,
            width, height, &offset, underline_top, underline_size);
+    Py_END_ALLOW_THREADS;
 
     r->x = -(Sint16)FX6_TRUNC(FX6_FLOOR(offset.x));
     r->y = (Sint16)FX6_TRUNC(FX6_CEIL(offset.y));
@@ -616,8 +628,10 @@ PyObject *_PGFT_Render_PixelArray(FreeTypeInstance *ft, PgFontObject *fontobj,
     surf.render_mono = __render_glyph_MONO_as_GRAY1;
     surf.fill = __fill_glyph_GRAY1;
 
+    Py_BEGIN_ALLOW_THREADS;
     render(ft, font_text, mode, invert ? &mono_transparent : &mono_opaque,
            &surf, width, height, &offset, underline_top, underline_size);
+    Py_END_ALLOW_THREADS;
 
     *_width = width;
     *_height = height;
@@ -737,9 +751,11 @@ _PGFT_Render_Array(FreeTypeInstance *ft, PgFontObject *fontobj,
     font_surf.render_mono = __render_glyph_MONO_as_INT;
     font_surf.fill = __fill_glyph_INT;
 
+    Py_BEGIN_ALLOW_THREADS;
     render(ft, font_text, mode, invert ? &mono_transparent : &mono_opaque,
            &font_surf, width, height, &array_offset, underline_top,
            underline_size);
+    Py_END_ALLOW_THREADS;
 
     PgBuffer_Release(&pg_view);
     r->x = -(Sint16)FX6_TRUNC(FX6_FLOOR(offset.x));
@@ -768,7 +784,7 @@ render(FreeTypeInstance *ft, Layout *text, const FontRenderMode *mode,
     int n;
     int length = text->length;
     GlyphSlot *slots = text->glyphs;
-    FT_BitmapGlyph image;
+    FontGlyph *glyph;
     FontRenderPtr render_gray = surface->render_gray;
     FontRenderPtr render_mono = surface->render_mono;
     int is_underline_gray = 0;
@@ -779,15 +795,15 @@ render(FreeTypeInstance *ft, Layout *text, const FontRenderMode *mode,
     left = offset->x;
     top = offset->y;
     for (n = 0; n < length; ++n) {
-        image = slots[n].glyph->image;
+        glyph = slots[n].glyph;
         x = FX6_TRUNC(FX6_CEIL(left + slots[n].posn.x + slots[n].offset.x));
         y = FX6_TRUNC(FX6_CEIL(top + slots[n].posn.y - slots[n].offset.y));
-        if (image->bitmap.pixel_mode == FT_PIXEL_MODE_GRAY) {
-            render_gray(x, y, surface, &(image->bitmap), fg_color);
+        if (glyph->bitmap.pixel_mode == FT_PIXEL_MODE_GRAY) {
+            render_gray(x, y, surface, &(glyph->bitmap), fg_color);
             is_underline_gray = 1;
         }
         else {
-            render_mono(x, y, surface, &(image->bitmap), fg_color);
+            render_mono(x, y, surface, &(glyph->bitmap), fg_color);
         }
     }
 
@@ -30,6 +30,26 @@
 #   include "surface.h"
 #endif
 
+/* SSE2 is part of the x86-64 baseline. A 32 bit x86 build without it
+ * enabled still compiles the SSE2 callbacks where the compiler allows it
+ * per function; _PGFT_SetSIMDCallbacks checks the processor either way.
+ */
+#if defined(HAVE_PYGAME_SDL_VIDEO)
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PGFT_SSE2_SUPPORT
+#define PGFT_SSE2_TARGET
+#elif defined(__GNUC__) && !defined(__clang__) && defined(__i386__) && \
+      (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define PGFT_SSE2_SUPPORT
+#define PGFT_SSE2_TARGET __attribute__((target("sse2")))
+#endif
+#endif
+
+#if defined(PGFT_SSE2_SUPPORT)
+#include <emmintrin.h>
+#endif
+
 void __render_glyph_GRAY1(int x, int y, FontSurface *surface,
                           const FT_Bitmap *bitmap, const FontColor *fg_color)
 {
@@ -830,10 +850,16 @@ void __fill_glyph_INT(FT_Fixed x, FT_Fixed y, FT_Fixed w, FT_Fixed h,
 #define _SET_PIXEL(T) \
     *(T*)_dst = (T)full_color;
 
+/* Each channel is masked, as ALPHA_BLEND on the unsigned bgR, bgG and bgB
+ * can leave bits above the low byte set.
+ */
 #define _BLEND_PIXEL(T) *((T*)_dst) = (T)(                          \
-    ((bgR >> surface->format->Rloss) << surface->format->Rshift) |  \
-    ((bgG >> surface->format->Gloss) << surface->format->Gshift) |  \
-    ((bgB >> surface->format->Bloss) << surface->format->Bshift) |  \
+    ((bgR >> surface->format->Rloss) << surface->format->Rshift  &  \
+     surface->format->Rmask)                                     |  \
+    ((bgG >> surface->format->Gloss) << surface->format->Gshift  &  \
+     surface->format->Gmask)                                     |  \
+    ((bgB >> surface->format->Bloss) << surface->format->Bshift  &  \
+     surface->format->Bmask)                                     |  \
     ((bgA >> surface->format->Aloss) << surface->format->Ashift  &  \
      surface->format->Amask)                                        )
 
@@ -857,4 +883,292 @@ _CREATE_RGB_FILLER(4,  _GET_PIXEL(FT_UInt32),   _SET_PIXEL(FT_UInt32),  _BLEND_P
 _CREATE_RGB_FILLER(3,  GET_PIXEL24(_dst),       _SET_PIXEL_24,          _BLEND_PIXEL_24)
 _CREATE_RGB_FILLER(2,  _GET_PIXEL(FT_UInt16),   _SET_PIXEL(FT_UInt16),  _BLEND_PIXEL(FT_UInt16))
 _CREATE_RGB_FILLER(1,  _GET_PIXEL(FT_Byte),     _SET_PIXEL(FT_Byte),    _BLEND_PIXEL_GENERIC(FT_Byte))
+
+#if defined(PGFT_SSE2_SUPPORT)
+
+/* Constants for compositing one color onto a 32 bit surface whose
+ * channels are each a byte of the pixel, four pixels at a time.
+ */
+typedef struct blendsse2_ {
+    __m128i color_px;   /* color, alpha and unused bytes zero, x 4 */
+    __m128i color;      /* color_px of two pixels, one channel per word */
+    __m128i amask;      /* alpha bits of a pixel, x 4 */
+    __m128i alane;      /* alpha channel words of two unpacked pixels */
+    __m128i keep;       /* bits of a pixel that are written, x 4 */
+    __m128i ashift;
+} BlendSSE2;
+
+static int
+is_bytelane_format(const SDL_PixelFormat *format)
+{
+    return (format->BytesPerPixel == 4 &&
+            format->Rloss == 0 && format->Gloss == 0 && format->Bloss == 0 &&
+            !(format->Rshift & 7) && !(format->Gshift & 7) &&
+            !(format->Bshift & 7) &&
+            (!format->Amask ||
+             (format->Aloss == 0 && !(format->Ashift & 7))));
+}
+
+static PGFT_SSE2_TARGET void
+init_blend_sse2(BlendSSE2 *b, const SDL_PixelFormat *format,
+                const FontColor *color)
+{
+    FT_UInt32 px = (((FT_UInt32)color->r << format->Rshift) |
+                    ((FT_UInt32)color->g << format->Gshift) |
+                    ((FT_UInt32)color->b << format->Bshift));
+    FT_UInt16 alane[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+
+    if (format->Amask) {
+        alane[format->Ashift / 8] = 0xFFFF;
+        alane[format->Ashift / 8 + 4] = 0xFFFF;
+    }
+    b->color_px = _mm_set1_epi32((int)px);
+    b->color = _mm_unpacklo_epi8(b->color_px, _mm_setzero_si128());
+    b->amask = _mm_set1_epi32((int)format->Amask);
+    b->alane = _mm_loadu_si128((const __m128i *)alane);
+    b->keep = _mm_set1_epi32((int)(format->Rmask | format->Gmask |
+                                   format->Bmask | format->Amask));
+    b->ashift = _mm_cvtsi32_si128(format->Ashift);
+}
+
+/* x / 255 rounded down, for 0 <= x <= 255 * 255 in each word */
+static PGFT_SSE2_TARGET __m128i
+div255_sse2(__m128i x)
+{
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)),
+                                        _mm_srli_epi16(x, 8)), 8);
+}
+
+/* Blend the color over four pixels as ALPHA_BLEND and _BLEND_PIXEL do,
+ * with alpha i in word i of a16. The color equation is rearranged as
+ * (d * (256 - a) + s * (a + 1)) >> 8, which stays within 16 bits.
+ */
+static PGFT_SSE2_TARGET __m128i
+blend4_sse2(__m128i dst, __m128i a16, const BlendSSE2 *b)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i c256 = _mm_set1_epi16(256);
+    __m128i aa = _mm_unpacklo_epi16(a16, a16);
+    __m128i a_lo = _mm_unpacklo_epi32(aa, aa);
+    __m128i a_hi = _mm_unpackhi_epi32(aa, aa);
+    __m128i d_lo = _mm_unpacklo_epi8(dst, zero);
+    __m128i d_hi = _mm_unpackhi_epi8(dst, zero);
+    __m128i c_lo, c_hi, n_lo, n_hi, out, clear, fresh;
+
+    c_lo = _mm_add_epi16(_mm_mullo_epi16(d_lo, _mm_sub_epi16(c256, a_lo)),
+                         _mm_mullo_epi16(b->color, _mm_add_epi16(a_lo, one)));
+    c_hi = _mm_add_epi16(_mm_mullo_epi16(d_hi, _mm_sub_epi16(c256, a_hi)),
+                         _mm_mullo_epi16(b->color, _mm_add_epi16(a_hi, one)));
+    c_lo = _mm_srli_epi16(c_lo, 8);
+    c_hi = _mm_srli_epi16(c_hi, 8);
+
+    /* The alpha channel becomes a + d - a * d / 255 */
+    n_lo = _mm_sub_epi16(_mm_add_epi16(a_lo, d_lo),
+                         div255_sse2(_mm_mullo_epi16(a_lo, d_lo)));
+    n_hi = _mm_sub_epi16(_mm_add_epi16(a_hi, d_hi),
+                         div255_sse2(_mm_mullo_epi16(a_hi, d_hi)));
+    c_lo = _mm_or_si128(_mm_and_si128(b->alane, n_lo),
+                        _mm_andnot_si128(b->alane, c_lo));
+    c_hi = _mm_or_si128(_mm_and_si128(b->alane, n_hi),
+                        _mm_andnot_si128(b->alane, c_hi));
+    out = _mm_and_si128(_mm_packus_epi16(c_lo, c_hi), b->keep);
+
+    /* A fully transparent pixel just takes the color and alpha */
+    clear = _mm_andnot_si128(_mm_cmpeq_epi32(b->amask, zero),
+                             _mm_cmpeq_epi32(_mm_and_si128(dst, b->amask),
+                                             zero));
+    fresh = _mm_or_si128(b->color_px,
+                         _mm_sll_epi32(_mm_unpacklo_epi16(a16, zero),
+                                       b->ashift));
+    return _mm_or_si128(_mm_and_si128(clear, fresh),
+                        _mm_andnot_si128(clear, out));
+}
+
+/* Composite n pixels at dst with alphas cov * shade / 255; pixels of zero
+ * alpha are left as they are.
+ */
+static PGFT_SSE2_TARGET void
+render_span_sse2(FT_Byte *dst, const FT_Byte *cov, int n, FT_Byte shade,
+                 const BlendSSE2 *b)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i scale = _mm_set1_epi16(shade);
+    const __m128i full = _mm_or_si128(b->color_px, b->amask);
+    FT_UInt32 cov4;
+    FT_Byte tail_cov[4];
+    FT_UInt32 tail_dst[4];
+    __m128i a16, a32, d, out;
+    int i, count;
+
+    for (i = 0; i < n; i += 4) {
+        count = n - i < 4 ? n - i : 4;
+        if (count == 4) {
+            memcpy(&cov4, cov + i, 4);
+        }
+        else {
+            memset(tail_cov, 0, sizeof(tail_cov));
+            memcpy(tail_cov, cov + i, (size_t)count);
+            memcpy(&cov4, tail_cov, 4);
+        }
+        if (cov4 == 0) {
+            continue;
+        }
+        if (cov4 == 0xFFFFFFFFU && shade == 0xFF) {
+            _mm_storeu_si128((__m128i *)(dst + i * 4), full);
+            continue;
+        }
+
+        if (count == 4) {
+            d = _mm_loadu_si128((const __m128i *)(dst + i * 4));
+        }
+        else {
+            memset(tail_dst, 0, sizeof(tail_dst));
+            memcpy(tail_dst, dst + i * 4, (size_t)count * 4);
+            d = _mm_loadu_si128((const __m128i *)tail_dst);
+        }
+        a16 = _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)cov4), zero);
+        a16 = div255_sse2(_mm_mullo_epi16(a16, scale));
+        a32 = _mm_unpacklo_epi16(a16, zero);
+        out = blend4_sse2(d, a16, b);
+        a32 = _mm_cmpeq_epi32(a32, zero);
+        out = _mm_or_si128(_mm_and_si128(a32, d), _mm_andnot_si128(a32, out));
+        if (count == 4) {
+            _mm_storeu_si128((__m128i *)(dst + i * 4), out);
+        }
+        else {
+            _mm_storeu_si128((__m128i *)tail_dst, out);
+            memcpy(dst + i * 4, tail_dst, (size_t)count * 4);
+        }
+    }
+}
+
+/* Blend n pixels at dst with a single alpha, as the filler does */
+static PGFT_SSE2_TARGET void
+fill_span_sse2(FT_Byte *dst, int n, FT_Byte alpha, const BlendSSE2 *b)
+{
+    const __m128i a16 = _mm_set1_epi16(alpha);
+    FT_UInt32 tail_dst[4];
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i * 4));
+
+        _mm_storeu_si128((__m128i *)(dst + i * 4), blend4_sse2(d, a16, b));
+    }
+    if (i < n) {
+        memset(tail_dst, 0, sizeof(tail_dst));
+        memcpy(tail_dst, dst + i * 4, (size_t)(n - i) * 4);
+        _mm_storeu_si128((__m128i *)tail_dst,
+                         blend4_sse2(_mm_loadu_si128((__m128i *)tail_dst),
+                                     a16, b));
+        memcpy(dst + i * 4, tail_dst, (size_t)(n - i) * 4);
+    }
+}
+
+static PGFT_SSE2_TARGET void
+__render_glyph_RGB4_SSE2(int x, int y, FontSurface *surface,
+                         const FT_Bitmap *bitmap, const FontColor *color)
+{
+    const int off_x = (x < 0) ? -x : 0;
+    const int off_y = (y < 0) ? -y : 0;
+
+    const int max_x = MIN(x + bitmap->width, surface->width);
+    const int max_y = MIN(y + bitmap->rows, surface->height);
+
+    const int rx = MAX(0, x);
+    const int ry = MAX(0, y);
+
+    FT_Byte *dst = ((FT_Byte *)surface->buffer) + (rx * 4) +
+                   (ry * surface->pitch);
+    const FT_Byte *src = bitmap->buffer + off_x + (off_y * bitmap->pitch);
+    BlendSSE2 blend;
+    int j;
+
+    if (max_x <= rx || color->a == 0) {
+        return;
+    }
+    init_blend_sse2(&blend, surface->format, color);
+    for (j = ry; j < max_y; ++j) {
+        render_span_sse2(dst, src, max_x - rx, color->a, &blend);
+        dst += surface->pitch;
+        src += bitmap->pitch;
+    }
+}
+
+static PGFT_SSE2_TARGET void
+__fill_glyph_RGB4_SSE2(FT_Fixed x, FT_Fixed y, FT_Fixed w, FT_Fixed h,
+                       FontSurface *surface, const FontColor *color)
+{
+    FT_Fixed dh = 0;
+    FT_Byte *dst;
+    int n;
+    BlendSSE2 blend;
+
+    /* The same clipping and row coverage as __fill_glyph_RGB4 */
+    x = MAX(0, x);
+    y = MAX(0, y);
+    if (x + w > INT_TO_FX6(surface->width)) {
+        w = INT_TO_FX6(surface->width) - x;
+    }
+    if (y + h > INT_TO_FX6(surface->height)) {
+        h = INT_TO_FX6(surface->height) - y;
+    }
+    dst = ((FT_Byte *)surface->buffer +
+           FX6_TRUNC(FX6_CEIL(x)) * 4 +
+           FX6_TRUNC(FX6_CEIL(y)) * surface->pitch);
+    n = FX6_TRUNC(FX6_CEIL(w));
+    if (n <= 0) {
+        return;
+    }
+    init_blend_sse2(&blend, surface->format, color);
+
+    dh = FX6_CEIL(y) - y;
+    if (dh > h) {
+        dh = h;
+    }
+    h -= dh;
+    if (dh > 0) {
+        fill_span_sse2(dst - surface->pitch, n,
+                       (FT_Byte)FX6_TRUNC(FX6_ROUND(color->a * dh)), &blend);
+        y += dh;
+    }
+
+    dh = FX6_FLOOR(h);
+    h -= dh;
+    while (dh > 0) {
+        fill_span_sse2(dst, n, color->a, &blend);
+        dst += surface->pitch;
+        dh -= FX6_ONE;
+        y += FX6_ONE;
+    }
+
+    if (h > 0) {
+        fill_span_sse2(dst, n,
+                       (FT_Byte)FX6_TRUNC(FX6_ROUND(color->a * h)), &blend);
+    }
+}
+
+#endif /* defined(PGFT_SSE2_SUPPORT) */
+
+void
+_PGFT_SetSIMDCallbacks(FontSurface *surface)
+{
+#if defined(PGFT_SSE2_SUPPORT)
+    static int has_sse2 = -1;
+
+    if (has_sse2 < 0) {
+        has_sse2 = SDL_HasSSE2() ? 1 : 0;
+    }
+    if (!has_sse2 || !is_bytelane_format(surface->format)) {
+        return;
+    }
+    if (surface->render_gray == __render_glyph_RGB4) {
+        surface->render_gray = __render_glyph_RGB4_SSE2;
+    }
+    if (surface->fill == __fill_glyph_RGB4) {
+        surface->fill = __fill_glyph_RGB4_SSE2;
+    }
+#endif
+}
 #endif
@@ -301,8 +301,10 @@ _PGFT_GetFontSized(FreeTypeInstance *ft,
     }
     _PGFT_BuildScaler(fontobj, &scale, face_size);
 
+    _PGFT_LockInstance(ft);
     error = FTC_Manager_LookupSize(ft->cache_manager,
         &scale, &_fts);
+    _PGFT_UnlockInstance(ft);
 
     if (error) {
         _PGFT_SetError(ft, "Failed to resize font", error);
@@ -318,9 +320,11 @@ _PGFT_GetFont(FreeTypeInstance *ft, PgFontObject *fontobj)
     FT_Error error;
     FT_Face font;
 
+    _PGFT_LockInstance(ft);
     error = FTC_Manager_LookupFace(ft->cache_manager,
         (FTC_FaceID)(&fontobj->id),
         &font);
+    _PGFT_UnlockInstance(ft);
 
     if (error) {
         _PGFT_SetError(ft, "Failed to load font", error);
@@ -367,13 +371,11 @@ _PGFT_font_request(FTC_FaceID font_id, FT_Library library,
                    FT_Pointer request_data, FT_Face *afont)
 {
     PgFontId *id = (PgFontId *)font_id;
-    FT_Error error;
 
-    Py_BEGIN_ALLOW_THREADS;
-    error = FT_Open_Face(library, &id->open_args, id->font_index, afont);
-    Py_END_ALLOW_THREADS;
-
-    return error;
+    /* Called from inside a cache manager lookup, with the instance lock
+     * held, so opening the face is serialized with all other library use.
+     */
+    return FT_Open_Face(library, &id->open_args, id->font_index, afont);
 }
 
 
@@ -499,8 +501,10 @@ _PGFT_UnloadFont(FreeTypeInstance *ft, PgFontObject *fontobj)
         return;
 
     if (ft) {
+        _PGFT_LockInstance(ft);
         FTC_Manager_RemoveFaceID(ft->cache_manager, (FTC_FaceID)(&fontobj->id));
         quit(fontobj);
+        _PGFT_UnlockInstance(ft);
     }
 
     if (fontobj->id.open_args.flags == FT_OPEN_STREAM) {
@@ -513,6 +517,57 @@ _PGFT_UnloadFont(FreeTypeInstance *ft, PgFontObject *fontobj)
     fontobj->id.open_args.flags = 0;
 }
 
+/* Rendering into a target runs without the GIL, reading the font's
+ * layout and glyph cache, so anything that builds or frees those holds
+ * the font lock. The lock is only waited on with the GIL released, which
+ * lets its holder take the GIL back without a deadlock.
+ */
+int
+_PGFT_LockFont(PgFontObject *fontobj)
+{
+    SDL_mutex *lock = fontobj->lock;
+
+    Py_BEGIN_ALLOW_THREADS;
+    SDL_mutexP(lock);
+    Py_END_ALLOW_THREADS;
+
+    if (!PgFont_IS_ALIVE(fontobj)) {
+        /* Unloaded by another thread while this one waited */
+        SDL_mutexV(lock);
+        PyErr_SetString(PyExc_RuntimeError,
+                        "freetype.Font instance is not initialized");
+        return -1;
+    }
+    return 0;
+}
+
+void
+_PGFT_UnlockFont(PgFontObject *fontobj)
+{
+    SDL_mutexV(fontobj->lock);
+}
+
+/* The instance lock is taken after any font lock. A face looked up
+ * from the cache manager stays valid until the lock is released, as
+ * only a lookup can flush it. Like the font lock it is waited on with
+ * the GIL released. It is recursive, so lookups may nest.
+ */
+void
+_PGFT_LockInstance(FreeTypeInstance *ft)
+{
+    SDL_mutex *lock = ft->lock;
+
+    Py_BEGIN_ALLOW_THREADS;
+    SDL_mutexP(lock);
+    Py_END_ALLOW_THREADS;
+}
+
+void
+_PGFT_UnlockInstance(FreeTypeInstance *ft)
+{
+    SDL_mutexV(ft->lock);
+}
+
 
 /*********************************************************
  *
@@ -536,6 +591,14 @@ _PGFT_Init(FreeTypeInstance **_instance, int cache_size)
     inst->cache_manager = 0;
     inst->library = 0;
     inst->cache_size = cache_size;
+    inst->cache_budget = PGFT_DEFAULT_CACHE_BUDGET;
+    memset(&inst->cache_stats, 0, sizeof(inst->cache_stats));
+
+    inst->lock = SDL_CreateMutex();
+    if (!inst->lock) {
+        PyErr_SetString(PyExc_SDLError, SDL_GetError());
+        goto error_cleanup;
+    }
 
     error = FT_Init_FreeType(&inst->library);
     if (error) {
@@ -584,6 +647,9 @@ _PGFT_Quit(FreeTypeInstance *ft)
     if (ft->library)
         FT_Done_FreeType(ft->library);
 
+    if (ft->lock)
+        SDL_DestroyMutex(ft->lock);
+
     _PGFT_free(ft);
 }
 
@@ -53,6 +53,7 @@
 /* Internal configuration variables */
 #define PGFT_DEFAULT_CACHE_SIZE 64
 #define PGFT_MIN_CACHE_SIZE 32
+#define PGFT_DEFAULT_CACHE_BUDGET (2L << 20) /* bytes of glyphs per font */
 #if defined(PGFT_DEBUG_CACHE)
 #undef  PGFT_DEBUG_CACHE
 #endif
@@ -74,7 +75,18 @@ typedef FT_UInt GlyphIndex_t;
 /**********************************************************
  * Internal data structures
  **********************************************************/
- 
+
+/* Glyph cache counters, totalled over the fonts of a FreeTypeInstance.
+ * bytes is the memory currently charged to glyphs, bitmap cells and
+ * nodes, against the per font cache_budget.
+ */
+typedef struct fontcachestats_ {
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long evictions;
+    size_t bytes;
+} FontCacheStats;
+
 /* FreeTypeInstance: the global freetype 2 library state.
  *
  * Instances of this struct are created by _PGFT_Init, and
@@ -94,7 +106,14 @@ typedef struct freetypeinstance_ {
     FTC_CMapCache cache_charmap;
 
     int cache_size;
+    size_t cache_budget;
+    FontCacheStats cache_stats;
     char _error_msg[1024];
+
+    /* Guards the library, cache manager and cache statistics, which all
+     * fonts share. Glyphs are loaded with it held and the GIL released.
+     */
+    SDL_mutex *lock;
 } FreeTypeInstance;
 
 typedef struct fontcolor_ {
@@ -121,12 +140,32 @@ typedef struct rendermode_ {
 #endif
 
 struct cachenode_;
+struct cacheslab_;
+struct cachepage_;
 
+/* Number of bitmap cell sizes of the glyph cache pages */
+#define PGFT_CACHE_CELL_CLASSES 15
+
+/* FontCache: the glyph cache of a font.
+ *
+ * Nodes come from slabs and are kept on a most recently used list;
+ * _PGFT_Cache_Cleanup evicts from its tail until the cache fits the
+ * budget of its FreeTypeInstance.  Glyph bitmaps are copied into cells
+ * of shared pages, one free list per cell size, so an evicted glyph's
+ * cell is reused by the next glyph of that size.
+ */
 typedef struct fontcache_ {
     struct cachenode_ **nodes;
     struct cachenode_ *free_nodes;
+    struct cacheslab_ *slabs;
+    struct cachenode_ *newest;
+    struct cachenode_ *oldest;
+    void *free_cells[PGFT_CACHE_CELL_CLASSES];
+    struct cachepage_ *pages;
 
-    FT_Byte *depths;
+    FreeTypeInstance *freetype;
+    FT_UInt32 count;
+    size_t bytes;
 
 #ifdef PGFT_DEBUG_CACHE
     FT_UInt32 _debug_count;
@@ -147,7 +186,9 @@ typedef struct fontmetrics_ {
 } FontMetrics;
 
 typedef struct fontglyph_ {
-    FT_BitmapGlyph image;
+    FT_Bitmap bitmap;     /* buffer owned by the glyph cache */
+    FT_Int left;          /* In pixels */
+    FT_Int top;           /* In pixels */
 
     FT_Pos width;         /* 26.6 */
     FT_Pos height;        /* 26.6 */
@@ -212,9 +253,28 @@ typedef struct fontsurface_ {
 
 } FontSurface;
 
+/* Number of recently laid out strings remembered by a font */
+#define PGFT_LAYOUT_CACHE_SIZE 8
+
+/* LayoutEntry: a shaped and positioned string kept by the layout cache.
+ *
+ * The glyph pointers of the slots are not trusted on reuse, as the glyph
+ * cache may have evicted them since; they are looked up again instead.
+ * An entry with a zero stamp is unused.
+ */
+typedef struct layoutentry_ {
+    FT_UInt32 hash;
+    Py_ssize_t text_length;
+    PGFT_char *text;
+    Layout layout;
+    unsigned long stamp;
+} LayoutEntry;
+
 typedef struct fontinternals_ {
     Layout active_text;
     FontCache glyph_cache;
+    LayoutEntry layouts[PGFT_LAYOUT_CACHE_SIZE];
+    unsigned long layout_clock;
 } FontInternals;
 
 typedef struct PGFT_String_ {
@@ -288,6 +348,10 @@ int _PGFT_TryLoadFont_RWops(FreeTypeInstance *,
                             PgFontObject *, SDL_RWops *, long);
 #endif
 void _PGFT_UnloadFont(FreeTypeInstance *, PgFontObject *);
+int _PGFT_LockFont(PgFontObject *);
+void _PGFT_UnlockFont(PgFontObject *);
+void _PGFT_LockInstance(FreeTypeInstance *);
+void _PGFT_UnlockInstance(FreeTypeInstance *);
 
 
 /**************************************** Metrics management *****************/
@@ -297,6 +361,9 @@ int _PGFT_GetTextRect(FreeTypeInstance *, PgFontObject *,
 int _PGFT_GetMetrics(FreeTypeInstance *, PgFontObject *, const FontRenderMode *,
                      FT_UInt *, long *, long *, long *, long *,
                      double *, double *, raqm_glyph_t);
+long _PGFT_PreloadGlyphs(FreeTypeInstance *, PgFontObject *,
+                         const FontRenderMode *, const PGFT_char *,
+                         Py_ssize_t);
 void _PGFT_GetRenderMetrics(const FontRenderMode *, Layout *,
                             unsigned *, unsigned *, FT_Vector *,
                             FT_Pos *, FT_Fixed *);
@@ -322,6 +389,10 @@ int _PGFT_CheckStyle(FT_UInt32);
 
 
 /**************************************** Render callbacks *******************/
+#ifdef HAVE_PYGAME_SDL_VIDEO
+void _PGFT_SetSIMDCallbacks(FontSurface *);
+#endif
+
 void __fill_glyph_RGB1(FT_Fixed, FT_Fixed, FT_Fixed, FT_Fixed,
                        FontSurface *, const FontColor *);
 void __fill_glyph_RGB2(FT_Fixed, FT_Fixed, FT_Fixed, FT_Fixed,
@@ -373,7 +444,8 @@ int _PGFT_LayoutInit(FreeTypeInstance *, PgFontObject *);
 void _PGFT_LayoutFree(PgFontObject *);
 Layout *_PGFT_LoadLayout(FreeTypeInstance *, PgFontObject *,
                          const FontRenderMode *, PGFT_String *);
-int _PGFT_LoadGlyph(FontGlyph *, GlyphIndex_t, const FontRenderMode *, void *);
+int _PGFT_LoadGlyph(FontGlyph *, FT_Glyph *, GlyphIndex_t,
+                    const FontRenderMode *, void *);
 
 
 /**************************************** Glyph cache management *************/
@@ -396,7 +468,8 @@ void _PGFT_SetError(FreeTypeInstance *, const char *, FT_Error);
 FT_Face _PGFT_GetFont(FreeTypeInstance *, PgFontObject *);
 FT_Face _PGFT_GetFontSized(FreeTypeInstance *, PgFontObject *, Scale_t);
 void _PGFT_BuildScaler(PgFontObject *, FTC_Scaler, Scale_t);
-#define _PGFT_malloc PyMem_Malloc
-#define _PGFT_free   PyMem_Free
+/* Layouts and glyphs are allocated without the GIL */
+#define _PGFT_malloc malloc
+#define _PGFT_free   free
 
 #endif
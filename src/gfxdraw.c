@@ -22,7 +22,6 @@
   from Pygame 2.
 
   TODO:
-  - fix filledPolygonRGBA to use MT versions for threaded use.
   - do a filled pie version using filledPieColor
   - Determine if SDL video must be initiated for all routines to work.
     Add check if required, else remove ASSERT_VIDEO_INIT.
@@ -35,6 +34,7 @@
 #include "surface.h"
 #include "pgcompat.h"
 #include "SDL_gfx/SDL_gfxPrimitives.h"
+#include "aacoverage.h"
 
 
 static PyObject* _gfx_pixelcolor (PyObject *self, PyObject* args);
@@ -58,6 +58,8 @@ static PyObject* _gfx_polygoncolor (PyObject *self, PyObject* args);
 static PyObject* _gfx_aapolygoncolor (PyObject *self, PyObject* args);
 static PyObject* _gfx_filledpolygoncolor (PyObject *self, PyObject* args);
 static PyObject* _gfx_texturedpolygon (PyObject *self, PyObject* args);
+static PyObject* _gfx_texturedtriangles (PyObject *self, PyObject* args);
+static PyObject* _gfx_texturedquads (PyObject *self, PyObject* args);
 static PyObject* _gfx_beziercolor (PyObject *self, PyObject* args);
 
 static PyMethodDef _gfxdraw_methods[] = {
@@ -82,6 +84,10 @@ static PyMethodDef _gfxdraw_methods[] = {
     { "aapolygon", _gfx_aapolygoncolor, METH_VARARGS, DOC_PYGAMEGFXDRAWAAPOLYGON },
     { "filled_polygon", _gfx_filledpolygoncolor, METH_VARARGS, DOC_PYGAMEGFXDRAWFILLEDPOLYGON },
     { "textured_polygon", _gfx_texturedpolygon, METH_VARARGS, DOC_PYGAMEGFXDRAWTEXTUREDPOLYGON },
+    { "textured_triangles", _gfx_texturedtriangles, METH_VARARGS,
+      DOC_PYGAMEGFXDRAWTEXTUREDTRIANGLES },
+    { "textured_quads", _gfx_texturedquads, METH_VARARGS,
+      DOC_PYGAMEGFXDRAWTEXTUREDQUADS },
     { "bezier", _gfx_beziercolor, METH_VARARGS, DOC_PYGAMEGFXDRAWBEZIER },
     { NULL, NULL, 0, NULL },
 };
@@ -122,6 +128,67 @@ Sint16FromSeqIndex (PyObject* obj, Py_ssize_t _index, Sint16* val)
     return result;
 }
 
+/* Anti-aliases an outline path with analytic coverage, see aacoverage.h. */
+static int
+_gfx_aapathfill (SDL_Surface *surface, AAPath *path, Uint8 *rgba)
+{
+    int ret;
+
+    Py_BEGIN_ALLOW_THREADS;
+    ret = aapath_fill (surface, path, rgba, 1, NULL);
+    Py_END_ALLOW_THREADS;
+    aapath_free (path);
+    return ret < 0 ? -1 : 0;
+}
+
+/* Integer coordinates are pixel centers, hence the half pixel offsets. */
+static int
+_gfx_aaring (SDL_Surface *surface, Sint16 x, Sint16 y, Sint16 rx, Sint16 ry,
+             Uint8 *rgba)
+{
+    AAPath path;
+
+    if (rx < 0 || ry < 0)
+    {
+        SDL_SetError ("radius must not be negative");
+        return -1;
+    }
+    aapath_init (&path);
+    if (aapath_add_ellipse (&path, x + 0.5f, y + 0.5f, rx + 0.5f, ry + 0.5f,
+                            0) ||
+        (rx > 0 && ry > 0 &&
+         aapath_add_ellipse (&path, x + 0.5f, y + 0.5f, rx - 0.5f, ry - 0.5f,
+                             1)))
+    {
+        aapath_free (&path);
+        SDL_SetError ("Out of memory");
+        return -1;
+    }
+    return _gfx_aapathfill (surface, &path, rgba);
+}
+
+static int
+_gfx_aaoutline (SDL_Surface *surface, const Sint16 *vx, const Sint16 *vy,
+                int n, Uint8 *rgba)
+{
+    AAPath path;
+    int i, j;
+
+    aapath_init (&path);
+    for (i = 0; i < n; i++)
+    {
+        j = (i + 1) % n;
+        if (aapath_add_line (&path, vx[i] + 0.5f, vy[i] + 0.5f,
+                             vx[j] + 0.5f, vy[j] + 0.5f, 1.0f))
+        {
+            aapath_free (&path);
+            SDL_SetError ("Out of memory");
+            return -1;
+        }
+    }
+    return _gfx_aapathfill (surface, &path, rgba);
+}
+
 static PyObject*
 _gfx_pixelcolor (PyObject *self, PyObject* args)
 {
@@ -406,12 +473,18 @@ _gfx_aacirclecolor (PyObject *self, PyObject* args)
     PyObject *surface, *color;
     Sint16 x, y, r;
     Uint8 rgba[4];
+    int quality = AA_QUALITY_FAST;
 
     ASSERT_VIDEO_INIT (NULL);
 
-    if (!PyArg_ParseTuple (args, "OhhhO:aacircle", &surface, &x, &y, &r,
-            &color))
+    if (!PyArg_ParseTuple (args, "OhhhO|i:aacircle", &surface, &x, &y, &r,
+            &color, &quality))
+        return NULL;
+    if (!AA_QUALITY_IS_VALID (quality))
+    {
+        PyErr_SetString (PyExc_ValueError, AA_QUALITY_ERROR_MSG);
         return NULL;
+    }
 
     if (!PySurface_Check (surface))
     {
@@ -424,6 +497,16 @@ _gfx_aacirclecolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
+    if (quality == AA_QUALITY_COVERAGE)
+    {
+        if (_gfx_aaring (PySurface_AsSurface (surface), x, y, r, r,
+                         rgba) == -1)
+        {
+            PyErr_SetString (PyExc_SDLError, SDL_GetError ());
+            return NULL;
+        }
+        Py_RETURN_NONE;
+    }
     if (aacircleRGBA (PySurface_AsSurface (surface), x, y, r,
                       rgba[0], rgba[1], rgba[2], rgba[3]) == -1)
     {
@@ -505,12 +588,18 @@ _gfx_aaellipsecolor (PyObject *self, PyObject* args)
     PyObject *surface, *color;
     Sint16 x, y, rx, ry;
     Uint8 rgba[4];
+    int quality = AA_QUALITY_FAST;
 
     ASSERT_VIDEO_INIT (NULL);
 
-    if (!PyArg_ParseTuple (args, "OhhhhO:aaellipse", &surface, &x, &y, &rx, &ry,
-            &color))
+    if (!PyArg_ParseTuple (args, "OhhhhO|i:aaellipse", &surface, &x, &y, &rx,
+            &ry, &color, &quality))
+        return NULL;
+    if (!AA_QUALITY_IS_VALID (quality))
+    {
+        PyErr_SetString (PyExc_ValueError, AA_QUALITY_ERROR_MSG);
         return NULL;
+    }
 
     if (!PySurface_Check (surface))
     {
@@ -523,6 +612,16 @@ _gfx_aaellipsecolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
+    if (quality == AA_QUALITY_COVERAGE)
+    {
+        if (_gfx_aaring (PySurface_AsSurface (surface), x, y, rx, ry,
+                         rgba) == -1)
+        {
+            PyErr_SetString (PyExc_SDLError, SDL_GetError ());
+            return NULL;
+        }
+        Py_RETURN_NONE;
+    }
     if (aaellipseRGBA (PySurface_AsSurface (surface), x, y, rx, ry,
                        rgba[0], rgba[1], rgba[2], rgba[3]) == -1)
     {
@@ -639,12 +738,18 @@ _gfx_aatrigoncolor (PyObject *self, PyObject* args)
     PyObject *surface, *color;
     Sint16 x1, x2, x3, _y1, y2, y3;
     Uint8 rgba[4];
+    int quality = AA_QUALITY_FAST;
 
     ASSERT_VIDEO_INIT (NULL);
 
-    if (!PyArg_ParseTuple (args, "OhhhhhhO:aatrigon", &surface, &x1, &_y1, &x2,
-            &y2, &x3, &y3, &color))
+    if (!PyArg_ParseTuple (args, "OhhhhhhO|i:aatrigon", &surface, &x1, &_y1,
+            &x2, &y2, &x3, &y3, &color, &quality))
+        return NULL;
+    if (!AA_QUALITY_IS_VALID (quality))
+    {
+        PyErr_SetString (PyExc_ValueError, AA_QUALITY_ERROR_MSG);
         return NULL;
+    }
 
     if (!PySurface_Check (surface))
     {
@@ -657,6 +762,20 @@ _gfx_aatrigoncolor (PyObject *self, PyObject* args)
         return NULL;
     }
 
+    if (quality == AA_QUALITY_COVERAGE)
+    {
+        Sint16 vx[3], vy[3];
+
+        vx[0] = x1; vx[1] = x2; vx[2] = x3;
+        vy[0] = _y1; vy[1] = y2; vy[2] = y3;
+        if (_gfx_aaoutline (PySurface_AsSurface (surface), vx, vy, 3,
+                            rgba) == -1)
+        {
+            PyErr_SetString (PyExc_SDLError, SDL_GetError ());
+            return NULL;
+        }
+        Py_RETURN_NONE;
+    }
     if (aatrigonRGBA (PySurface_AsSurface (surface), x1, _y1, x2, y2, x3, y3,
                       rgba[0], rgba[1], rgba[2], rgba[3]) == -1)
     {
@@ -793,12 +912,19 @@ _gfx_aapolygoncolor (PyObject *self, PyObject* args)
     Sint16 *vx, *vy, x, y;
     Py_ssize_t count, i;
     int ret;
+    int quality = AA_QUALITY_FAST;
     Uint8 rgba[4];
 
     ASSERT_VIDEO_INIT (NULL);
 
-    if (!PyArg_ParseTuple (args, "OOO:aapolygon", &surface, &points, &color))
+    if (!PyArg_ParseTuple (args, "OOO|i:aapolygon", &surface, &points, &color,
+            &quality))
+        return NULL;
+    if (!AA_QUALITY_IS_VALID (quality))
+    {
+        PyErr_SetString (PyExc_ValueError, AA_QUALITY_ERROR_MSG);
         return NULL;
+    }
 
     if (!PySurface_Check (surface))
     {
@@ -857,10 +983,18 @@ _gfx_aapolygoncolor (PyObject *self, PyObject* args)
         vy[i] = y;
     }
 
-    Py_BEGIN_ALLOW_THREADS;
-    ret = aapolygonRGBA (PySurface_AsSurface (surface), vx, vy, (int)count,
-                         rgba[0], rgba[1], rgba[2], rgba[3]);
-    Py_END_ALLOW_THREADS;
+    if (quality == AA_QUALITY_COVERAGE)
+    {
+        ret = _gfx_aaoutline (PySurface_AsSurface (surface), vx, vy,
+                              (int)count, rgba);
+    }
+    else
+    {
+        Py_BEGIN_ALLOW_THREADS;
+        ret = aapolygonRGBA (PySurface_AsSurface (surface), vx, vy,
+                             (int)count, rgba[0], rgba[1], rgba[2], rgba[3]);
+        Py_END_ALLOW_THREADS;
+    }
 
     PyMem_Free (vx);
     PyMem_Free (vy);
@@ -880,6 +1014,8 @@ _gfx_filledpolygoncolor (PyObject *self, PyObject* args)
     Sint16 *vx, *vy, x, y;
     Py_ssize_t count, i;
     int ret;
+    int *polyints = NULL;
+    int polyallocated = 0;
     Uint8 rgba[4];
 
     ASSERT_VIDEO_INIT (NULL);
@@ -945,11 +1081,14 @@ _gfx_filledpolygoncolor (PyObject *self, PyObject* args)
         vy[i] = y;
     }
 
+    /* Per-call scan line cache, so threads never share scratch space. */
     Py_BEGIN_ALLOW_THREADS;
-    ret = filledPolygonRGBA (PySurface_AsSurface (surface), vx, vy,
-                             (int)count, rgba[0], rgba[1], rgba[2], rgba[3]);
+    ret = filledPolygonRGBAMT (PySurface_AsSurface (surface), vx, vy,
+                               (int)count, rgba[0], rgba[1], rgba[2], rgba[3],
+                               &polyints, &polyallocated);
     Py_END_ALLOW_THREADS;
 
+    free (polyints);
     PyMem_Free (vx);
     PyMem_Free (vy);
 
@@ -969,6 +1108,8 @@ _gfx_texturedpolygon (PyObject *self, PyObject* args)
     Sint16 *vx, *vy, x, y, tdx, tdy;
     Py_ssize_t count, i;
     int ret;
+    int *polyints = NULL;
+    int polyallocated = 0;
 
     ASSERT_VIDEO_INIT (NULL);
 
@@ -1043,10 +1184,11 @@ _gfx_texturedpolygon (PyObject *self, PyObject* args)
     }
 
     Py_BEGIN_ALLOW_THREADS;
-    ret = texturedPolygon (s_surface, vx, vy, (int)count,
-                           s_texture, tdx, tdy);
+    ret = texturedPolygonMT (s_surface, vx, vy, (int)count,
+                             s_texture, tdx, tdy, &polyints, &polyallocated);
     Py_END_ALLOW_THREADS;
 
+    free (polyints);
     PyMem_Free (vx);
     PyMem_Free (vy);
 
@@ -1059,6 +1201,157 @@ _gfx_texturedpolygon (PyObject *self, PyObject* args)
 }
 
 
+/* Corner order used to split each polygon of a mesh into triangles. */
+static const int _triangle_corners[] = { 0, 1, 2 };
+static const int _quad_corners[] = { 0, 1, 2, 0, 2, 3 };
+
+static PyObject*
+_gfx_texturedmesh (PyObject *args, const char *format, int nsides,
+                   const int *corners, int ncorners)
+{
+    PyObject *surface, *texture, *points, *texcoords, *item;
+    SDL_Surface *s_surface, *s_texture;
+    Sint16 *vx, *vy, x, y;
+    Sint32 *vu, *vv;
+    float u, v;
+    Py_ssize_t count, npoly, i, j, k;
+    int ret, bilinear = 0;
+
+    ASSERT_VIDEO_INIT (NULL);
+
+    if (!PyArg_ParseTuple (args, format, &surface, &points, &texcoords,
+            &texture, &bilinear))
+        return NULL;
+
+    if (!PySurface_Check (surface))
+    {
+        PyErr_SetString (PyExc_TypeError, "surface must be a Surface");
+        return NULL;
+    }
+    s_surface = PySurface_AsSurface (surface);
+    if (!PySurface_Check (texture))
+    {
+        PyErr_SetString (PyExc_TypeError, "texture must be a Surface");
+        return NULL;
+    }
+    s_texture = PySurface_AsSurface (texture);
+    if (!PySequence_Check (points) || !PySequence_Check (texcoords))
+    {
+        PyErr_SetString (PyExc_TypeError,
+            "points and texcoords must be sequences");
+        return NULL;
+    }
+
+    count = PySequence_Size (points);
+    if (count != PySequence_Size (texcoords))
+    {
+        PyErr_SetString (PyExc_ValueError,
+            "points and texcoords must have the same length");
+        return NULL;
+    }
+    if (count < nsides || count % nsides)
+    {
+        PyErr_Format (PyExc_ValueError,
+            "number of points must be a positive multiple of %d", nsides);
+        return NULL;
+    }
+
+    npoly = count / nsides;
+    vx = PyMem_New (Sint16, (size_t) (npoly * ncorners));
+    vy = PyMem_New (Sint16, (size_t) (npoly * ncorners));
+    vu = PyMem_New (Sint32, (size_t) (npoly * ncorners));
+    vv = PyMem_New (Sint32, (size_t) (npoly * ncorners));
+    if (!vx || !vy || !vu || !vv)
+    {
+        PyMem_Free (vx);
+        PyMem_Free (vy);
+        PyMem_Free (vu);
+        PyMem_Free (vv);
+        return PyErr_NoMemory ();
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        item = PySequence_ITEM (points, i);
+        if (!Sint16FromSeqIndex (item, 0, &x) ||
+            !Sint16FromSeqIndex (item, 1, &y))
+        {
+            Py_XDECREF (item);
+            goto fail;
+        }
+        Py_DECREF (item);
+        item = PySequence_ITEM (texcoords, i);
+        if (!item || !TwoFloatsFromObj (item, &u, &v))
+        {
+            Py_XDECREF (item);
+            if (!PyErr_Occurred ())
+                PyErr_SetString (PyExc_TypeError,
+                    "texcoords must contain (u, v) pairs");
+            goto fail;
+        }
+        Py_DECREF (item);
+        /* Keep u * 65536 inside Sint32, and reject NaN. */
+        if (!(u > -32767.0f && u < 32767.0f && v > -32767.0f && v < 32767.0f))
+        {
+            PyErr_SetString (PyExc_ValueError,
+                "texture coordinate out of range");
+            goto fail;
+        }
+
+        /* Scatter the vertex to every triangle corner it belongs to. */
+        for (k = 0; k < ncorners; k++)
+        {
+            if (corners[k] == i % nsides)
+            {
+                j = (i / nsides) * ncorners + k;
+                vx[j] = x;
+                vy[j] = y;
+                vu[j] = (Sint32) (u * 65536.0f);
+                vv[j] = (Sint32) (v * 65536.0f);
+            }
+        }
+    }
+
+    Py_BEGIN_ALLOW_THREADS;
+    ret = texturedTriangles (s_surface, vx, vy, vu, vv,
+                             (int) (npoly * ncorners), s_texture, bilinear);
+    Py_END_ALLOW_THREADS;
+
+    PyMem_Free (vx);
+    PyMem_Free (vy);
+    PyMem_Free (vu);
+    PyMem_Free (vv);
+
+    if (ret == -1)
+    {
+        PyErr_SetString (PyExc_SDLError, SDL_GetError ());
+        return NULL;
+    }
+    Py_RETURN_NONE;
+
+fail:
+    PyMem_Free (vx);
+    PyMem_Free (vy);
+    PyMem_Free (vu);
+    PyMem_Free (vv);
+    return NULL;
+}
+
+static PyObject*
+_gfx_texturedtriangles (PyObject *self, PyObject* args)
+{
+    return _gfx_texturedmesh (args, "OOOO|i:textured_triangles", 3,
+                              _triangle_corners, 3);
+}
+
+static PyObject*
+_gfx_texturedquads (PyObject *self, PyObject* args)
+{
+    return _gfx_texturedmesh (args, "OOOO|i:textured_quads", 4,
+                              _quad_corners, 6);
+}
+
+
 static PyObject*
 _gfx_beziercolor (PyObject *self, PyObject* args)
 {
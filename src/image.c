@@ -48,6 +48,30 @@ static SDL_Surface* opengltosdl (void);
     ((flipped) ? (((char*) data) + (height - row - 1) * width) : \
      (((char*) data) + row * width))
 
+/* SSE2 is part of the x86-64 baseline. 32 bit x86 gcc builds compile the
+ * swizzle for SSE2 per function and rely on the SDL_HasSSE2 check.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_SSE2_SUPPORT
+#define IMAGE_SSE2_TARGET
+#elif defined(__GNUC__) && !defined(__clang__) && defined(__i386__) && \
+      (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define IMAGE_SSE2_SUPPORT
+#define IMAGE_SSE2_TARGET __attribute__((target("sse2")))
+#endif
+
+#if defined(IMAGE_SSE2_SUPPORT)
+#include <emmintrin.h>
+#endif
+
+/* mask of the pixel byte found at offset index in memory */
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define BYTEMASK(bpp, index) ((Uint32)0xFF << ((index) * 8))
+#else
+#define BYTEMASK(bpp, index) ((Uint32)0xFF << (((bpp) - 1 - (index)) * 8))
+#endif
+
 static PyObject*
 image_load_basic(PyObject *self, PyObject *arg)
 {
@@ -302,6 +326,156 @@ image_get_extended (PyObject* self, PyObject* arg)
     return PyInt_FromLong (GETSTATE (self)->is_extended);
 }
 
+/* Test if the bytes of each pixel are already in the order of a string
+ * format, so tostring can copy rows as they are and tobuffer can expose
+ * them. Without per pixel alpha the unused byte of a 32 bit Surface only
+ * stands in for "RGBX" when x_any is set, as tostring writes 255 there.
+ */
+static int
+layout_matches (SDL_PixelFormat *fmt, const char *format, int x_any)
+{
+    int bpp = fmt->BytesPerPixel;
+
+    if (!strcmp (format, "P"))
+        return bpp == 1;
+    if (!strcmp (format, "RGB"))
+        return (bpp == 3 && fmt->Rmask == BYTEMASK (3, 0) &&
+                fmt->Gmask == BYTEMASK (3, 1) &&
+                fmt->Bmask == BYTEMASK (3, 2));
+    if (bpp != 4)
+        return 0;
+    if (!strcmp (format, "RGBA") || !strcmp (format, "RGBX"))
+    {
+        if (fmt->Rmask != BYTEMASK (4, 0) || fmt->Gmask != BYTEMASK (4, 1) ||
+            fmt->Bmask != BYTEMASK (4, 2))
+            return 0;
+        if (fmt->Amask == BYTEMASK (4, 3))
+            return 1;
+        return x_any && fmt->Amask == 0 && !strcmp (format, "RGBX");
+    }
+    if (!strcmp (format, "ARGB"))
+        return (fmt->Amask == BYTEMASK (4, 0) &&
+                fmt->Rmask == BYTEMASK (4, 1) &&
+                fmt->Gmask == BYTEMASK (4, 2) &&
+                fmt->Bmask == BYTEMASK (4, 3));
+    return 0;
+}
+
+#if defined(IMAGE_SSE2_SUPPORT)
+static int
+is_bytelane_mask (Uint32 mask)
+{
+    return (mask == 0xFF || mask == 0xFF00 ||
+            mask == 0xFF0000 || mask == 0xFF000000);
+}
+
+/* Reorder the channels of 32 bit pixels with whole byte channels into
+ * "RGB", "RGBX", "RGBA" or "ARGB" data, four pixels at a time. The
+ * results match the generic loops in image_tostring.
+ */
+static IMAGE_SSE2_TARGET void
+swizzle_rows_sse2 (SDL_Surface *surf, char *data, const char *format,
+                   int flipped)
+{
+    SDL_PixelFormat *fmt = surf->format;
+    int rgb = !strcmp (format, "RGB");
+    int argb = !strcmp (format, "ARGB");
+    int rdst = argb ? 8 : 0;
+    int gdst = argb ? 16 : 8;
+    int bdst = argb ? 24 : 16;
+    int adst = argb ? 0 : 24;
+    Uint32 opaque = fmt->Amask ? 0 : (rgb ? 0 : (Uint32)0xFF << adst);
+    __m128i ff = _mm_set1_epi32 (0xFF);
+    __m128i rsrc_v = _mm_cvtsi32_si128 (fmt->Rshift);
+    __m128i gsrc_v = _mm_cvtsi32_si128 (fmt->Gshift);
+    __m128i bsrc_v = _mm_cvtsi32_si128 (fmt->Bshift);
+    __m128i asrc_v = _mm_cvtsi32_si128 (fmt->Ashift);
+    __m128i rdst_v = _mm_cvtsi32_si128 (rdst);
+    __m128i gdst_v = _mm_cvtsi32_si128 (gdst);
+    __m128i bdst_v = _mm_cvtsi32_si128 (bdst);
+    __m128i adst_v = _mm_cvtsi32_si128 (adst);
+    __m128i opaque_v = _mm_set1_epi32 ((int)opaque);
+    Uint8 *dst = (Uint8 *)data;
+    int w, h;
+
+    for (h = 0; h < surf->h; ++h)
+    {
+        Uint32 *ptr = (Uint32 *)DATAROW (surf->pixels, h, surf->pitch,
+                                         surf->h, flipped);
+
+        for (w = 0; w + 4 <= surf->w; w += 4)
+        {
+            __m128i p = _mm_loadu_si128 ((const __m128i *)(ptr + w));
+            __m128i out = opaque_v;
+
+            out = _mm_or_si128 (out, _mm_sll_epi32 (_mm_and_si128 (
+                      _mm_srl_epi32 (p, rsrc_v), ff), rdst_v));
+            out = _mm_or_si128 (out, _mm_sll_epi32 (_mm_and_si128 (
+                      _mm_srl_epi32 (p, gsrc_v), ff), gdst_v));
+            out = _mm_or_si128 (out, _mm_sll_epi32 (_mm_and_si128 (
+                      _mm_srl_epi32 (p, bsrc_v), ff), bdst_v));
+            if (fmt->Amask && !rgb)
+                out = _mm_or_si128 (out, _mm_sll_epi32 (_mm_and_si128 (
+                          _mm_srl_epi32 (p, asrc_v), ff), adst_v));
+            if (rgb)
+            {
+                /* pack four 0BGR words into three words of RGB bytes */
+                Uint32 t[4], packed[3];
+
+                _mm_storeu_si128 ((__m128i *)t, out);
+                packed[0] = t[0] | (t[1] << 24);
+                packed[1] = (t[1] >> 8) | (t[2] << 16);
+                packed[2] = (t[2] >> 16) | (t[3] << 8);
+                memcpy (dst, packed, 12);
+                dst += 12;
+            }
+            else
+            {
+                _mm_storeu_si128 ((__m128i *)dst, out);
+                dst += 16;
+            }
+        }
+        for (; w < surf->w; ++w)
+        {
+            Uint32 color = ptr[w];
+            Uint32 out = opaque;
+
+            out |= ((color >> fmt->Rshift) & 0xFF) << rdst;
+            out |= ((color >> fmt->Gshift) & 0xFF) << gdst;
+            out |= ((color >> fmt->Bshift) & 0xFF) << bdst;
+            if (fmt->Amask && !rgb)
+                out |= ((color >> fmt->Ashift) & 0xFF) << adst;
+            memcpy (dst, &out, rgb ? 3 : 4);
+            dst += rgb ? 3 : 4;
+        }
+    }
+}
+#endif /* IMAGE_SSE2_SUPPORT */
+
+/* Test if swizzle_rows_sse2 can convert the Surface to format */
+static int
+can_swizzle (SDL_PixelFormat *fmt, const char *format, int hascolorkey)
+{
+#if defined(IMAGE_SSE2_SUPPORT)
+    static int has_sse2 = -1;
+
+    if (has_sse2 < 0)
+        has_sse2 = SDL_HasSSE2 () ? 1 : 0;
+    if (!has_sse2 || fmt->BytesPerPixel != 4)
+        return 0;
+    if (!is_bytelane_mask (fmt->Rmask) || !is_bytelane_mask (fmt->Gmask) ||
+        !is_bytelane_mask (fmt->Bmask) ||
+        (fmt->Amask && !is_bytelane_mask (fmt->Amask)))
+        return 0;
+    if (!strcmp (format, "RGBA"))
+        return !hascolorkey;
+    return (!strcmp (format, "RGB") || !strcmp (format, "RGBX") ||
+            !strcmp (format, "ARGB"));
+#else
+    return 0;
+#endif
+}
+
 PyObject*
 image_tostring (PyObject* self, PyObject* arg)
 {
@@ -341,6 +515,47 @@ image_tostring (PyObject* self, PyObject* arg)
     hascolorkey = (surf->flags & SDL_SRCCOLORKEY) && !Amask;
     colorkey = surf->format->colorkey;
 
+    /* Whole rows are copied when the pixels are already in the requested
+     * order, and 32 bit pixels are reordered with SSE2 where possible.
+     */
+    if (strcmp (format, "P") &&
+        (layout_matches (surf->format, format, 0) ||
+         can_swizzle (surf->format, format, hascolorkey)))
+    {
+        int bpp = strcmp (format, "RGB") ? 4 : 3;
+        int rowlen = surf->w * bpp;
+
+        string = Bytes_FromStringAndSize (NULL, rowlen * surf->h);
+        if (!string)
+        {
+            if (temp)
+                SDL_FreeSurface (temp);
+            return NULL;
+        }
+        Bytes_AsStringAndSize (string, &data, &len);
+
+        if (!temp)
+            PySurface_Lock (surfobj);
+        if (layout_matches (surf->format, format, 0))
+        {
+            for (h = 0; h < surf->h; ++h)
+                memcpy (data + h * rowlen,
+                        DATAROW (surf->pixels, h, surf->pitch, surf->h,
+                                 flipped), rowlen);
+        }
+#if defined(IMAGE_SSE2_SUPPORT)
+        else
+        {
+            swizzle_rows_sse2 (surf, data, format, flipped);
+        }
+#endif
+        if (!temp)
+            PySurface_Unlock (surfobj);
+        if (temp)
+            SDL_FreeSurface (temp);
+        return string;
+    }
+
     if (!strcmp (format, "P"))
     {
         if (surf->format->BytesPerPixel != 1)
@@ -805,6 +1020,33 @@ image_tostring (PyObject* self, PyObject* arg)
     return string;
 }
 
+PyObject*
+image_tobuffer (PyObject* self, PyObject* arg)
+{
+    PyObject *surfobj;
+    char *format;
+    SDL_Surface *surf;
+
+    if (!PyArg_ParseTuple (arg, "O!s", &PySurface_Type, &surfobj, &format))
+        return NULL;
+    surf = PySurface_AsSurface (surfobj);
+    if (!surf)
+        return RAISE (PyExc_SDLError, "display Surface quit");
+    if (surf->flags & SDL_OPENGL)
+        return RAISE (PyExc_ValueError,
+                      "Cannot share the pixels of an OpenGL Surface");
+    if (strcmp (format, "P") && strcmp (format, "RGB") &&
+        strcmp (format, "RGBX") && strcmp (format, "RGBA") &&
+        strcmp (format, "ARGB"))
+        return RAISE (PyExc_ValueError, "Unrecognized type of format");
+    if (!layout_matches (surf->format, format, 1))
+        return RAISE (PyExc_ValueError,
+                      "Surface pixel layout does not match format");
+
+    /* the view checks the rows are contiguous and locks the Surface */
+    return PyObject_CallMethod (surfobj, "get_view", "s", "0");
+}
+
 PyObject*
 image_fromstring (PyObject* self, PyObject* arg)
 {
@@ -972,17 +1214,11 @@ image_frombuffer (PyObject* self, PyObject* arg)
                 (PyExc_ValueError,
                  "Buffer length does not equal format and resolution size");
         surf = SDL_CreateRGBSurfaceFrom (data, w, h, 24, w * 3,
-                                         0xFF, 0xFF<<8, 0xFF<<16, 0);
-/*
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                                         0xFF, 0xFF<<8, 0xFF<<16, 0xFF<<24
+                                         0xFF, 0xFF<<8, 0xFF<<16, 0);
 #else
-                                         0xFF<<24, 0xFF<<16, 0xFF<<8, 0xFF
+                                         0xFF<<16, 0xFF<<8, 0xFF, 0);
 #endif
-               );
-
-*/
-
 
     }
     else if (!strcmp (format, "RGBA") || !strcmp (format, "RGBX"))
@@ -1000,7 +1236,7 @@ image_frombuffer (PyObject* self, PyObject* arg)
                                          0xFF<<24, 0xFF<<16, 0xFF<<8,
                                          (alphamult ? 0xFF : 0));
 #endif
-        if(alphamult)
+        if (surf && alphamult)
             surf->flags |= SDL_SRCALPHA;
     }
     else if (!strcmp (format, "ARGB"))
@@ -1011,11 +1247,12 @@ image_frombuffer (PyObject* self, PyObject* arg)
                  "Buffer length does not equal format and resolution size");
         surf = SDL_CreateRGBSurfaceFrom (data, w, h, 32, w*4,
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
-                                         0xFF<<24, 0xFF, 0xFF<<8, 0xFF<<16);
+                                         0xFF<<8, 0xFF<<16, 0xFF<<24, 0xFF);
 #else
-                                         0xFF, 0xFF<<24, 0xFF<<16, 0xFF<<8);
+                                         0xFF<<16, 0xFF<<8, 0xFF, 0xFF<<24);
 #endif
-        surf->flags |= SDL_SRCALPHA;
+        if (surf)
+            surf->flags |= SDL_SRCALPHA;
     }
     else
         return RAISE(PyExc_ValueError, "Unrecognized type of format");
@@ -1023,6 +1260,11 @@ image_frombuffer (PyObject* self, PyObject* arg)
     if (!surf)
         return RAISE (PyExc_SDLError, SDL_GetError ());
     surfobj = PySurface_New (surf);
+    if (!surfobj)
+    {
+        SDL_FreeSurface (surf);
+        return NULL;
+    }
     Py_INCREF (buffer);
     ((PySurfaceObject*) surfobj)->dependency = buffer;
     return surfobj;
@@ -1311,6 +1553,7 @@ static PyMethodDef _image_methods[] =
       DOC_PYGAMEIMAGEGETEXTENDED },
 
     { "tostring", image_tostring, METH_VARARGS, DOC_PYGAMEIMAGETOSTRING },
+    { "tobuffer", image_tobuffer, METH_VARARGS, DOC_PYGAMEIMAGETOBUFFER },
     { "fromstring", image_fromstring, METH_VARARGS, DOC_PYGAMEIMAGEFROMSTRING },
     { "frombuffer", image_frombuffer, METH_VARARGS, DOC_PYGAMEIMAGEFROMBUFFER },
 
@@ -1407,6 +1650,42 @@ MODINIT_DEFINE (image)
             Py_DECREF (extmodule);
             MODINIT_ERROR;
         }
+        extload = PyObject_GetAttrString (extmodule, "save_png");
+        if (!extload)
+        {
+            Py_DECREF (extmodule);
+            MODINIT_ERROR;
+        }
+        if (PyModule_AddObject (module, "save_png", extload))
+        {
+            Py_DECREF (extload);
+            Py_DECREF (extmodule);
+            MODINIT_ERROR;
+        }
+        extload = PyObject_GetAttrString (extmodule, "load_async");
+        if (!extload)
+        {
+            Py_DECREF (extmodule);
+            MODINIT_ERROR;
+        }
+        if (PyModule_AddObject (module, "load_async", extload))
+        {
+            Py_DECREF (extload);
+            Py_DECREF (extmodule);
+            MODINIT_ERROR;
+        }
+        extload = PyObject_GetAttrString (extmodule, "set_async_threads");
+        if (!extload)
+        {
+            Py_DECREF (extmodule);
+            MODINIT_ERROR;
+        }
+        if (PyModule_AddObject (module, "set_async_threads", extload))
+        {
+            Py_DECREF (extload);
+            Py_DECREF (extmodule);
+            MODINIT_ERROR;
+        }
         Py_DECREF (extmodule);
         st->is_extended = 1;
     }
@@ -1417,6 +1696,12 @@ MODINIT_DEFINE (image)
         PyModule_AddObject (module, "load_extended", Py_None);
         PyModule_AddObject (module, "save_extended", Py_None);
         PyModule_AddObject (module, "load", basicload);
+        Py_INCREF (Py_None);
+        PyModule_AddObject (module, "save_png", Py_None);
+        Py_INCREF (Py_None);
+        PyModule_AddObject (module, "load_async", Py_None);
+        Py_INCREF (Py_None);
+        PyModule_AddObject (module, "set_async_threads", Py_None);
         st->is_extended = 0;
     }
     MODINIT_RETURN (module);
@@ -162,6 +162,364 @@ image_load_ext(PyObject *self, PyObject *arg)
     return final;
 }
 
+/* Background loading
+ *
+ * load_async queues a job for a small pool of SDL threads, which decode
+ * the file with IMG_Load while the interpreter runs on. The workers
+ * never touch Python objects, so they run without the GIL. A job is
+ * shared by the AsyncLoad object returned to the caller and the pool,
+ * and freed by whichever lets go of it last; a job still queued when
+ * its AsyncLoad is dropped is simply discarded.
+ */
+#define ASYNC_MAX_THREADS 16
+
+typedef struct loadjob_ {
+    char *filename;
+    SDL_Surface *surf;
+    char *error;
+    int done;
+    int refs;
+    struct loadjob_ *next;
+} LoadJob;
+
+typedef struct {
+    PyObject_HEAD
+    LoadJob *job;
+    PyObject *result;
+} PyAsyncLoadObject;
+
+static PyTypeObject PyAsyncLoad_Type;
+
+static SDL_mutex *pool_lock = NULL;
+static SDL_cond *pool_job_ready = NULL;
+static SDL_cond *pool_job_done = NULL;
+static LoadJob *pool_head = NULL;
+static LoadJob *pool_tail = NULL;
+static int pool_threads = 0;
+static int pool_idle = 0;
+static int pool_busy = 0;
+static int pool_limit = 2;
+
+static void
+free_job(LoadJob *job)
+{
+    if (job->surf != NULL) {
+        SDL_FreeSurface(job->surf);
+    }
+    free(job->error);
+    free(job->filename);
+    free(job);
+}
+
+static int
+load_worker(void *unused)
+{
+    LoadJob *job;
+    SDL_Surface *surf;
+    const char *error;
+
+    SDL_mutexP(pool_lock);
+    for (;;) {
+        /* Threads above a lowered limit stay idle rather than exit */
+        while (pool_head == NULL || pool_busy >= pool_limit) {
+            ++pool_idle;
+            SDL_CondWait(pool_job_ready, pool_lock);
+            --pool_idle;
+        }
+        job = pool_head;
+        pool_head = job->next;
+        if (pool_head == NULL) {
+            pool_tail = NULL;
+        }
+        ++pool_busy;
+        SDL_mutexV(pool_lock);
+
+        surf = IMG_Load(job->filename);
+        error = surf == NULL ? IMG_GetError() : NULL;
+
+        SDL_mutexP(pool_lock);
+        --pool_busy;
+        job->surf = surf;
+        if (error != NULL) {
+            job->error = (char *)malloc(strlen(error) + 1);
+            if (job->error != NULL) {
+                strcpy(job->error, error);
+            }
+        }
+        job->done = 1;
+        if (--job->refs == 0) {
+            free_job(job);
+        }
+        SDL_CondBroadcast(pool_job_done);
+        if (pool_head != NULL) {
+            SDL_CondSignal(pool_job_ready);
+        }
+    }
+    /* Workers live as long as the process */
+    return 0;
+}
+
+/* Called with pool_lock held */
+static int
+queue_job(LoadJob *job)
+{
+    if (pool_idle == 0 && pool_threads < pool_limit) {
+        if (SDL_CreateThread(load_worker, NULL) != NULL) {
+            ++pool_threads;
+        }
+        else if (pool_threads == 0) {
+            return -1;
+        }
+    }
+    job->next = NULL;
+    if (pool_tail != NULL) {
+        pool_tail->next = job;
+    }
+    else {
+        pool_head = job;
+    }
+    pool_tail = job;
+    SDL_CondSignal(pool_job_ready);
+    return 0;
+}
+
+/* Called with pool_lock held. Returns 1 if the job was still queued */
+static int
+unqueue_job(LoadJob *job)
+{
+    LoadJob **link = &pool_head;
+    LoadJob *prev = NULL;
+
+    while (*link != NULL && *link != job) {
+        prev = *link;
+        link = &prev->next;
+    }
+    if (*link == NULL) {
+        return 0;
+    }
+    *link = job->next;
+    if (pool_tail == job) {
+        pool_tail = prev;
+    }
+    return 1;
+}
+
+static int
+init_pool(void)
+{
+    if (pool_lock != NULL) {
+        return 0;
+    }
+#if (SDL_IMAGE_MAJOR_VERSION * 1000 + SDL_IMAGE_MINOR_VERSION * 100 + \
+     SDL_IMAGE_PATCHLEVEL) >= 1210
+    /* Load the codec libraries here, as IMG_Load would do it lazily
+     * and without a lock on whichever thread gets there first.
+     */
+    IMG_Init(IMG_INIT_JPG | IMG_INIT_PNG | IMG_INIT_TIF);
+#endif
+    pool_job_ready = SDL_CreateCond();
+    pool_job_done = SDL_CreateCond();
+    pool_lock = SDL_CreateMutex();
+    if (pool_lock == NULL || pool_job_ready == NULL || pool_job_done == NULL) {
+        if (pool_lock != NULL) {
+            SDL_DestroyMutex(pool_lock);
+            pool_lock = NULL;
+        }
+        if (pool_job_ready != NULL) {
+            SDL_DestroyCond(pool_job_ready);
+        }
+        if (pool_job_done != NULL) {
+            SDL_DestroyCond(pool_job_done);
+        }
+        RAISE(PyExc_SDLError, SDL_GetError());
+        return -1;
+    }
+    return 0;
+}
+
+static PyObject*
+image_load_async(PyObject *self, PyObject *arg)
+{
+    PyObject *obj;
+    PyObject *oencoded;
+    PyAsyncLoadObject *loadobj;
+    LoadJob *job;
+    int result;
+
+    if (!PyArg_ParseTuple(arg, "O", &obj)) {
+        return NULL;
+    }
+    if (init_pool()) {
+        return NULL;
+    }
+
+    oencoded = RWopsEncodeFilePath(obj, PyExc_SDLError);
+    if (oencoded == NULL) {
+        return NULL;
+    }
+    if (oencoded == Py_None) {
+        Py_DECREF(oencoded);
+        return RAISE(PyExc_TypeError,
+                     "load_async needs a file name, not a file object");
+    }
+
+    job = (LoadJob *)calloc(1, sizeof(LoadJob));
+    if (job == NULL) {
+        Py_DECREF(oencoded);
+        return PyErr_NoMemory();
+    }
+    job->filename = (char *)malloc(Bytes_GET_SIZE(oencoded) + 1);
+    if (job->filename == NULL) {
+        Py_DECREF(oencoded);
+        free(job);
+        return PyErr_NoMemory();
+    }
+    strcpy(job->filename, Bytes_AS_STRING(oencoded));
+    Py_DECREF(oencoded);
+    job->refs = 2;
+
+    loadobj = PyObject_NEW(PyAsyncLoadObject, &PyAsyncLoad_Type);
+    if (loadobj == NULL) {
+        free_job(job);
+        return NULL;
+    }
+    loadobj->job = job;
+    loadobj->result = NULL;
+
+    SDL_mutexP(pool_lock);
+    result = queue_job(job);
+    SDL_mutexV(pool_lock);
+    if (result) {
+        job->refs = 1;
+        Py_DECREF(loadobj);
+        return RAISE(PyExc_SDLError, SDL_GetError());
+    }
+    return (PyObject *)loadobj;
+}
+
+static PyObject*
+image_set_async_threads(PyObject *self, PyObject *arg)
+{
+    int count;
+
+    if (!PyArg_ParseTuple(arg, "i", &count)) {
+        return NULL;
+    }
+    if (count < 1 || count > ASYNC_MAX_THREADS) {
+        PyErr_Format(PyExc_ValueError,
+                     "thread count must be between 1 and %d",
+                     ASYNC_MAX_THREADS);
+        return NULL;
+    }
+    if (init_pool()) {
+        return NULL;
+    }
+    SDL_mutexP(pool_lock);
+    pool_limit = count;
+    SDL_CondBroadcast(pool_job_ready);
+    SDL_mutexV(pool_lock);
+    Py_RETURN_NONE;
+}
+
+static void
+asyncload_dealloc(PyAsyncLoadObject *self)
+{
+    LoadJob *job = self->job;
+
+    if (job != NULL) {
+        SDL_mutexP(pool_lock);
+        if (unqueue_job(job)) {
+            --job->refs;
+        }
+        if (--job->refs == 0) {
+            free_job(job);
+        }
+        SDL_mutexV(pool_lock);
+    }
+    Py_XDECREF(self->result);
+    PyObject_DEL(self);
+}
+
+static PyObject*
+asyncload_done(PyAsyncLoadObject *self)
+{
+    int done;
+
+    SDL_mutexP(pool_lock);
+    done = self->job->done;
+    SDL_mutexV(pool_lock);
+    return PyBool_FromLong(done);
+}
+
+static PyObject*
+asyncload_result(PyAsyncLoadObject *self)
+{
+    LoadJob *job = self->job;
+
+    if (self->result == NULL) {
+        Py_BEGIN_ALLOW_THREADS;
+        SDL_mutexP(pool_lock);
+        while (!job->done) {
+            SDL_CondWait(pool_job_done, pool_lock);
+        }
+        SDL_mutexV(pool_lock);
+        Py_END_ALLOW_THREADS;
+
+        if (job->surf == NULL) {
+            return RAISE(PyExc_SDLError,
+                         job->error ? job->error : "Out of memory");
+        }
+        self->result = PySurface_New(job->surf);
+        if (self->result == NULL) {
+            return NULL;
+        }
+        job->surf = NULL;
+    }
+    Py_INCREF(self->result);
+    return self->result;
+}
+
+static PyMethodDef asyncload_methods[] =
+{
+    { "done", (PyCFunction) asyncload_done, METH_NOARGS,
+      DOC_ASYNCLOADDONE },
+    { "result", (PyCFunction) asyncload_result, METH_NOARGS,
+      DOC_ASYNCLOADRESULT },
+    { NULL, NULL, 0, NULL }
+};
+
+static PyTypeObject PyAsyncLoad_Type =
+{
+    TYPE_HEAD (NULL, 0)
+    "AsyncLoad",                /* name */
+    sizeof(PyAsyncLoadObject),  /* basic size */
+    0,                          /* itemsize */
+    (destructor)asyncload_dealloc, /* dealloc */
+    0,                          /* print */
+    0,                          /* getattr */
+    0,                          /* setattr */
+    0,                          /* compare */
+    0,                          /* repr */
+    0,                          /* as_number */
+    0,                          /* as_sequence */
+    0,                          /* as_mapping */
+    0,                          /* hash */
+    0,                          /* call */
+    0,                          /* str */
+    0,                          /* tp_getattro */
+    0,                          /* tp_setattro */
+    0,                          /* tp_as_buffer */
+    0,                          /* flags */
+    DOC_PYGAMEIMAGEASYNCLOAD,   /* Documentation string */
+    0,                          /* tp_traverse */
+    0,                          /* tp_clear */
+    0,                          /* tp_richcompare */
+    0,                          /* tp_weaklistoffset */
+    0,                          /* tp_iter */
+    0,                          /* tp_iternext */
+    asyncload_methods,          /* tp_methods */
+};
+
 #ifdef PNG_H
 
 static void
@@ -184,13 +542,33 @@ png_flush_fn (png_structp png_ptr)
     }
 }
 
+/* Encoder settings, or -1 to keep the libpng default */
+typedef struct {
+    int level;
+    int filters;
+    int strategy;
+} PNGOptions;
+
+static const PNGOptions png_default_options = { -1, -1, -1 };
+
+/* Screenshots are mostly flat areas and repeated runs, which the SUB
+ * filter and run length matching handle nearly as well as the default
+ * search, at a fraction of the time.
+ */
+#ifdef Z_RLE
+static const PNGOptions png_fast_options = { 1, PNG_FILTER_SUB, Z_RLE };
+#else
+static const PNGOptions png_fast_options = { 1, PNG_FILTER_SUB, -1 };
+#endif
+
 static int
 write_png (const char *file_name,
            png_bytep *rows,
            int w,
            int h,
            int colortype,
-           int bitdepth)
+           int bitdepth,
+           const PNGOptions *options)
 {
     png_structp png_ptr = NULL;
     png_infop info_ptr =  NULL;
@@ -214,6 +592,13 @@ write_png (const char *file_name,
     doing = "init IO";
     png_set_write_fn (png_ptr, fp, png_write_fn, png_flush_fn);
 
+    if (options->level >= 0)
+        png_set_compression_level (png_ptr, options->level);
+    if (options->filters >= 0)
+        png_set_filter (png_ptr, PNG_FILTER_TYPE_BASE, options->filters);
+    if (options->strategy >= 0)
+        png_set_compression_strategy (png_ptr, options->strategy);
+
     doing = "write header";
     png_set_IHDR (png_ptr, info_ptr, w, h, bitdepth, colortype,
                   PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE,
@@ -249,12 +634,13 @@ fail:
     return -1;
 }
 
+/* The surface is copied with the GIL held, then encoded without it */
 static int
-SavePNG (SDL_Surface *surface, const char *file)
+SavePNG (SDL_Surface *surface, const char *file, const PNGOptions *options)
 {
-    static unsigned char** ss_rows;
-    static int ss_size;
-    static int ss_w, ss_h;
+    unsigned char** ss_rows;
+    int ss_size;
+    int ss_w, ss_h;
     SDL_Surface *ss_surface;
     SDL_Rect ss_rect;
     int r, i;
@@ -331,16 +717,18 @@ SavePNG (SDL_Surface *surface, const char *file)
             i * ss_surface->pitch;
     }
 
+    Py_BEGIN_ALLOW_THREADS;
     if (alpha)
     {
-        r = write_png (file, ss_rows, surface->w, surface->h,
-                       PNG_COLOR_TYPE_RGB_ALPHA, 8);
+        r = write_png (file, ss_rows, ss_w, ss_h,
+                       PNG_COLOR_TYPE_RGB_ALPHA, 8, options);
     }
     else
     {
-        r = write_png (file, ss_rows, surface->w, surface->h,
-                       PNG_COLOR_TYPE_RGB, 8);
+        r = write_png (file, ss_rows, ss_w, ss_h,
+                       PNG_COLOR_TYPE_RGB, 8, options);
     }
+    Py_END_ALLOW_THREADS;
 
     free (ss_rows);
     SDL_FreeSurface (ss_surface);
@@ -739,9 +1127,7 @@ image_save_ext(PyObject *self, PyObject *arg)
                   (name[namelen - 2]=='n' || name[namelen - 2]=='N') &&
                   (name[namelen - 3]=='p' || name[namelen - 3]=='P')))  {
 #ifdef PNG_H
-            /*Py_BEGIN_ALLOW_THREADS; */
-            result = SavePNG(surf, name);
-            /*Py_END_ALLOW_THREADS; */
+            result = SavePNG(surf, name, &png_default_options);
 #else
             RAISE(PyExc_SDLError, "No support for png compiled in.");
             result = -2;
@@ -775,10 +1161,120 @@ image_save_ext(PyObject *self, PyObject *arg)
     Py_RETURN_NONE;
 }
 
+#ifdef PNG_H
+static const struct {
+    const char *name;
+    int filters;
+} png_filter_names[] = {
+    { "none", PNG_FILTER_NONE },
+    { "sub", PNG_FILTER_SUB },
+    { "up", PNG_FILTER_UP },
+    { "avg", PNG_FILTER_AVG },
+    { "paeth", PNG_FILTER_PAETH },
+    { "adaptive", PNG_ALL_FILTERS },
+    { NULL, 0 }
+};
+#endif
+
+static PyObject*
+image_save_png(PyObject *self, PyObject *arg, PyObject *kwds)
+{
+#ifdef PNG_H
+    PyObject *surfobj;
+    PyObject *obj;
+    PyObject *oencoded;
+    SDL_Surface *surf;
+    SDL_Surface *temp = NULL;
+    int level = -2;
+    char *filter = NULL;
+    int fast = 0;
+    PNGOptions options;
+    int result;
+    int i;
+    static char *kwids[] = { "surface", "filename", "level",
+                             "filter", "fast", NULL };
+
+    if (!PyArg_ParseTupleAndKeywords(arg, kwds, "O!O|izi", kwids,
+                                     &PySurface_Type, &surfobj, &obj,
+                                     &level, &filter, &fast)) {
+        return NULL;
+    }
+
+    options = fast ? png_fast_options : png_default_options;
+    if (level != -2) {
+        if (level < -1 || level > 9) {
+            return RAISE(PyExc_ValueError,
+                         "compression level must be between -1 and 9");
+        }
+        options.level = level;
+    }
+    if (filter != NULL) {
+        for (i = 0; png_filter_names[i].name != NULL; ++i) {
+            if (strcmp(filter, png_filter_names[i].name) == 0) {
+                break;
+            }
+        }
+        if (png_filter_names[i].name == NULL) {
+            PyErr_Format(PyExc_ValueError,
+                         "unknown PNG filter '%.100s'", filter);
+            return NULL;
+        }
+        options.filters = png_filter_names[i].filters;
+    }
+
+    oencoded = RWopsEncodeFilePath(obj, PyExc_SDLError);
+    if (oencoded == NULL) {
+        return NULL;
+    }
+    if (oencoded == Py_None) {
+        Py_DECREF(oencoded);
+        PyErr_Format(PyExc_TypeError,
+                     "Expected a string for the file argument: got %.1024s",
+                     Py_TYPE(obj)->tp_name);
+        return NULL;
+    }
+
+    surf = PySurface_AsSurface(surfobj);
+    if (surf->flags & SDL_OPENGL) {
+        temp = surf = opengltosdl();
+        if (surf == NULL) {
+            Py_DECREF(oencoded);
+            return NULL;
+        }
+    }
+    else {
+        PySurface_Prep(surfobj);
+    }
+
+    result = SavePNG(surf, Bytes_AS_STRING(oencoded), &options);
+
+    if (temp != NULL) {
+        SDL_FreeSurface(temp);
+    }
+    else {
+        PySurface_Unprep(surfobj);
+    }
+    Py_DECREF(oencoded);
+
+    if (result == -1) {
+        return RAISE(PyExc_SDLError, SDL_GetError());
+    }
+    Py_RETURN_NONE;
+#else
+    return RAISE(PyExc_SDLError, "No support for png compiled in.");
+#endif
+}
+
 static PyMethodDef _imageext_methods[] =
 {
     { "load_extended", image_load_ext, METH_VARARGS, DOC_PYGAMEIMAGE },
     { "save_extended", image_save_ext, METH_VARARGS, DOC_PYGAMEIMAGE },
+    { "save_png", (PyCFunction) image_save_png,
+      METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEIMAGESAVEPNG },
+    { "load_async", image_load_async, METH_VARARGS,
+      DOC_PYGAMEIMAGELOADASYNC },
+    { "set_async_threads", image_set_async_threads, METH_VARARGS,
+      DOC_PYGAMEIMAGESETASYNCTHREADS },
     { NULL, NULL, 0, NULL }
 };
 
@@ -816,6 +1312,9 @@ MODINIT_DEFINE (imageext)
     if (PyErr_Occurred ()) {
         MODINIT_ERROR;
     }
+    if (PyType_Ready (&PyAsyncLoad_Type) < 0) {
+        MODINIT_ERROR;
+    }
 
     /* create the module */
 #if PY3
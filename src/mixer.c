@@ -31,6 +31,23 @@
 
 #define PyBUF_HAS_FLAG(f, F) (((f) & (F)) == (F))
 
+/* SSE2 is part of the x86-64 baseline. 32 bit x86 gcc builds compile the
+ * sample conversions for SSE2 per function and check SDL_HasSSE2 first.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIXER_SSE2_SUPPORT
+#define MIXER_SSE2_TARGET
+#elif defined(__GNUC__) && !defined(__clang__) && defined(__i386__) && \
+      (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define MIXER_SSE2_SUPPORT
+#define MIXER_SSE2_TARGET __attribute__((target("sse2")))
+#endif
+
+#if defined(MIXER_SSE2_SUPPORT)
+#include <emmintrin.h>
+#endif
+
 /* The SDL audio format constants are not defined for anything larger
    than 2 byte samples. Define our own. Low two bytes gives sample
    size in bytes. Higher bytes are flags.
@@ -79,6 +96,7 @@ static int request_stereo = PYGAME_MIXER_DEFAULT_CHANNELS;
 static int request_chunksize = PYGAME_MIXER_DEFAULT_CHUNKSIZE;
 
 static int sound_init (PyObject* self, PyObject* arg, PyObject* kwarg);
+static void quit_streams (void);
 
 struct ChannelData
 {
@@ -90,7 +108,7 @@ static struct ChannelData *channeldata = NULL;
 static int numchanneldata = 0;
 
 Mix_Music** current_music;
-Mix_Music** queue_music;
+void (*clear_music_queue) (void) = NULL;
 
 static int
 _format_itemsize(Uint16 format)
@@ -273,7 +291,13 @@ autoquit(void)
     int i;
     if (SDL_WasInit (SDL_INIT_AUDIO))
     {
+        /* Halting the music would start the next queued track */
+        if (clear_music_queue)
+        {
+            clear_music_queue ();
+        }
         Mix_HaltMusic ();
+        quit_streams ();
 
         if (channeldata)
         {
@@ -296,15 +320,6 @@ autoquit(void)
             }
             current_music = NULL;
         }
-        if (queue_music)
-        {
-            if (*queue_music)
-            {
-                Mix_FreeMusic (*queue_music);
-                *queue_music = NULL;
-            }
-            queue_music = NULL;
-        }
 
         Mix_CloseAudio ();
         SDL_QuitSubSystem (SDL_INIT_AUDIO);
@@ -749,11 +764,18 @@ snd_getbuffer(PyObject *obj, Py_buffer *view, int flags)
     Py_ssize_t *strides = 0;
     Py_ssize_t itemsize;
     Py_ssize_t samples;
+    int readonly = (((PySoundObject *)obj)->view &&
+                    ((PySoundObject *)obj)->view->view.readonly);
 
     view->obj = 0;
     if (snd_buffer_iteminfo(&format, &itemsize, &channels)) {
         return -1;
     }
+    if (readonly && PyBUF_HAS_FLAG(flags, PyBUF_WRITABLE)) {
+        PyErr_SetString(PgExc_BufferError,
+                        "sound samples belong to a read-only buffer");
+        return -1;
+    }
     if (channels != 1 &&
         PyBUF_HAS_FLAG (flags, PyBUF_F_CONTIGUOUS)) {
         PyErr_SetString(PgExc_BufferError,
@@ -780,7 +802,7 @@ snd_getbuffer(PyObject *obj, Py_buffer *view, int flags)
     view->obj = obj;
     view->buf = chunk->abuf;
     view->len = (Py_ssize_t)chunk->alen;
-    view->readonly = 0;
+    view->readonly = readonly;
     view->itemsize = itemsize;
     view->format = PyBUF_HAS_FLAG(flags, PyBUF_FORMAT) ? format : 0;
     view->ndim = ndim;
@@ -829,6 +851,10 @@ sound_dealloc (PySoundObject* self)
         Mix_FreeChunk (chunk);
     if (self->mem)
         PyMem_Free (self->mem);
+    if (self->view) {
+        PgBuffer_Release (self->view);
+        PyMem_Free (self->view);
+    }
     if (self->weakreflist)
         PyObject_ClearWeakRefs ((PyObject*)self);
     Py_TYPE(self)->tp_free ((PyObject*)self);
@@ -1341,10 +1367,137 @@ _chunk_from_buf(const void *buf, Py_ssize_t len, Mix_Chunk **chunk, Uint8 **mem)
     return 0;
 }
 
+#if defined(MIXER_SSE2_SUPPORT)
+/* Convert a multiple of 16 samples for _convert_samples,
+ * returning how many were done.
+ */
+static MIXER_SSE2_TARGET Py_ssize_t
+_convert_samples_sse2(const Uint8 *src, int src_size,
+                      Uint8 *dst, int dst_size, Py_ssize_t count)
+{
+    Py_ssize_t i;
+    Py_ssize_t n = count & ~(Py_ssize_t)15;
+    __m128i zero = _mm_setzero_si128();
+    __m128i lowbyte16 = _mm_set1_epi16(0xFF);
+    __m128i lowbyte32 = _mm_set1_epi32(0xFF);
+    __m128i a, b, c, d;
+
+    if (dst_size == 1 && src_size == 2) {
+        for (i = 0; i < n; i += 16, src += 32, dst += 16) {
+            a = _mm_and_si128(_mm_loadu_si128((const __m128i *)src),
+                              lowbyte16);
+            b = _mm_and_si128(_mm_loadu_si128((const __m128i *)(src + 16)),
+                              lowbyte16);
+            _mm_storeu_si128((__m128i *)dst, _mm_packus_epi16(a, b));
+        }
+    }
+    else if (dst_size == 1 && src_size == 4) {
+        for (i = 0; i < n; i += 16, src += 64, dst += 16) {
+            a = _mm_and_si128(_mm_loadu_si128((const __m128i *)src),
+                              lowbyte32);
+            b = _mm_and_si128(_mm_loadu_si128((const __m128i *)(src + 16)),
+                              lowbyte32);
+            c = _mm_and_si128(_mm_loadu_si128((const __m128i *)(src + 32)),
+                              lowbyte32);
+            d = _mm_and_si128(_mm_loadu_si128((const __m128i *)(src + 48)),
+                              lowbyte32);
+            _mm_storeu_si128((__m128i *)dst,
+                             _mm_packus_epi16(_mm_packs_epi32(a, b),
+                                              _mm_packs_epi32(c, d)));
+        }
+    }
+    else if (dst_size == 2 && src_size == 1) {
+        for (i = 0; i < n; i += 16, src += 16, dst += 32) {
+            a = _mm_loadu_si128((const __m128i *)src);
+            _mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi8(zero, a));
+            _mm_storeu_si128((__m128i *)(dst + 16),
+                             _mm_unpackhi_epi8(zero, a));
+        }
+    }
+    else if (dst_size == 2 && src_size == 4) {
+        /* Sign extending the low half keeps packs_epi32 from saturating */
+        for (i = 0; i < n; i += 16, src += 64, dst += 32) {
+            a = _mm_loadu_si128((const __m128i *)src);
+            b = _mm_loadu_si128((const __m128i *)(src + 16));
+            c = _mm_loadu_si128((const __m128i *)(src + 32));
+            d = _mm_loadu_si128((const __m128i *)(src + 48));
+            a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+            b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+            c = _mm_srai_epi32(_mm_slli_epi32(c, 16), 16);
+            d = _mm_srai_epi32(_mm_slli_epi32(d, 16), 16);
+            _mm_storeu_si128((__m128i *)dst, _mm_packs_epi32(a, b));
+            _mm_storeu_si128((__m128i *)(dst + 16), _mm_packs_epi32(c, d));
+        }
+    }
+    else {
+        n = 0;
+    }
+    return n;
+}
+#endif /* MIXER_SSE2_SUPPORT */
+
+/* Convert count contiguous samples to the mixer sample size, truncating
+ * or widening them the same way as the strided loops in _chunk_from_array.
+ */
+static void
+_convert_samples(const Uint8 *src, int src_size,
+                 Uint8 *dst, int dst_size, Py_ssize_t count)
+{
+    Py_ssize_t i = 0;
+#if defined(MIXER_SSE2_SUPPORT)
+    static int has_sse2 = -1;
+
+    if (has_sse2 < 0)
+        has_sse2 = SDL_HasSSE2() ? 1 : 0;
+    if (has_sse2) {
+        i = _convert_samples_sse2(src, src_size, dst, dst_size, count);
+        src += i * src_size;
+        dst += i * dst_size;
+    }
+#endif
+
+    if (dst_size == 1) {
+        switch (src_size) {
+
+        case 1:
+            memcpy(dst, src, (size_t)(count - i));
+            break;
+        case 2:
+            for (; i < count; ++i, src += 2, ++dst) {
+                *dst = (Uint8)*((Uint16 *)src);
+            }
+            break;
+        case 4:
+            for (; i < count; ++i, src += 4, ++dst) {
+                *dst = (Uint8)*((Uint32 *)src);
+            }
+            break;
+        }
+    }
+    else {
+        switch (src_size) {
+
+        case 1:
+            for (; i < count; ++i, ++src, dst += 2) {
+                *(Uint16 *)dst = (Uint16)(*src << 8);
+            }
+            break;
+        case 2:
+            memcpy(dst, src, (size_t)(count - i) * 2);
+            break;
+        case 4:
+            for (; i < count; ++i, src += 4, dst += 2) {
+                *(Uint16 *)dst = (Uint16)*((Uint32 *)src);
+            }
+            break;
+        }
+    }
+}
+
 static int
 _chunk_from_array(void *buf, PG_sample_format_t view_format, int ndim,
                   Py_ssize_t *shape, Py_ssize_t *strides,
-                  Mix_Chunk **chunk, Uint8 **mem)
+                  Mix_Chunk **chunk, Uint8 **mem, int copy)
 {
     /* TODO: This is taken from _numericsndarray without additions.
      * So this should be extended to properly handle integer sign
@@ -1411,6 +1564,20 @@ _chunk_from_array(void *buf, PG_sample_format_t view_format, int ndim,
     printf("memsize: %d\n", (int)memsize);
     */
 
+    /* Samples already in the mixer layout can be played where they are.
+     * Leaving *mem NULL tells the caller to keep the array export.
+     */
+    if (!copy && view_itemsize == itemsize &&
+        step1 == itemsize * channels && step2 == itemsize) {
+        *chunk = Mix_QuickLoad_RAW((Uint8 *)buf, (Uint32)memsize);
+        if (!*chunk) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        *mem = NULL;
+        return 0;
+    }
+
     /* Create chunk.
      */
     dst = (Uint8 *)PyMem_Malloc((size_t)memsize);
@@ -1438,6 +1605,11 @@ _chunk_from_array(void *buf, PG_sample_format_t view_format, int ndim,
          *out correctly*/
         memcpy(dst, buf, memsize);
     }
+    else if (step1 == view_itemsize * channels && step2 == view_itemsize) {
+        /* Contiguous samples of another size convert in one flat pass */
+        _convert_samples((Uint8 *)buf, view_itemsize,
+                         dst, itemsize, length * channels);
+    }
     else if (itemsize == 1) {
         for (loop1 = 0; loop1 < length; loop1++) {
             src = (Uint8*)buf + (loop1 * step1);
@@ -1498,21 +1670,37 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
     PyObject *file = NULL;
     PyObject *buffer = NULL;
     PyObject *array = NULL;
+    PyObject *copyobj = NULL;
     PyObject *keys;
     PyObject *kencoded;
     SDL_RWops *rw;
     Mix_Chunk *chunk = NULL;
     Uint8 *mem = NULL;
+    Py_ssize_t nkeys = 0;
+    Py_ssize_t i;
+    int copy = 1;
 
     ((PySoundObject *)self)->chunk = NULL;
     ((PySoundObject *)self)->mem = NULL;
+    ((PySoundObject *)self)->view = NULL;
 
     /* Process arguments, returning cleaner error messages than
-       PyArg_ParseTupleAndKeywords would.
+       PyArg_ParseTupleAndKeywords would. The copy keyword may
+       accompany any of the others.
     */
+    if (kwarg != NULL) {
+        nkeys = PyDict_Size(kwarg);
+        copyobj = PyDict_GetItemString(kwarg, "copy");
+        if (copyobj != NULL) {
+            --nkeys;
+            copy = PyObject_IsTrue(copyobj);
+            if (copy < 0) {
+                return -1;
+            }
+        }
+    }
     if (arg != NULL && PyTuple_GET_SIZE(arg)) {
-        if ((kwarg != NULL && PyDict_Size(kwarg)) || /* conditional and */
-            PyTuple_GET_SIZE(arg) != 1)              {
+        if (nkeys || PyTuple_GET_SIZE(arg) != 1) {
             RAISE(PyExc_TypeError, arg_cnt_err_msg);
             return -1;
         }
@@ -1527,8 +1715,8 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
             buffer = obj;
         }
     }
-    else if (kwarg != NULL) {
-        if (PyDict_Size(kwarg) != 1) {
+    else if (nkeys) {
+        if (nkeys != 1) {
             RAISE(PyExc_TypeError, arg_cnt_err_msg);
             return -1;
         }
@@ -1539,8 +1727,16 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
             if (keys == NULL) {
                 return -1;
             }
-            kencoded = RWopsEncodeString(PyList_GET_ITEM(keys, 0),
-                                         NULL, NULL, NULL);
+            kencoded = NULL;
+            for (i = 0; i < PyList_GET_SIZE(keys); ++i) {
+                Py_XDECREF(kencoded);
+                kencoded = RWopsEncodeString(PyList_GET_ITEM(keys, i),
+                                             NULL, NULL, NULL);
+                if (kencoded == NULL ||
+                    strcmp(Bytes_AS_STRING(kencoded), "copy")) {
+                    break;
+                }
+            }
             Py_DECREF(keys);
             if (kencoded == NULL) {
                 return -1;
@@ -1617,7 +1813,7 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
                 return -1;
             }
         }
-        else {
+        else if (copy) {
             rcode = _chunk_from_buf(view.buf, view.len, &chunk, &mem);
             PyBuffer_Release(&view);
             if (rcode) {
@@ -1625,6 +1821,27 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
             }
             ((PySoundObject *)self)->mem = mem;
         }
+        else {
+            /* Play the bytes in place, holding the export until dealloc */
+            Pg_buffer *pg_view = PyMem_New(Pg_buffer, 1);
+
+            if (!pg_view) {
+                PyBuffer_Release(&view);
+                PyErr_NoMemory();
+                return -1;
+            }
+            chunk = Mix_QuickLoad_RAW((Uint8 *)view.buf, (Uint32)view.len);
+            if (!chunk) {
+                PyBuffer_Release(&view);
+                PyMem_Free(pg_view);
+                PyErr_NoMemory();
+                return -1;
+            }
+            pg_view->view = view;
+            pg_view->consumer = self;
+            pg_view->release_buffer = PyBuffer_Release;
+            ((PySoundObject *)self)->view = pg_view;
+        }
     }
 #endif
 
@@ -1654,31 +1871,44 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
 #endif
 
     if (array != NULL) {
-        Pg_buffer pg_view;
+        Pg_buffer *pg_view;
         PG_sample_format_t view_format;
         int rcode;
 
-        pg_view.view.itemsize = 0;
-        pg_view.view.obj = 0;
-        if (PgObject_GetBuffer(array, &pg_view, PyBUF_FORMAT | PyBUF_ND)) {
+        pg_view = PyMem_New(Pg_buffer, 1);
+        if (!pg_view) {
+            PyErr_NoMemory();
             return -1;
         }
-        view_format = _format_view_to_audio((Py_buffer *)&pg_view);
+        pg_view->view.itemsize = 0;
+        pg_view->view.obj = 0;
+        if (PgObject_GetBuffer(array, pg_view, PyBUF_FORMAT | PyBUF_ND)) {
+            PyMem_Free(pg_view);
+            return -1;
+        }
+        view_format = _format_view_to_audio((Py_buffer *)pg_view);
         if (!view_format) {
-            PgBuffer_Release(&pg_view);
+            PgBuffer_Release(pg_view);
+            PyMem_Free(pg_view);
             return -1;
         }
-        rcode = _chunk_from_array(pg_view.view.buf,
+        rcode = _chunk_from_array(pg_view->view.buf,
                                   view_format,
-                                  pg_view.view.ndim,
-                                  pg_view.view.shape,
-                                  pg_view.view.strides,
-                                  &chunk, &mem);
-        PgBuffer_Release(&pg_view);
-        if (rcode) {
-            return -1;
+                                  pg_view->view.ndim,
+                                  pg_view->view.shape,
+                                  pg_view->view.strides,
+                                  &chunk, &mem, copy);
+        if (rcode || mem) {
+            PgBuffer_Release(pg_view);
+            PyMem_Free(pg_view);
+            if (rcode) {
+                return -1;
+            }
+            ((PySoundObject *)self)->mem = mem;
+        }
+        else {
+            ((PySoundObject *)self)->view = pg_view;
         }
-        ((PySoundObject *)self)->mem = mem;
     }
 
     if (chunk == NULL) {
@@ -1692,6 +1922,726 @@ sound_init(PyObject *self, PyObject *arg, PyObject *kwarg)
     return 0;
 }
 
+/* Streaming sounds
+ *
+ * A SoundStream plays on an ordinary channel. The channel loops a short
+ * silent chunk, and a channel effect replaces the silence with samples
+ * taken from the stream's ring buffer. One background thread reads the
+ * WAV file a block at a time, converts it to the mixer format and keeps
+ * every ring topped up, so memory per stream is bounded by its budget no
+ * matter how long the file is. Decoding starts as soon as the stream is
+ * opened, so the start of the sound is ready before play is called.
+ *
+ * A StreamState is shared by the Python object, the decoder thread and the
+ * audio callback. It is freed by the decoder thread once the Python object
+ * is gone and the stream no longer plays.
+ */
+#define STREAM_BLOCK_FRAMES 4096
+#define STREAM_MIN_BLOCK_FRAMES 256
+#define STREAM_DEFAULT_BUDGET 262144
+#define STREAM_SILENCE_BYTES 4096
+
+typedef struct streamstate_ {
+    SDL_RWops *rw;
+    Uint32 data_start;          /* file offset of the PCM data */
+    Uint32 data_len;            /* bytes of PCM data */
+    Uint32 data_pos;            /* bytes of PCM data read so far */
+    int src_frame;              /* bytes per source sample frame */
+    int src_rate;
+    SDL_AudioCVT cvt;           /* source to mixer format */
+    int mix_freq;               /* mixer format the stream was opened for */
+    Uint16 mix_format;
+    int mix_channels;
+    Uint8 *decode;              /* conversion buffer, decoder thread only */
+    int block_bytes;            /* source bytes converted per block */
+    int out_bytes;              /* largest converted block */
+    Uint8 *ring;
+    Uint32 ring_size;
+    Uint32 ring_read;
+    Uint32 ring_fill;
+    int loops;                  /* loops left to play, -1 for forever */
+    int channel;                /* channel played on, or -1 */
+    int consumed;               /* the channel has taken samples */
+    int rewind;                 /* decoder must restart from the beginning */
+    int eof;                    /* the last loop is fully decoded */
+    int finished;               /* ... and played, so halt the channel */
+    int reading;                /* decoder is using rw without the lock */
+    int detached;               /* the Python object is gone */
+    int error;
+    Uint32 generation;          /* bumped when the ring is emptied */
+    struct streamstate_ *next;
+} StreamState;
+
+typedef struct {
+    PyObject_HEAD
+    StreamState *state;
+} PySoundStreamObject;
+
+static PyTypeObject PySoundStream_Type;
+
+static SDL_mutex *stream_lock = NULL;
+static SDL_cond *stream_wake = NULL;
+static StreamState *stream_list = NULL;
+static Mix_Chunk *stream_silence = NULL;
+static int stream_halting = 0;          /* worker is halting a channel */
+static int stream_closing = 0;          /* quit_streams is halting them all */
+
+static void
+free_stream_state(StreamState *s)
+{
+    if (s->rw != NULL) {
+        SDL_RWclose(s->rw);
+    }
+    free(s->decode);
+    free(s->ring);
+    free(s);
+}
+
+/* Called by the audio thread with the audio locked */
+static void
+stream_effect(int chan, void *stream, int len, void *udata)
+{
+    StreamState *s = (StreamState *)udata;
+    Uint8 *dst = (Uint8 *)stream;
+    Uint32 n, part;
+
+    SDL_mutexP(stream_lock);
+    n = (Uint32)len < s->ring_fill ? (Uint32)len : s->ring_fill;
+    part = s->ring_size - s->ring_read;
+    if (part > n) {
+        part = n;
+    }
+    memcpy(dst, s->ring + s->ring_read, part);
+    memcpy(dst + part, s->ring, n - part);
+    s->ring_read = (s->ring_read + n) % s->ring_size;
+    s->ring_fill -= n;
+    if (n) {
+        s->consumed = 1;
+    }
+    if (n < (Uint32)len) {
+        /* Past the end, or the decoder fell behind */
+        memset(dst + n, s->cvt.dst_format == AUDIO_U8 ? 0x80 : 0,
+               (size_t)len - n);
+        if (s->eof && !s->finished) {
+            s->finished = 1;
+        }
+    }
+    SDL_mutexV(stream_lock);
+    SDL_CondSignal(stream_wake);
+}
+
+static void
+stream_effect_done(int chan, void *udata)
+{
+    StreamState *s = (StreamState *)udata;
+
+    SDL_mutexP(stream_lock);
+    if (s->channel == chan) {
+        s->channel = -1;
+    }
+    SDL_mutexV(stream_lock);
+    SDL_CondSignal(stream_wake);
+}
+
+/* Convert the next block into s->decode without the lock, returning the
+ * converted size, 0 at the end of the data or -1 on a read error.
+ */
+static int
+decode_block(StreamState *s, int rewind)
+{
+    Uint32 want;
+    int got;
+
+    if (rewind) {
+        if (SDL_RWseek(s->rw, (int)s->data_start, RW_SEEK_SET) < 0) {
+            return -1;
+        }
+        s->data_pos = 0;
+    }
+    want = s->data_len - s->data_pos;
+    if (want > (Uint32)s->block_bytes) {
+        want = (Uint32)s->block_bytes;
+    }
+    if (want == 0) {
+        return 0;
+    }
+    got = SDL_RWread(s->rw, s->decode, 1, (int)want);
+    if (got < 0) {
+        return -1;
+    }
+    got -= got % s->src_frame;
+    s->data_pos += (Uint32)got;
+    if (got == 0) {
+        /* A data chunk longer than the file */
+        s->data_pos = s->data_len;
+        return 0;
+    }
+    if (s->cvt.needed) {
+        s->cvt.buf = s->decode;
+        s->cvt.len = got;
+        if (SDL_ConvertAudio(&s->cvt) < 0) {
+            return -1;
+        }
+        return s->cvt.len_cvt;
+    }
+    return got;
+}
+
+static int
+stream_worker(void *unused)
+{
+    StreamState *s, **link;
+    StreamState *dead = NULL;
+    Uint32 gen, n, part, at;
+    int rewind, len, chan, busy, mine;
+
+    SDL_mutexP(stream_lock);
+    for (;;) {
+        busy = 0;
+        link = &stream_list;
+        while ((s = *link) != NULL) {
+            if (s->detached && s->channel < 0) {
+                *link = s->next;
+                s->next = dead;
+                dead = s;
+                continue;
+            }
+            link = &s->next;
+            if (s->finished && s->channel >= 0 && !stream_closing &&
+                Mix_QuerySpec(NULL, NULL, NULL)) {
+                /* quit_streams waits for this before closing the mixer */
+                chan = s->channel;
+                gen = s->generation;
+                s->finished = 0;
+                stream_halting = 1;
+                SDL_mutexV(stream_lock);
+                /* The stream may have been stopped or played again since
+                 * the lock was dropped, and chan given to another sound.
+                 * With the audio locked the channel cannot change hands,
+                 * so check again before halting it.
+                 */
+                SDL_LockAudio();
+                SDL_mutexP(stream_lock);
+                mine = s->channel == chan && s->generation == gen;
+                SDL_mutexV(stream_lock);
+                if (mine && Mix_GetChunk(chan) == stream_silence) {
+                    Mix_HaltChannel(chan);
+                }
+                SDL_UnlockAudio();
+                SDL_mutexP(stream_lock);
+                stream_halting = 0;
+                busy = 1;
+                continue;
+            }
+            if (s->detached || s->eof || s->error || s->rw == NULL ||
+                s->ring_size - s->ring_fill < (Uint32)s->out_bytes) {
+                continue;
+            }
+
+            /* Decode one block without the lock, then drop it if the
+             * stream was restarted meanwhile.
+             */
+            rewind = s->rewind;
+            s->rewind = 0;
+            gen = s->generation;
+            s->reading = 1;
+            SDL_mutexV(stream_lock);
+            len = decode_block(s, rewind);
+            SDL_mutexP(stream_lock);
+            s->reading = 0;
+            busy = 1;
+            if (s->generation != gen) {
+                continue;
+            }
+            if (len < 0) {
+                s->error = 1;
+                s->eof = 1;
+            }
+            else if (len == 0) {
+                /* Nothing since the rewind: the data chunk is longer
+                 * than the file, so looping would never read anything.
+                 */
+                if (s->loops != 0 && !rewind) {
+                    if (s->loops > 0) {
+                        --s->loops;
+                    }
+                    s->rewind = 1;
+                }
+                else {
+                    s->eof = 1;
+                }
+            }
+            else {
+                n = (Uint32)len;
+                if (n > s->ring_size - s->ring_fill) {
+                    n = s->ring_size - s->ring_fill;
+                }
+                at = (s->ring_read + s->ring_fill) % s->ring_size;
+                part = s->ring_size - at;
+                if (part > n) {
+                    part = n;
+                }
+                memcpy(s->ring + at, s->decode, part);
+                memcpy(s->ring, s->decode + part, n - part);
+                s->ring_fill += n;
+            }
+        }
+
+        if (dead != NULL) {
+            /* Closing a Python file object takes the GIL */
+            SDL_mutexV(stream_lock);
+            while (dead != NULL) {
+                s = dead;
+                dead = s->next;
+                free_stream_state(s);
+            }
+            SDL_mutexP(stream_lock);
+            continue;
+        }
+        if (!busy) {
+            SDL_CondWait(stream_wake, stream_lock);
+        }
+    }
+    SDL_mutexV(stream_lock);
+    return 0;
+}
+
+static int
+init_streams(void)
+{
+    if (stream_lock != NULL) {
+        return 0;
+    }
+    stream_wake = SDL_CreateCond();
+    stream_lock = SDL_CreateMutex();
+    if (stream_lock == NULL || stream_wake == NULL ||
+        SDL_CreateThread(stream_worker, NULL) == NULL) {
+        if (stream_lock != NULL) {
+            SDL_DestroyMutex(stream_lock);
+            stream_lock = NULL;
+        }
+        if (stream_wake != NULL) {
+            SDL_DestroyCond(stream_wake);
+            stream_wake = NULL;
+        }
+        RAISE(PyExc_SDLError, SDL_GetError());
+        return -1;
+    }
+    return 0;
+}
+
+/* Free the silent chunk before the audio closes. Halting the channels
+ * unregisters the stream effects, which releases the streams.
+ */
+static void
+quit_streams(void)
+{
+    if (stream_lock == NULL) {
+        return;
+    }
+    SDL_mutexP(stream_lock);
+    stream_closing = 1;
+    while (stream_halting) {
+        SDL_mutexV(stream_lock);
+        SDL_Delay(1);
+        SDL_mutexP(stream_lock);
+    }
+    SDL_mutexV(stream_lock);
+    Mix_HaltChannel(-1);
+    /* No stream has a channel now, and none can play until the mixer is
+     * open again.
+     */
+    SDL_mutexP(stream_lock);
+    stream_closing = 0;
+    SDL_mutexV(stream_lock);
+    if (stream_silence != NULL) {
+        Mix_FreeChunk(stream_silence);
+        stream_silence = NULL;
+    }
+}
+
+/* Read the RIFF header, leaving rw at the start of the PCM data */
+static int
+read_wav_header(SDL_RWops *rw, StreamState *s, Uint16 *format,
+                int *channels)
+{
+    Uint32 tag, size;
+    Uint16 encoding = 0, bits = 0;
+    int have_fmt = 0;
+    int pos;
+
+    tag = SDL_ReadLE32(rw);                     /* "RIFF" */
+    SDL_ReadLE32(rw);                           /* file size */
+    if (tag != 0x46464952 || SDL_ReadLE32(rw) != 0x45564157) { /* "WAVE" */
+        RAISE(PyExc_SDLError,
+              "SoundStream only plays uncompressed WAV files");
+        return -1;
+    }
+    for (;;) {
+        tag = SDL_ReadLE32(rw);
+        size = SDL_ReadLE32(rw);
+        pos = SDL_RWtell(rw);
+        if (pos < 0 || (tag == 0 && size == 0)) {
+            RAISE(PyExc_SDLError, "WAV file has no data chunk");
+            return -1;
+        }
+        if (tag == 0x20746D66) {                /* "fmt " */
+            encoding = SDL_ReadLE16(rw);
+            *channels = SDL_ReadLE16(rw);
+            s->src_rate = (int)SDL_ReadLE32(rw);
+            SDL_ReadLE32(rw);                   /* byte rate */
+            SDL_ReadLE16(rw);                   /* block align */
+            bits = SDL_ReadLE16(rw);
+            have_fmt = 1;
+        }
+        else if (tag == 0x61746164) {           /* "data" */
+            break;
+        }
+        if (SDL_RWseek(rw, pos + (int)size + (int)(size & 1),
+                       RW_SEEK_SET) < 0) {
+            RAISE(PyExc_SDLError, SDL_GetError());
+            return -1;
+        }
+    }
+    if (!have_fmt || encoding != 1 || (bits != 8 && bits != 16) ||
+        *channels < 1 || *channels > 2 || s->src_rate <= 0) {
+        RAISE(PyExc_SDLError,
+              "SoundStream only plays 8 or 16 bit PCM WAV files");
+        return -1;
+    }
+    *format = bits == 8 ? AUDIO_U8 : AUDIO_S16LSB;
+    s->src_frame = (bits / 8) * *channels;
+    s->data_start = (Uint32)pos;
+    s->data_len = size - size % (Uint32)s->src_frame;
+    if (s->data_len == 0) {
+        RAISE(PyExc_SDLError, "WAV file has no samples");
+        return -1;
+    }
+    return 0;
+}
+
+static int
+stream_init(PyObject *self, PyObject *args, PyObject *kwds)
+{
+    static char *kwids[] = {"file", "budget", NULL};
+    PySoundStreamObject *streamobj = (PySoundStreamObject *)self;
+    PyObject *obj;
+    PyObject *oencoded;
+    Py_ssize_t budget = STREAM_DEFAULT_BUDGET;
+    StreamState *s;
+    SDL_RWops *rw = NULL;
+    Uint16 src_format;
+    int src_channels;
+    int frames;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|n", kwids,
+                                     &obj, &budget)) {
+        return -1;
+    }
+    if (!SDL_WasInit(SDL_INIT_AUDIO)) {
+        RAISE(PyExc_SDLError, "mixer system not initialized");
+        return -1;
+    }
+    if (streamobj->state != NULL) {
+        RAISE(PyExc_RuntimeError, "SoundStream is already open");
+        return -1;
+    }
+    if (init_streams()) {
+        return -1;
+    }
+
+    s = (StreamState *)calloc(1, sizeof(StreamState));
+    if (s == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    s->channel = -1;
+    Mix_QuerySpec(&s->mix_freq, &s->mix_format, &s->mix_channels);
+
+    oencoded = RWopsEncodeFilePath(obj, PyExc_SDLError);
+    if (oencoded == Py_None) {
+        /* The decoder thread reads without the GIL */
+        rw = RWopsFromFileObjectThreaded(obj);
+    }
+    else if (oencoded != NULL) {
+        Py_BEGIN_ALLOW_THREADS;
+        rw = SDL_RWFromFile(Bytes_AS_STRING(oencoded), "rb");
+        Py_END_ALLOW_THREADS;
+        if (rw == NULL) {
+            PyErr_Format(PyExc_SDLError, "Unable to open file '%s'",
+                         Bytes_AS_STRING(oencoded));
+        }
+    }
+    Py_XDECREF(oencoded);
+    if (rw == NULL) {
+        free(s);
+        return -1;
+    }
+    s->rw = rw;
+
+    if (read_wav_header(rw, s, &src_format, &src_channels)) {
+        free_stream_state(s);
+        return -1;
+    }
+    if (SDL_BuildAudioCVT(&s->cvt, src_format, (Uint8)src_channels,
+                          s->src_rate, s->mix_format,
+                          (Uint8)s->mix_channels, s->mix_freq) < 0) {
+        RAISE(PyExc_SDLError, SDL_GetError());
+        free_stream_state(s);
+        return -1;
+    }
+
+    /* Keep room in the ring for two converted blocks */
+    frames = STREAM_BLOCK_FRAMES;
+    for (;;) {
+        s->block_bytes = frames * s->src_frame;
+        s->out_bytes = (int)(s->block_bytes * s->cvt.len_ratio) + 64;
+        if ((Py_ssize_t)s->out_bytes * 2 <= budget ||
+            frames == STREAM_MIN_BLOCK_FRAMES) {
+            break;
+        }
+        frames /= 2;
+    }
+    if ((Py_ssize_t)s->out_bytes * 2 > budget) {
+        PyErr_Format(PyExc_ValueError,
+                     "budget must be at least %d bytes for this file",
+                     s->out_bytes * 2);
+        free_stream_state(s);
+        return -1;
+    }
+    s->ring_size = (Uint32)budget;
+    s->ring = (Uint8 *)malloc((size_t)budget);
+    s->decode = (Uint8 *)malloc((size_t)s->block_bytes *
+                                (s->cvt.needed ? s->cvt.len_mult : 1));
+    if (s->ring == NULL || s->decode == NULL) {
+        free_stream_state(s);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    /* Start prefetching */
+    streamobj->state = s;
+    SDL_mutexP(stream_lock);
+    s->next = stream_list;
+    stream_list = s;
+    SDL_mutexV(stream_lock);
+    SDL_CondSignal(stream_wake);
+    return 0;
+}
+
+static void
+halt_stream(StreamState *s)
+{
+    int chan;
+
+    SDL_mutexP(stream_lock);
+    chan = s->channel;
+    SDL_mutexV(stream_lock);
+    if (chan >= 0 && SDL_WasInit(SDL_INIT_AUDIO)) {
+        Mix_HaltChannel(chan);
+    }
+}
+
+static PyObject*
+stream_stop(PyObject *self)
+{
+    StreamState *s = ((PySoundStreamObject *)self)->state;
+
+    if (s != NULL) {
+        halt_stream(s);
+    }
+    Py_RETURN_NONE;
+}
+
+static void
+stream_dealloc(PySoundStreamObject *self)
+{
+    StreamState *s = self->state;
+    SDL_RWops *rw = NULL;
+
+    if (s != NULL) {
+        halt_stream(s);
+        SDL_mutexP(stream_lock);
+        s->detached = 1;
+        if (!s->reading) {
+            rw = s->rw;
+            s->rw = NULL;
+        }
+        SDL_mutexV(stream_lock);
+        SDL_CondSignal(stream_wake);
+        if (rw != NULL) {
+            SDL_RWclose(rw);
+        }
+    }
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static PyObject*
+stream_play(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwids[] = {"loops", NULL};
+    StreamState *s = ((PySoundStreamObject *)self)->state;
+    int loops = 0;
+    int freq, channels;
+    Uint16 format;
+    int chan;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|i", kwids, &loops)) {
+        return NULL;
+    }
+    MIXER_INIT_CHECK();
+    if (s == NULL) {
+        return RAISE(PyExc_SDLError, "SoundStream is not open");
+    }
+    Mix_QuerySpec(&freq, &format, &channels);
+    if (freq != s->mix_freq || format != s->mix_format ||
+        channels != s->mix_channels) {
+        return RAISE(PyExc_SDLError,
+                     "mixer format changed since the stream was opened");
+    }
+    if (stream_silence == NULL) {
+        Uint8 *silence = (Uint8 *)malloc(STREAM_SILENCE_BYTES);
+
+        if (silence == NULL) {
+            return PyErr_NoMemory();
+        }
+        memset(silence, format == AUDIO_U8 ? 0x80 : 0, STREAM_SILENCE_BYTES);
+        stream_silence = Mix_QuickLoad_RAW(silence, STREAM_SILENCE_BYTES);
+        if (stream_silence == NULL) {
+            free(silence);
+            return RAISE(PyExc_SDLError, Mix_GetError());
+        }
+        /* Let Mix_FreeChunk free the samples */
+        stream_silence->allocated = 1;
+    }
+
+    halt_stream(s);
+    SDL_mutexP(stream_lock);
+    if (s->consumed || s->error) {
+        /* Start again from the top */
+        s->ring_read = 0;
+        s->ring_fill = 0;
+        s->rewind = 1;
+        s->eof = 0;
+        s->error = 0;
+        s->consumed = 0;
+        ++s->generation;
+    }
+    s->finished = 0;
+    s->loops = loops;
+    SDL_mutexV(stream_lock);
+
+    chan = Mix_PlayChannelTimed(-1, stream_silence, -1, -1);
+    if (chan == -1) {
+        Py_RETURN_NONE;
+    }
+    SDL_mutexP(stream_lock);
+    s->channel = chan;
+    SDL_mutexV(stream_lock);
+    if (!Mix_RegisterEffect(chan, stream_effect, stream_effect_done, s)) {
+        Mix_HaltChannel(chan);
+        SDL_mutexP(stream_lock);
+        s->channel = -1;
+        SDL_mutexV(stream_lock);
+        return RAISE(PyExc_SDLError, Mix_GetError());
+    }
+    SDL_CondSignal(stream_wake);
+    return PyChannel_New(chan);
+}
+
+static PyObject*
+stream_get_busy(PyObject *self)
+{
+    StreamState *s = ((PySoundStreamObject *)self)->state;
+    int busy = 0;
+
+    if (s != NULL) {
+        SDL_mutexP(stream_lock);
+        busy = s->channel >= 0;
+        SDL_mutexV(stream_lock);
+    }
+    return PyInt_FromLong(busy);
+}
+
+static PyObject*
+stream_get_length(PyObject *self)
+{
+    StreamState *s = ((PySoundStreamObject *)self)->state;
+
+    if (s == NULL) {
+        return RAISE(PyExc_SDLError, "SoundStream is not open");
+    }
+    return PyFloat_FromDouble((double)(s->data_len / s->src_frame) /
+                              s->src_rate);
+}
+
+static PyObject*
+stream_get_budget(PyObject *self)
+{
+    StreamState *s = ((PySoundStreamObject *)self)->state;
+
+    if (s == NULL) {
+        return RAISE(PyExc_SDLError, "SoundStream is not open");
+    }
+    return PyInt_FromSsize_t((Py_ssize_t)s->ring_size);
+}
+
+static PyMethodDef stream_methods[] =
+{
+    { "play", (PyCFunction)stream_play, METH_VARARGS | METH_KEYWORDS,
+      DOC_SOUNDSTREAMPLAY },
+    { "stop", (PyCFunction)stream_stop, METH_NOARGS, DOC_SOUNDSTREAMSTOP },
+    { "get_busy", (PyCFunction)stream_get_busy, METH_NOARGS,
+      DOC_SOUNDSTREAMGETBUSY },
+    { "get_length", (PyCFunction)stream_get_length, METH_NOARGS,
+      DOC_SOUNDSTREAMGETLENGTH },
+    { "get_budget", (PyCFunction)stream_get_budget, METH_NOARGS,
+      DOC_SOUNDSTREAMGETBUDGET },
+    { NULL, NULL, 0, NULL }
+};
+
+static PyTypeObject PySoundStream_Type =
+{
+    TYPE_HEAD (NULL, 0)
+    "SoundStream",
+    sizeof(PySoundStreamObject),
+    0,
+    (destructor)stream_dealloc,
+    0,
+    0,
+    0,                          /* setattr */
+    0,                          /* compare */
+    0,                          /* repr */
+    0,                          /* as_number */
+    0,                          /* as_sequence */
+    0,                          /* as_mapping */
+    (hashfunc)NULL,             /* hash */
+    (ternaryfunc)NULL,          /* call */
+    (reprfunc)NULL,             /* str */
+    0,                          /* tp_getattro */
+    0,                          /* tp_setattro */
+    0,                          /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,         /* tp_flags */
+    DOC_PYGAMEMIXERSOUNDSTREAM, /* Documentation string */
+    0,                          /* tp_traverse */
+    0,                          /* tp_clear */
+    0,                          /* tp_richcompare */
+    0,                          /* tp_weaklistoffset */
+    0,                          /* tp_iter */
+    0,                          /* tp_iternext */
+    stream_methods,             /* tp_methods */
+    0,                          /* tp_members */
+    0,                          /* tp_getset */
+    0,                          /* tp_base */
+    0,                          /* tp_dict */
+    0,                          /* tp_descr_get */
+    0,                          /* tp_descr_set */
+    0,                          /* tp_dictoffset */
+    (initproc)stream_init,      /* tp_init */
+    0,                          /* tp_alloc */
+    0,                          /* tp_new */
+};
+
 static PyMethodDef _mixer_methods[] =
 {
     { "__PYGAMEinit__", autoinit, METH_VARARGS, "auto initialize for mixer" },
@@ -1733,6 +2683,7 @@ PySound_New (Mix_Chunk* chunk)
     if (soundobj)
     {
         soundobj->mem = NULL;
+        soundobj->view = NULL;
         soundobj->chunk = chunk;
     }
 
@@ -1793,6 +2744,10 @@ MODINIT_DEFINE (mixer)
     if (PyType_Ready (&PyChannel_Type) < 0) {
         MODINIT_ERROR;
     }
+    PySoundStream_Type.tp_new = &PyType_GenericNew;
+    if (PyType_Ready (&PySoundStream_Type) < 0) {
+        MODINIT_ERROR;
+    }
 
     /* create the module */
     PySound_Type.tp_new = &PyType_GenericNew;
@@ -1824,6 +2779,12 @@ MODINIT_DEFINE (mixer)
         DECREF_MOD (module);
         MODINIT_ERROR;
     }
+    if (PyDict_SetItemString (dict,
+                              "SoundStream",
+                              (PyObject *)&PySoundStream_Type) < 0) {
+        DECREF_MOD (module);
+        MODINIT_ERROR;
+    }
 
     /* export the c api */
     c_api[0] = &PySound_Type;
@@ -1869,10 +2830,10 @@ MODINIT_DEFINE (mixer)
         current_music =
             (Mix_Music**)PyCapsule_GetPointer (ptr, "pygame.music_mixer."
                                                     "_MUSIC_POINTER");
-        ptr = PyDict_GetItemString (_dict, "_QUEUE_POINTER");
-        queue_music =
-            (Mix_Music**)PyCapsule_GetPointer (ptr, "pygame.music_mixer."
-                                                    "_QUEUE_POINTER");
+        ptr = PyDict_GetItemString (_dict, "_CLEAR_QUEUE");
+        clear_music_queue =
+            (void (*) (void))PyCapsule_GetPointer (ptr, "pygame.music_mixer."
+                                                        "_CLEAR_QUEUE");
     }
     else /*music module not compiled? cleanly ignore*/
     {
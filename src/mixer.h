@@ -39,6 +39,7 @@ typedef struct {
   Mix_Chunk *chunk;
   Uint8 *mem;
   PyObject *weakreflist;
+  Pg_buffer *view;  /* exported samples the chunk plays in place, or NULL */
 } PySoundObject;
 typedef struct {
   PyObject_HEAD
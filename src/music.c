@@ -40,6 +40,13 @@
 #define MIXMUSIC_HAVE_STARTPOSN 0
 #endif
 
+/* versions 1.2.10 and greater load codec libraries with Mix_Init */
+#if _version_ >= ver(1, 2, 10)
+#define MIXMUSIC_HAVE_INIT 1
+#else
+#define MIXMUSIC_HAVE_INIT 0
+#endif
+
 /* versions 1.2.8 and greater have rwops */
 #if _version_ >= ver(1, 2, 8)
 #define MIXMUSIC_HAVE_RWOPS 1
@@ -51,7 +58,6 @@
 #undef _version_
 
 static Mix_Music* current_music = NULL;
-static Mix_Music* queue_music = NULL;
 static int endmusic_event = SDL_NOEVENT;
 static Uint64 music_pos = 0;
 static long music_pos_time = -1;
@@ -69,9 +75,97 @@ mixmusic_callback (void *udata, Uint8 *stream, int len)
     }
 }
 
+/* The music queue
+ *
+ * Queued tracks are opened ahead of time by a loader thread, so switching
+ * tracks never reads or parses a file on the audio thread. When a track
+ * ends, the finished hook starts the next one at once; SDL_mixer then
+ * fills the rest of the same audio buffer from it, so the switch is
+ * sample accurate. Finished tracks are handed back to the loader to be
+ * freed, as freeing a track read from a Python file object needs the GIL.
+ *
+ * Lock order is the audio lock, then queue_lock.
+ */
+#define QUEUE_MAX_AHEAD 8
+
+typedef struct queueentry_ {
+    char *filename;             /* or NULL for a file object */
+    SDL_RWops *rw;
+    Mix_Music *music;           /* opened ahead, or NULL */
+    int loops;
+    int fade_ms;
+    int loading;                /* the loader is opening it */
+    int cancelled;              /* removed from the queue while loading */
+    int failed;
+    struct queueentry_ *next;
+} QueueEntry;
+
+static SDL_mutex *queue_lock = NULL;
+static SDL_cond *queue_wake = NULL;
+static QueueEntry *queue_head = NULL;
+static QueueEntry *queue_tail = NULL;
+static QueueEntry *queue_dead = NULL;   /* entries waiting to be freed */
+static int queue_length = 0;
+static int queue_ahead = 2;             /* tracks to keep open in advance */
+static int queue_waiting = 0;           /* music ended before next opened */
+
+static void
+free_queue_entry (QueueEntry *entry)
+{
+    if (entry->music)
+        Mix_FreeMusic (entry->music);
+    else if (entry->rw)
+        SDL_RWclose (entry->rw);
+    free (entry->filename);
+    free (entry);
+}
+
+/* Called with the audio and queue locks held. Takes the next track
+ * off the queue and makes it current, returning NULL if there is none
+ * ready.
+ */
+static QueueEntry*
+take_next_track (void)
+{
+    QueueEntry *entry = queue_head;
+    Mix_Music *next;
+
+    while (entry != NULL && entry->failed)
+    {
+        /* Skip files that could not be opened */
+        queue_head = entry->next;
+        if (queue_head == NULL)
+            queue_tail = NULL;
+        --queue_length;
+        entry->next = queue_dead;
+        queue_dead = entry;
+        entry = queue_head;
+    }
+    if (entry == NULL || entry->music == NULL)
+        return NULL;
+
+    queue_head = entry->next;
+    if (queue_head == NULL)
+        queue_tail = NULL;
+    --queue_length;
+
+    /* The entry carries the old track to the loader to be freed */
+    next = entry->music;
+    entry->music = current_music;
+    entry->rw = NULL;
+    current_music = next;
+    entry->next = queue_dead;
+    queue_dead = entry;
+    music_pos = 0;
+    return entry;
+}
+
 static void
 endmusic_callback (void)
 {
+    QueueEntry *entry = NULL, *head;
+    int loops = 0, fade_ms = 0, waiting = 0;
+
     if (endmusic_event && SDL_WasInit (SDL_INIT_VIDEO))
     {
         SDL_Event e;
@@ -79,23 +173,205 @@ endmusic_callback (void)
         e.type = endmusic_event;
         SDL_PushEvent (&e);
     }
-    if (queue_music)
+    if (queue_lock)
+    {
+        SDL_mutexP (queue_lock);
+        head = queue_head;
+        entry = take_next_track ();
+        if (entry)
+        {
+            loops = entry->loops;
+            fade_ms = entry->fade_ms;
+        }
+        else if (queue_head)
+        {
+            /* The loader starts it as soon as it is open */
+            queue_waiting = waiting = 1;
+        }
+        /* Failed entries may have been dropped even when no track was
+         * taken; the loader has dead entries to free or new tracks to
+         * open either way.
+         */
+        if (queue_head != head || waiting)
+            SDL_CondSignal (queue_wake);
+        SDL_mutexV (queue_lock);
+    }
+    if (entry)
     {
-        if (current_music)
-            Mix_FreeMusic (current_music);
-        current_music = queue_music;
-        queue_music = NULL;
         Mix_HookMusicFinished (endmusic_callback);
-        music_pos = 0;
-        Mix_PlayMusic (current_music, 0);
+        if (fade_ms > 0)
+            Mix_FadeInMusic (current_music, loops, fade_ms);
+        else
+            Mix_PlayMusic (current_music, loops);
     }
-    else
+    else if (!waiting)
     {
         music_pos_time = -1;
         Mix_SetPostMix (NULL, NULL);
     }
 }
 
+static int
+queue_loader (void *unused)
+{
+    QueueEntry *entry, *dead;
+    Mix_Music *music;
+    int ahead, loops, fade_ms;
+
+    SDL_mutexP (queue_lock);
+    for (;;)
+    {
+        if (queue_dead)
+        {
+            dead = queue_dead;
+            queue_dead = NULL;
+            SDL_mutexV (queue_lock);
+            while (dead)
+            {
+                entry = dead;
+                dead = entry->next;
+                free_queue_entry (entry);
+            }
+            SDL_mutexP (queue_lock);
+            continue;
+        }
+
+        if (queue_waiting && queue_head &&
+            (queue_head->music || queue_head->failed))
+        {
+            /* Keep the lock order: audio first */
+            SDL_mutexV (queue_lock);
+            SDL_LockAudio ();
+            SDL_mutexP (queue_lock);
+            entry = queue_waiting ? take_next_track () : NULL;
+            if (entry)
+            {
+                queue_waiting = 0;
+                loops = entry->loops;
+                fade_ms = entry->fade_ms;
+                SDL_mutexV (queue_lock);
+                Mix_HookMusicFinished (endmusic_callback);
+                if (fade_ms > 0)
+                    Mix_FadeInMusic (current_music, loops, fade_ms);
+                else
+                    Mix_PlayMusic (current_music, loops);
+                SDL_UnlockAudio ();
+                SDL_mutexP (queue_lock);
+            }
+            else
+            {
+                if (queue_head == NULL)
+                    queue_waiting = 0;
+                SDL_UnlockAudio ();
+            }
+            continue;
+        }
+
+        /* Open the first unopened track among the next few */
+        ahead = 0;
+        for (entry = queue_head; entry && ahead < queue_ahead;
+             entry = entry->next, ++ahead)
+        {
+            if (!entry->music && !entry->failed)
+                break;
+        }
+        if (entry && ahead < queue_ahead)
+        {
+            entry->loading = 1;
+            SDL_mutexV (queue_lock);
+#if MIXMUSIC_HAVE_RWOPS
+            if (entry->rw)
+                music = Mix_LoadMUS_RW (entry->rw);
+            else
+#endif
+                music = Mix_LoadMUS (entry->filename);
+            SDL_mutexP (queue_lock);
+            entry->loading = 0;
+            entry->music = music;
+            entry->failed = music == NULL;
+            if (entry->cancelled)
+            {
+                entry->next = queue_dead;
+                queue_dead = entry;
+            }
+            continue;
+        }
+
+        SDL_CondWait (queue_wake, queue_lock);
+    }
+    SDL_mutexV (queue_lock);
+    return 0;
+}
+
+static int
+init_queue (void)
+{
+    if (queue_lock != NULL)
+        return 0;
+#if MIXMUSIC_HAVE_INIT
+    /* Load the codec libraries now rather than lazily on the loader */
+    Mix_Init (MIX_INIT_FLAC | MIX_INIT_MOD | MIX_INIT_MP3 | MIX_INIT_OGG);
+#endif
+    queue_wake = SDL_CreateCond ();
+    queue_lock = SDL_CreateMutex ();
+    if (queue_lock == NULL || queue_wake == NULL ||
+        SDL_CreateThread (queue_loader, NULL) == NULL)
+    {
+        if (queue_lock != NULL)
+        {
+            SDL_DestroyMutex (queue_lock);
+            queue_lock = NULL;
+        }
+        if (queue_wake != NULL)
+        {
+            SDL_DestroyCond (queue_wake);
+            queue_wake = NULL;
+        }
+        RAISE (PyExc_SDLError, SDL_GetError ());
+        return -1;
+    }
+    return 0;
+}
+
+/* Empty the queue. Called with the GIL held; it is released while the
+ * tracks are freed, as a track read from a file object may need it.
+ */
+static void
+clear_queue (void)
+{
+    QueueEntry *entry, *next, *dead = NULL;
+
+    if (queue_lock == NULL)
+        return;
+    SDL_mutexP (queue_lock);
+    for (entry = queue_head; entry; entry = next)
+    {
+        next = entry->next;
+        if (entry->loading)
+        {
+            entry->cancelled = 1;
+        }
+        else
+        {
+            entry->next = dead;
+            dead = entry;
+        }
+    }
+    queue_head = queue_tail = NULL;
+    queue_length = 0;
+    queue_waiting = 0;
+    SDL_mutexV (queue_lock);
+
+    Py_BEGIN_ALLOW_THREADS
+    while (dead)
+    {
+        entry = dead;
+        dead = entry->next;
+        free_queue_entry (entry);
+    }
+    Py_END_ALLOW_THREADS
+}
+
 /*music module methods*/
 static PyObject*
 music_play (PyObject* self, PyObject* args, PyObject *keywds)
@@ -155,12 +431,8 @@ music_fadeout (PyObject* self, PyObject* args)
 
     MIXER_INIT_CHECK ();
 
+    clear_queue ();
     Mix_FadeOutMusic (_time);
-    if (queue_music)
-    {
-        Mix_FreeMusic (queue_music);
-        queue_music = NULL;
-    }
     Py_RETURN_NONE;
 }
 
@@ -169,12 +441,8 @@ music_stop (PyObject* self)
 {
     MIXER_INIT_CHECK ();
 
+    clear_queue ();
     Mix_HaltMusic ();
-    if (queue_music)
-    {
-        Mix_FreeMusic (queue_music);
-        queue_music = NULL;
-    }
     Py_RETURN_NONE;
 }
 
@@ -331,49 +599,50 @@ music_load(PyObject *self, PyObject *args)
         return RAISE(PyExc_SDLError, SDL_GetError());
     }
 
+    clear_queue();
     Py_BEGIN_ALLOW_THREADS
     if (current_music != NULL)
     {
         Mix_FreeMusic(current_music);
-        current_music = NULL;
-    }
-    if (queue_music != NULL)
-    {
-        Mix_FreeMusic(queue_music);
-        queue_music = NULL;
     }
+    SDL_LockAudio();
+    current_music = new_music;
+    SDL_UnlockAudio();
     Py_END_ALLOW_THREADS
 
-    current_music = new_music;
     Py_RETURN_NONE;
 }
 
 static PyObject*
-music_queue(PyObject *self, PyObject *args)
+music_queue(PyObject *self, PyObject *args, PyObject *keywds)
 {
+    static char *kwids[] = {"filename", "loops", "fade_ms", NULL};
     PyObject *obj;
     PyObject *oencoded;
-    Mix_Music *queue_music = NULL;
-    const char *name;
-    SDL_RWops *rw;
+    QueueEntry *entry;
+    SDL_RWops *rw = NULL;
+    char *name = NULL;
+    int loops = 0, fade_ms = 0;
 
-    if(!PyArg_ParseTuple(args, "O", &obj)) {
+    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|ii", kwids,
+                                     &obj, &loops, &fade_ms)) {
         return NULL;
     }
 
     MIXER_INIT_CHECK();
+    if (init_queue()) {
+        return NULL;
+    }
 
     oencoded = RWopsEncodeFilePath(obj, PyExc_SDLError);
     if (oencoded == Py_None) {
         Py_DECREF(oencoded);
 #if MIXMUSIC_HAVE_RWOPS
+        /* Opened by the loader thread, so it must not need the caller */
         rw = RWopsFromFileObjectThreaded(obj);
         if(rw == NULL) {
             return NULL;
         }
-        Py_BEGIN_ALLOW_THREADS
-        queue_music = Mix_LoadMUS_RW(rw);
-        Py_END_ALLOW_THREADS
 #else
         return RAISE (PyExc_NotImplementedError,
                       "music file-like-object support requires"
@@ -381,29 +650,84 @@ music_queue(PyObject *self, PyObject *args)
 #endif
     }
     else if (oencoded != NULL) {
-        name = Bytes_AS_STRING(oencoded);
-        Py_BEGIN_ALLOW_THREADS
-        queue_music = Mix_LoadMUS(name);
-        Py_END_ALLOW_THREADS
+        name = strdup(Bytes_AS_STRING(oencoded));
         Py_DECREF(oencoded);
+        if (name == NULL) {
+            return PyErr_NoMemory();
+        }
     }
     else {
         return NULL;
     }
 
-    if (queue_music == NULL) {
-        return RAISE(PyExc_SDLError, SDL_GetError());
+    entry = (QueueEntry *)calloc(1, sizeof(QueueEntry));
+    if (entry == NULL) {
+        free(name);
+        if (rw != NULL) {
+            SDL_RWclose(rw);
+        }
+        return PyErr_NoMemory();
+    }
+    entry->filename = name;
+    entry->rw = rw;
+    entry->loops = loops;
+    entry->fade_ms = fade_ms;
+
+    SDL_mutexP(queue_lock);
+    if (queue_tail != NULL) {
+        queue_tail->next = entry;
+    }
+    else {
+        queue_head = entry;
     }
+    queue_tail = entry;
+    ++queue_length;
+    SDL_mutexV(queue_lock);
+    SDL_CondSignal(queue_wake);
+    Py_RETURN_NONE;
+}
 
-    Py_BEGIN_ALLOW_THREADS
-    if (queue_music == NULL)
-    {
-        Mix_FreeMusic(queue_music);
-        queue_music = NULL;
+static PyObject*
+music_clear_queue(PyObject *self)
+{
+    clear_queue();
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+music_get_queue_length(PyObject *self)
+{
+    int length = 0;
+
+    if (queue_lock != NULL) {
+        SDL_mutexP(queue_lock);
+        length = queue_length;
+        SDL_mutexV(queue_lock);
     }
-    Py_END_ALLOW_THREADS
+    return PyInt_FromLong(length);
+}
+
+static PyObject*
+music_set_queue_ahead(PyObject *self, PyObject *args)
+{
+    int ahead;
 
-    queue_music = queue_music;
+    if (!PyArg_ParseTuple(args, "i", &ahead)) {
+        return NULL;
+    }
+    if (ahead < 1 || ahead > QUEUE_MAX_AHEAD) {
+        return RAISE(PyExc_ValueError,
+                     "ahead must be between 1 and 8");
+    }
+    if (queue_lock != NULL) {
+        SDL_mutexP(queue_lock);
+        queue_ahead = ahead;
+        SDL_mutexV(queue_lock);
+        SDL_CondSignal(queue_wake);
+    }
+    else {
+        queue_ahead = ahead;
+    }
     Py_RETURN_NONE;
 }
 
@@ -436,7 +760,14 @@ static PyMethodDef _music_methods[] =
       DOC_PYGAMEMIXERMUSICGETPOS },
 
     { "load", music_load, METH_VARARGS, DOC_PYGAMEMIXERMUSICLOAD },
-    { "queue", music_queue, METH_VARARGS, DOC_PYGAMEMIXERMUSICQUEUE },
+    { "queue", (PyCFunction) music_queue, METH_VARARGS | METH_KEYWORDS,
+      DOC_PYGAMEMIXERMUSICQUEUE },
+    { "clear_queue", (PyCFunction) music_clear_queue, METH_NOARGS,
+      DOC_PYGAMEMIXERMUSICCLEARQUEUE },
+    { "get_queue_length", (PyCFunction) music_get_queue_length, METH_NOARGS,
+      DOC_PYGAMEMIXERMUSICGETQUEUELENGTH },
+    { "set_queue_ahead", music_set_queue_ahead, METH_VARARGS,
+      DOC_PYGAMEMIXERMUSICSETQUEUEAHEAD },
 
     { NULL, NULL, 0, NULL }
 };
@@ -493,13 +824,13 @@ MODINIT_DEFINE (mixer_music)
         DECREF_MOD (module);
         MODINIT_ERROR;
     }
-    cobj = PyCapsule_New (&queue_music,
-                          "pygame.music_mixer._QUEUE_POINTER", NULL);
+    cobj = PyCapsule_New ((void *)clear_queue,
+                          "pygame.music_mixer._CLEAR_QUEUE", NULL);
     if (cobj == NULL) {
         DECREF_MOD (module);
         MODINIT_ERROR;
     }
-    if (PyModule_AddObject(module, "_QUEUE_POINTER", cobj) < 0) {
+    if (PyModule_AddObject(module, "_CLEAR_QUEUE", cobj) < 0) {
         Py_DECREF (cobj);
         DECREF_MOD (module);
         MODINIT_ERROR;
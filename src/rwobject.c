@@ -29,6 +29,12 @@
 #include "pgcompat.h"
 #include "doc/pygame_doc.h"
 
+#if !defined(WIN32)
+#include <unistd.h>
+#include <sys/stat.h>
+#define PG_HAVE_FD_RWOPS 1
+#endif
+
 /* With Python 2.5 exception types became new-style classes and
  * PyExc_BaseException was introduced.
  */
@@ -46,8 +52,18 @@ typedef struct
     PyObject* seek;
     PyObject* tell;
     PyObject* close;
+    PyObject* readinto;
+    PyObject* buffer;     /* bytearray of read ahead data, made on demand */
+    Py_ssize_t bufsize;   /* read ahead size, 0 to call read() directly */
+    Py_ssize_t buflen;    /* bytes held in buffer */
+    Py_ssize_t bufpos;    /* next byte of buffer to hand out */
+    Py_ssize_t bufstart;  /* file position of the buffer, -1 if unknown */
 } RWHelper;
 
+#define RW_DEFAULT_BUFFER_SIZE 65536
+
+static Py_ssize_t rw_buffer_size = RW_DEFAULT_BUFFER_SIZE;
+
 /*static const char default_encoding[] = "unicode_escape";*/
 /*static const char default_errors[] = "backslashreplace";*/
 static const char default_encoding[] = "unicode_escape";
@@ -58,6 +74,35 @@ static int rw_read (SDL_RWops* context, void* ptr, int size, int maxnum);
 static int rw_write (SDL_RWops* context, const void* ptr, int size, int maxnum);
 static int rw_close (SDL_RWops* context);
 
+#if HAVE_NEW_BUFPROTO
+typedef struct
+{
+    Py_buffer view;
+    Py_ssize_t pos;
+} RWBuffer;
+
+static int rw_seek_buf (SDL_RWops* context, int offset, int whence);
+static int rw_read_buf (SDL_RWops* context, void* ptr, int size, int maxnum);
+static int rw_write_buf (SDL_RWops* context, const void* ptr, int size,
+                         int maxnum);
+static int rw_close_buf (SDL_RWops* context);
+#endif
+
+#ifdef PG_HAVE_FD_RWOPS
+typedef struct
+{
+    int fd;
+    off_t pos;
+    PyObject* obj;  /* the file object, moved to pos on close */
+} RWDescriptor;
+
+static int rw_seek_fd (SDL_RWops* context, int offset, int whence);
+static int rw_read_fd (SDL_RWops* context, void* ptr, int size, int maxnum);
+static int rw_write_fd (SDL_RWops* context, const void* ptr, int size,
+                        int maxnum);
+static int rw_close_fd (SDL_RWops* context);
+#endif
+
 #ifdef WITH_THREAD
 static int rw_seek_th (SDL_RWops* context, int offset, int whence);
 static int rw_read_th (SDL_RWops* context, void* ptr, int size, int maxnum);
@@ -103,7 +148,10 @@ static void
 fetch_object_methods (RWHelper* helper, PyObject* obj)
 {
     helper->read = helper->write = helper->seek = helper->tell =
-        helper->close = NULL;
+        helper->close = helper->readinto = helper->buffer = NULL;
+    helper->bufsize = rw_buffer_size;
+    helper->buflen = helper->bufpos = 0;
+    helper->bufstart = -1;
 
     if (PyObject_HasAttrString (obj, "read"))
     {
@@ -150,6 +198,230 @@ fetch_object_methods (RWHelper* helper, PyObject* obj)
             helper->close = NULL;
         }
     }
+    if (PyObject_HasAttrString (obj, "readinto"))
+    {
+        helper->readinto = PyObject_GetAttrString (obj, "readinto");
+        if (helper->readinto && !PyCallable_Check (helper->readinto))
+        {
+            Py_DECREF (helper->readinto);
+            helper->readinto = NULL;
+        }
+    }
+}
+
+/* Read ahead
+ *
+ * Decoders make many small reads. Rather than a Python read() call for
+ * each, a helper fills a bytearray of bufsize bytes at a time, with
+ * readinto() when the object has it so the bytearray is reused, and
+ * hands out reads and seeks within it without calling Python. The
+ * position of the Python object runs ahead of the position seen by SDL
+ * until a seek outside the buffer or a write brings them back together.
+ *
+ * These functions are called with the GIL held.
+ */
+static void
+release_helper (RWHelper* helper)
+{
+    Py_XDECREF (helper->seek);
+    Py_XDECREF (helper->tell);
+    Py_XDECREF (helper->write);
+    Py_XDECREF (helper->read);
+    Py_XDECREF (helper->close);
+    Py_XDECREF (helper->readinto);
+    Py_XDECREF (helper->buffer);
+    PyMem_Del (helper);
+}
+
+/* Returns the number of bytes read, 0 at end of file, or -1 on error */
+static Py_ssize_t
+fill_buffer (RWHelper* helper)
+{
+    PyObject* result;
+    Py_ssize_t len;
+
+    if (!helper->buffer)
+    {
+        helper->buffer = PyByteArray_FromStringAndSize (NULL,
+                                                        helper->bufsize);
+        if (!helper->buffer)
+            return -1;
+    }
+    if (helper->bufstart >= 0 && helper->buflen > 0)
+    {
+        /* carry on from the end of the last chunk */
+        helper->bufstart += helper->buflen;
+    }
+    else if (helper->tell)
+    {
+        result = PyObject_CallFunction (helper->tell, NULL);
+        if (result)
+        {
+            helper->bufstart = PyInt_AsLong (result);
+            Py_DECREF (result);
+        }
+        if (PyErr_Occurred ())
+        {
+            PyErr_Clear ();
+            helper->bufstart = -1;
+        }
+    }
+    else
+    {
+        helper->bufstart = -1;
+    }
+    helper->buflen = helper->bufpos = 0;
+
+    if (helper->readinto)
+    {
+        result = PyObject_CallFunctionObjArgs (helper->readinto,
+                                               helper->buffer, NULL);
+        if (!result)
+            return -1;
+        len = result == Py_None ? 0 : PyInt_AsLong (result);
+        Py_DECREF (result);
+        if (len == -1 && PyErr_Occurred ())
+            return -1;
+    }
+    else
+    {
+        result = PyObject_CallFunction (helper->read, "n", helper->bufsize);
+        if (!result)
+            return -1;
+        if (!Bytes_Check (result))
+        {
+            Py_DECREF (result);
+            RAISE (PyExc_TypeError, "read() did not return bytes");
+            return -1;
+        }
+        len = Bytes_GET_SIZE (result);
+        if (len <= helper->bufsize)
+            memcpy (PyByteArray_AS_STRING (helper->buffer),
+                    Bytes_AS_STRING (result), len);
+        Py_DECREF (result);
+    }
+    if (len < 0 || len > helper->bufsize)
+    {
+        RAISE (PyExc_ValueError, "read returned an invalid length");
+        return -1;
+    }
+    helper->buflen = len;
+    return len;
+}
+
+/* Copy up to n bytes to ptr, returning the count or -1 on error */
+static Py_ssize_t
+read_buffered (RWHelper* helper, char* ptr, Py_ssize_t n)
+{
+    Py_ssize_t done = 0;
+    Py_ssize_t count;
+
+    while (done < n)
+    {
+        count = helper->buflen - helper->bufpos;
+        if (count == 0)
+        {
+            count = fill_buffer (helper);
+            if (count < 0)
+                return -1;
+            if (count == 0)
+                break;
+        }
+        if (count > n - done)
+            count = n - done;
+        memcpy (ptr + done,
+                PyByteArray_AS_STRING (helper->buffer) + helper->bufpos,
+                count);
+        helper->bufpos += count;
+        done += count;
+    }
+    return done;
+}
+
+/* Move within the buffer without calling Python, if the target is in it.
+ * Returns the new position, or -1 if Python must do the seek.
+ */
+static int
+seek_in_buffer (RWHelper* helper, int offset, int whence)
+{
+    Py_ssize_t target;
+
+    if (helper->buflen == 0 || helper->bufstart < 0)
+        return -1;
+    if (whence == SEEK_SET)
+        target = offset;
+    else if (whence == SEEK_CUR)
+        target = helper->bufstart + helper->bufpos + offset;
+    else
+        return -1;
+    if (target < helper->bufstart || target > helper->bufstart + helper->buflen)
+        return -1;
+    helper->bufpos = target - helper->bufstart;
+    return (int)target;
+}
+
+static int
+seek_helper (RWHelper* helper, int offset, int whence)
+{
+    PyObject* result;
+    int retval;
+
+    if (!helper->seek || !helper->tell)
+        return -1;
+
+    retval = seek_in_buffer (helper, offset, whence);
+    if (retval >= 0)
+        return retval;
+    if (helper->buflen > 0)
+    {
+        /* The Python position is past the data handed out so far */
+        if (whence == SEEK_CUR)
+        {
+            if (helper->bufstart < 0)
+                return -1;
+            offset += (int)(helper->bufstart + helper->bufpos);
+            whence = SEEK_SET;
+        }
+        helper->buflen = helper->bufpos = 0;
+    }
+
+    if (!(offset == 0 && whence == SEEK_CUR)) /*being called only for 'tell'*/
+    {
+        result = PyObject_CallFunction (helper->seek, "ii", offset, whence);
+        if (!result)
+            return -1;
+        Py_DECREF (result);
+    }
+
+    result = PyObject_CallFunction (helper->tell, NULL);
+    if (!result)
+        return -1;
+
+    retval = PyInt_AsLong (result);
+    Py_DECREF (result);
+
+    return retval;
+}
+
+/* Before a write, put the Python position back where SDL expects it */
+static int
+drop_buffer (RWHelper* helper)
+{
+    PyObject* result;
+
+    if (helper->bufpos < helper->buflen)
+    {
+        if (!helper->seek || helper->bufstart < 0)
+            return -1;
+        result = PyObject_CallFunction (helper->seek, "ni",
+                                        helper->bufstart + helper->bufpos,
+                                        SEEK_SET);
+        if (!result)
+            return -1;
+        Py_DECREF (result);
+    }
+    helper->buflen = helper->bufpos = 0;
+    return 0;
 }
 
 static PyObject*
@@ -247,6 +519,55 @@ RWopsEncodeFilePath(PyObject *obj, PyObject *eclass)
     return result;
 }
 
+#if HAVE_NEW_BUFPROTO
+/* Objects without a read method that export their bytes, such as
+ * memoryview slices of an mmap, are read in place. The export is held
+ * until the RWops is closed, and no Python calls are needed in between,
+ * so loaders can run with the GIL released.
+ */
+static int
+is_buffer_source(PyObject *obj)
+{
+    if (!PyObject_CheckBuffer(obj)) {
+        return 0;
+    }
+    if (PyObject_HasAttrString(obj, "read")) {
+        return 0;
+    }
+    return 1;
+}
+
+static SDL_RWops*
+RWopsFromBuffer(PyObject *obj)
+{
+    SDL_RWops *rw;
+    RWBuffer *helper;
+
+    helper = PyMem_New(RWBuffer, 1);
+    if (helper == NULL) {
+        return (SDL_RWops *)PyErr_NoMemory();
+    }
+    if (PyObject_GetBuffer(obj, &helper->view, PyBUF_SIMPLE)) {
+        PyMem_Del(helper);
+        return NULL;
+    }
+    rw = SDL_AllocRW();
+    if (rw == NULL) {
+        PyBuffer_Release(&helper->view);
+        PyMem_Del(helper);
+        return (SDL_RWops *)PyErr_NoMemory();
+    }
+    helper->pos = 0;
+    rw->hidden.unknown.data1 = (void *)helper;
+    rw->seek = rw_seek_buf;
+    rw->read = rw_read_buf;
+    rw->write = rw_write_buf;
+    rw->close = rw_close_buf;
+
+    return rw;
+}
+#endif
+
 static SDL_RWops*
 RWopsFromFileObject(PyObject *obj)
 {
@@ -256,6 +577,11 @@ RWopsFromFileObject(PyObject *obj)
     if (obj == NULL) {
         return (SDL_RWops *)RAISE(PyExc_TypeError, "Invalid filetype object");
     }
+#if HAVE_NEW_BUFPROTO
+    if (is_buffer_source(obj)) {
+        return RWopsFromBuffer(obj);
+    }
+#endif
     helper = PyMem_New(RWHelper, 1);
     if (helper == NULL) {
         return (SDL_RWops *)PyErr_NoMemory();
@@ -309,28 +635,8 @@ static int
 rw_seek (SDL_RWops* context, int offset, int whence)
 {
     RWHelper* helper = (RWHelper*) context->hidden.unknown.data1;
-    PyObject* result;
-    int retval;
-
-    if (!helper->seek || !helper->tell)
-        return -1;
 
-    if (!(offset == 0 && whence == SEEK_CUR)) /*being called only for 'tell'*/
-    {
-        result = PyObject_CallFunction (helper->seek, "ii", offset, whence);
-        if (!result)
-            return -1;
-        Py_DECREF (result);
-    }
-
-    result = PyObject_CallFunction (helper->tell, NULL);
-    if (!result)
-        return -1;
-
-    retval = PyInt_AsLong (result);
-    Py_DECREF (result);
-
-    return retval;
+    return seek_helper (helper, offset, whence);
 }
 
 static int
@@ -343,6 +649,12 @@ rw_read (SDL_RWops* context, void* ptr, int size, int maxnum)
     if (!helper->read)
         return -1;
 
+    if (helper->bufsize > 0)
+    {
+        retval = read_buffered (helper, (char*) ptr, size * maxnum);
+        return retval < 0 ? -1 : retval / size;
+    }
+
     result = PyObject_CallFunction (helper->read, "i", size * maxnum);
     if (!result)
         return -1;
@@ -369,6 +681,8 @@ rw_write (SDL_RWops* context, const void* ptr, int size, int num)
 
     if (!helper->write)
         return -1;
+    if (drop_buffer (helper))
+        return -1;
 
     result = PyObject_CallFunction (helper->write, "s#", ptr, size * num);
     if(!result)
@@ -385,6 +699,10 @@ rw_close (SDL_RWops* context)
     PyObject* result;
     int retval = 0;
 
+    /* Leave the object just past the data SDL consumed */
+    if (helper->seek && drop_buffer (helper))
+        PyErr_Clear ();
+
     if (helper->close)
     {
         result = PyObject_CallFunction (helper->close, NULL);
@@ -393,16 +711,263 @@ rw_close (SDL_RWops* context)
         Py_XDECREF (result);
     }
 
-    Py_XDECREF (helper->seek);
-    Py_XDECREF (helper->tell);
-    Py_XDECREF (helper->write);
-    Py_XDECREF (helper->read);
-    Py_XDECREF (helper->close);
-    PyMem_Del (helper);
+    release_helper (helper);
     SDL_FreeRW (context);
     return retval;
 }
 
+#if HAVE_NEW_BUFPROTO
+static int
+rw_seek_buf (SDL_RWops* context, int offset, int whence)
+{
+    RWBuffer* helper = (RWBuffer*) context->hidden.unknown.data1;
+    Py_ssize_t pos;
+
+    switch (whence)
+    {
+    case SEEK_SET:
+        pos = offset;
+        break;
+    case SEEK_CUR:
+        pos = helper->pos + offset;
+        break;
+    case SEEK_END:
+        pos = helper->view.len + offset;
+        break;
+    default:
+        SDL_SetError ("Unknown value for 'whence'");
+        return -1;
+    }
+    if (pos < 0)
+        pos = 0;
+    if (pos > helper->view.len)
+        pos = helper->view.len;
+    helper->pos = pos;
+    return (int)pos;
+}
+
+static int
+rw_read_buf (SDL_RWops* context, void* ptr, int size, int maxnum)
+{
+    RWBuffer* helper = (RWBuffer*) context->hidden.unknown.data1;
+    Py_ssize_t num;
+
+    if (size <= 0 || maxnum <= 0)
+        return 0;
+    num = (helper->view.len - helper->pos) / size;
+    if (num > maxnum)
+        num = maxnum;
+    memcpy (ptr, (char*) helper->view.buf + helper->pos, num * size);
+    helper->pos += num * size;
+    return (int)num;
+}
+
+static int
+rw_write_buf (SDL_RWops* context, const void* ptr, int size, int num)
+{
+    SDL_SetError ("Cannot write to a read-only buffer");
+    return -1;
+}
+
+static int
+rw_close_buf (SDL_RWops* context)
+{
+    RWBuffer* helper = (RWBuffer*) context->hidden.unknown.data1;
+#ifdef WITH_THREAD
+    PyGILState_STATE state;
+
+    state = PyGILState_Ensure();
+#endif
+    PyBuffer_Release (&helper->view);
+    PyMem_Del (helper);
+#ifdef WITH_THREAD
+    PyGILState_Release(state);
+#endif
+
+    SDL_FreeRW (context);
+    return 0;
+}
+#endif
+
+#ifdef PG_HAVE_FD_RWOPS
+/* Test for the file objects made by open(). Other types with a fileno
+ * method, such as gzip files, may not read the descriptor's raw bytes.
+ */
+static int
+is_plain_file(PyObject *obj)
+{
+#if PY3
+    const char *name = Py_TYPE(obj)->tp_name;
+
+    return (!strcmp(name, "_io.BufferedReader") ||
+            !strcmp(name, "_io.BufferedRandom") ||
+            !strcmp(name, "_io.FileIO"));
+#else
+    return PyFile_Check(obj);
+#endif
+}
+
+/* A regular file opened by Python is read through a duplicate of its
+ * descriptor with pread, starting at the object's current position, so
+ * SDL needs neither the GIL nor Python calls. Closing moves the object
+ * just past the data SDL consumed. Returns NULL, with no Python error,
+ * if obj does not qualify.
+ */
+static SDL_RWops*
+RWopsFromFileDescriptor(PyObject *obj)
+{
+    PyObject *result;
+    RWDescriptor *helper;
+    SDL_RWops *rw;
+    long fd;
+    long pos;
+    struct stat st;
+
+    if (!is_plain_file(obj)) {
+        return NULL;
+    }
+    result = PyObject_CallMethod(obj, "fileno", NULL);
+    if (result == NULL) {
+        PyErr_Clear();
+        return NULL;
+    }
+    fd = PyInt_AsLong(result);
+    Py_DECREF(result);
+    if (fd < 0 || fstat((int)fd, &st) || !S_ISREG(st.st_mode)) {
+        PyErr_Clear();
+        return NULL;
+    }
+    result = PyObject_CallMethod(obj, "tell", NULL);
+    if (result == NULL) {
+        PyErr_Clear();
+        return NULL;
+    }
+    pos = PyInt_AsLong(result);
+    Py_DECREF(result);
+    if (pos < 0) {
+        PyErr_Clear();
+        return NULL;
+    }
+
+    helper = (RWDescriptor *)malloc(sizeof(RWDescriptor));
+    if (helper == NULL) {
+        return NULL;
+    }
+    helper->fd = dup((int)fd);
+    if (helper->fd < 0) {
+        free(helper);
+        return NULL;
+    }
+    helper->pos = (off_t)pos;
+    helper->obj = obj;
+    rw = SDL_AllocRW();
+    if (rw == NULL) {
+        close(helper->fd);
+        free(helper);
+        return NULL;
+    }
+    rw->hidden.unknown.data1 = (void *)helper;
+    rw->seek = rw_seek_fd;
+    rw->read = rw_read_fd;
+    rw->write = rw_write_fd;
+    rw->close = rw_close_fd;
+    Py_INCREF(obj);
+
+    return rw;
+}
+
+static int
+rw_seek_fd (SDL_RWops* context, int offset, int whence)
+{
+    RWDescriptor* helper = (RWDescriptor*) context->hidden.unknown.data1;
+    struct stat st;
+
+    switch (whence)
+    {
+    case SEEK_SET:
+        helper->pos = offset;
+        break;
+    case SEEK_CUR:
+        helper->pos += offset;
+        break;
+    case SEEK_END:
+        if (fstat (helper->fd, &st))
+        {
+            SDL_SetError ("Error seeking in datastream");
+            return -1;
+        }
+        helper->pos = st.st_size + offset;
+        break;
+    default:
+        SDL_SetError ("Unknown value for 'whence'");
+        return -1;
+    }
+    if (helper->pos < 0)
+        helper->pos = 0;
+    return (int)helper->pos;
+}
+
+static int
+rw_read_fd (SDL_RWops* context, void* ptr, int size, int maxnum)
+{
+    RWDescriptor* helper = (RWDescriptor*) context->hidden.unknown.data1;
+    size_t want = (size_t)size * maxnum;
+    size_t done = 0;
+    ssize_t count;
+
+    if (size <= 0)
+        return 0;
+    while (done < want)
+    {
+        count = pread (helper->fd, (char*) ptr + done, want - done,
+                       helper->pos + done);
+        if (count < 0)
+        {
+            SDL_SetError ("Error reading from datastream");
+            return -1;
+        }
+        if (count == 0)
+            break;
+        done += count;
+    }
+    helper->pos += done;
+    return (int)(done / size);
+}
+
+static int
+rw_write_fd (SDL_RWops* context, const void* ptr, int size, int num)
+{
+    SDL_SetError ("Cannot write to a file opened for loading");
+    return -1;
+}
+
+static int
+rw_close_fd (SDL_RWops* context)
+{
+    RWDescriptor* helper = (RWDescriptor*) context->hidden.unknown.data1;
+    PyObject* result;
+#ifdef WITH_THREAD
+    PyGILState_STATE state;
+
+    state = PyGILState_Ensure();
+#endif
+    result = PyObject_CallMethod (helper->obj, "seek", "ni",
+                                  (Py_ssize_t) helper->pos, SEEK_SET);
+    if (!result)
+        PyErr_Clear ();
+    Py_XDECREF (result);
+    Py_DECREF (helper->obj);
+#ifdef WITH_THREAD
+    PyGILState_Release (state);
+#endif
+
+    close (helper->fd);
+    free (helper);
+    SDL_FreeRW (context);
+    return 0;
+}
+#endif
+
 static SDL_RWops*
 RWopsFromFileObjectThreaded(PyObject *obj)
 {
@@ -413,6 +978,18 @@ RWopsFromFileObjectThreaded(PyObject *obj)
         return (SDL_RWops *)RAISE(PyExc_TypeError, "Invalid filetype object");
     }
 
+#if HAVE_NEW_BUFPROTO
+    if (is_buffer_source(obj)) {
+        return RWopsFromBuffer(obj);
+    }
+#endif
+#ifdef PG_HAVE_FD_RWOPS
+    rw = RWopsFromFileDescriptor(obj);
+    if (rw != NULL) {
+        return rw;
+    }
+#endif
+
 #ifndef WITH_THREAD
     return (SDL_RWops *)RAISE(PyExc_NotImplementedError,
                               "Python built without thread support");
@@ -454,7 +1031,6 @@ static int
 rw_seek_th (SDL_RWops* context, int offset, int whence)
 {
     RWHelper* helper = (RWHelper*) context->hidden.unknown.data1;
-    PyObject* result;
     int retval;
     PyGILState_STATE state;
 
@@ -462,32 +1038,17 @@ rw_seek_th (SDL_RWops* context, int offset, int whence)
     if (!helper->seek || !helper->tell)
         return -1;
 
-    state = PyGILState_Ensure();
+    /* Seeks within the read ahead buffer need no GIL */
+    retval = seek_in_buffer (helper, offset, whence);
+    if (retval >= 0)
+        return retval;
 
-    if (!(offset == 0 && whence == SEEK_CUR)) /* being seek'd, not just tell'd */
-    {
-        result = PyObject_CallFunction (helper->seek, "ii", offset, whence);
-        if(!result)
-        {
-            PyErr_Print();
-            retval = -1;
-            goto end;
-        }
-        Py_DECREF (result);
-    }
+    state = PyGILState_Ensure();
 
-    result = PyObject_CallFunction (helper->tell, NULL);
-    if (!result)
-    {
+    retval = seek_helper (helper, offset, whence);
+    if (retval == -1 && PyErr_Occurred ())
         PyErr_Print();
-        retval = -1;
-        goto end;
-    }
-
-    retval = PyInt_AsLong (result);
-    Py_DECREF (result);
 
-end:
     PyGILState_Release(state);
 
     return retval;
@@ -504,8 +1065,31 @@ rw_read_th (SDL_RWops* context, void* ptr, int size, int maxnum)
     if (!helper->read)
         return -1;
 
+    /* Reads served from the read ahead buffer need no GIL */
+    if (helper->bufsize > 0 && helper->buflen > 0 &&
+        helper->buflen - helper->bufpos >= (Py_ssize_t)size * maxnum)
+    {
+        memcpy (ptr, PyByteArray_AS_STRING (helper->buffer) + helper->bufpos,
+                size * maxnum);
+        helper->bufpos += size * maxnum;
+        return maxnum;
+    }
+
     state = PyGILState_Ensure();
 
+    if (helper->bufsize > 0)
+    {
+        retval = read_buffered (helper, (char*) ptr, size * maxnum);
+        if (retval < 0)
+        {
+            PyErr_Print();
+            retval = -1;
+        }
+        else
+            retval /= size;
+        goto end;
+    }
+
     result = PyObject_CallFunction (helper->read, "i", size * maxnum);
     if (!result)
     {
@@ -547,6 +1131,14 @@ rw_write_th (SDL_RWops* context, const void* ptr, int size, int num)
 
     state = PyGILState_Ensure();
 
+    if (drop_buffer (helper))
+    {
+        if (PyErr_Occurred ())
+            PyErr_Print();
+        retval = -1;
+        goto end;
+    }
+
     result = PyObject_CallFunction (helper->write, "s#", ptr, size * num);
     if (!result)
     {
@@ -574,6 +1166,9 @@ rw_close_th (SDL_RWops* context)
 
     state = PyGILState_Ensure();
 
+    if (helper->seek && drop_buffer (helper))
+        PyErr_Clear ();
+
     if (helper->close)
     {
         result = PyObject_CallFunction (helper->close, NULL);
@@ -585,13 +1180,7 @@ rw_close_th (SDL_RWops* context)
         Py_XDECREF (result);
     }
 
-    Py_XDECREF (helper->seek);
-    Py_XDECREF (helper->tell);
-    Py_XDECREF (helper->write);
-    Py_XDECREF (helper->read);
-    Py_XDECREF (helper->close);
-
-    PyMem_Del (helper);
+    release_helper (helper);
 
     PyGILState_Release(state);
 
@@ -639,12 +1228,37 @@ rwobject_encode_file_path(PyObject *self, PyObject *args, PyObject *keywds)
     return RWopsEncodeFilePath(obj, eclass);
 }
 
+static PyObject*
+rwobject_set_buffer_size(PyObject *self, PyObject *args)
+{
+    Py_ssize_t size;
+
+    if (!PyArg_ParseTuple(args, "n", &size)) {
+        return NULL;
+    }
+    if (size < 0) {
+        return RAISE(PyExc_ValueError, "buffer size must not be negative");
+    }
+    rw_buffer_size = size;
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+rwobject_get_buffer_size(PyObject *self)
+{
+    return PyInt_FromSsize_t(rw_buffer_size);
+}
+
 static PyMethodDef _rwobject_methods[] =
 {
     { "encode_string", (PyCFunction)rwobject_encode_string,
       METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEENCODESTRING },
     { "encode_file_path", (PyCFunction)rwobject_encode_file_path,
       METH_VARARGS | METH_KEYWORDS, DOC_PYGAMEENCODEFILEPATH },
+    { "set_rwops_buffer_size", rwobject_set_buffer_size, METH_VARARGS,
+      DOC_PYGAMERWOBJECTSETRWOPSBUFFERSIZE },
+    { "get_rwops_buffer_size", (PyCFunction)rwobject_get_buffer_size,
+      METH_NOARGS, DOC_PYGAMERWOBJECTGETRWOPSBUFFERSIZE },
     { NULL, NULL, 0, NULL }
 };
 
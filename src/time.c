@@ -24,7 +24,28 @@
 #include "pgcompat.h"
 #include "doc/time_doc.h"
 
+#if defined(WIN32)
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#include <sys/time.h>
+#endif
+
 #define WORST_CLOCK_ACCURACY 12
+
+/* tick_precise() spins for the last part of each wait; the margin follows
+ * how late SDL_Delay wakes up, within these bounds.
+ */
+#define SPIN_MIN_NS 200000
+#define SPIN_MAX_NS 4000000
+#define SPIN_START_NS 2000000
+
+/* frame time statistics */
+#define CLOCK_HISTORY 256
+#define CLOCK_MAX_HISTORY 65536
+#define CLOCK_MAX_SECTIONS 32
 static SDL_TimerID event_timers[SDL_NUMEVENTS] = {NULL};
 
 static Uint32
@@ -40,6 +61,76 @@ timer_callback (Uint32 interval, void* param)
     return interval;
 }
 
+/* A monotonic clock in nanoseconds */
+static PY_LONG_LONG
+clock_ns (void)
+{
+#if defined(WIN32)
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER count;
+
+    if (!freq.QuadPart)
+        QueryPerformanceFrequency (&freq);
+    QueryPerformanceCounter (&count);
+    /* split to keep count * 1e9 from overflowing */
+    return (count.QuadPart / freq.QuadPart) * 1000000000
+        + (count.QuadPart % freq.QuadPart) * 1000000000 / freq.QuadPart;
+#elif defined(__APPLE__)
+    static mach_timebase_info_data_t base;
+
+    if (!base.denom)
+        mach_timebase_info (&base);
+    return (PY_LONG_LONG) (mach_absolute_time () * base.numer / base.denom);
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return (PY_LONG_LONG) ts.tv_sec * 1000000000 + ts.tv_nsec;
+#else
+    struct timeval tv;
+
+    gettimeofday (&tv, NULL);
+    return (PY_LONG_LONG) tv.tv_sec * 1000000000
+        + (PY_LONG_LONG) tv.tv_usec * 1000;
+#endif
+}
+
+/* Wait until deadline on clock_ns(): sleep in whole milliseconds while
+ * more than *spin_ns away, then spin. *spin_ns is raised at once when a
+ * sleep overshoots by more, and eased back down otherwise. Called
+ * without the GIL.
+ */
+static void
+precise_wait (PY_LONG_LONG deadline, PY_LONG_LONG* spin_ns)
+{
+    PY_LONG_LONG now, slept, over, margin = *spin_ns;
+    Uint32 ms;
+
+    now = clock_ns ();
+    while (deadline - now > margin)
+    {
+        ms = (Uint32) ((deadline - now - margin) / 1000000);
+        if (!ms)
+            break;
+        SDL_Delay (ms);
+        slept = clock_ns () - now;
+        now += slept;
+
+        over = slept - (PY_LONG_LONG) ms * 1000000 + SPIN_MIN_NS / 2;
+        if (over > margin)
+            margin = over;
+        else
+            margin -= (margin - over) / 16;
+        if (margin < SPIN_MIN_NS)
+            margin = SPIN_MIN_NS;
+        else if (margin > SPIN_MAX_NS)
+            margin = SPIN_MAX_NS;
+    }
+    while (now < deadline)
+        now = clock_ns ();
+    *spin_ns = margin;
+}
+
 static int
 accurate_delay (int ticks)
 {
@@ -181,6 +272,19 @@ time_set_timer (PyObject* self, PyObject* arg)
 }
 
 /*clock object interface*/
+
+/* A named part of the frame, timed between begin_section() and
+ * end_section(). Its per frame totals share the frame ring's positions.
+ */
+typedef struct
+{
+    PyObject* name;
+    Uint32* times;
+    int count;                  /* frames recorded since it was added */
+    PY_LONG_LONG start_ns;      /* 0 when not inside the section */
+    PY_LONG_LONG frame_ns;      /* time spent inside it this frame */
+} ClockSection;
+
 typedef struct
 {
     PyObject_HEAD
@@ -189,8 +293,67 @@ typedef struct
     float fps;
     int timepassed, rawpassed;
     PyObject* rendered;
+    PY_LONG_LONG last_ns;       /* clock_ns() at the previous tick */
+    PY_LONG_LONG deadline_ns;   /* tick_precise() target, 0 if unset */
+    PY_LONG_LONG spin_ns;       /* spin margin for precise_wait() */
+    Uint32* frames;             /* ring of recent frame times in ns */
+    int history, frame_pos, frame_count;
+    ClockSection* sections;
+    int num_sections;
 } PyClockObject;
 
+static Uint32
+clamp_ns (PY_LONG_LONG ns)
+{
+    if (ns < 0)
+        return 0;
+    if (ns > 0xFFFFFFFF)
+        return 0xFFFFFFFF;
+    return (Uint32) ns;
+}
+
+static void
+clock_count_frame (PyClockObject* _clock, int nowtime, PY_LONG_LONG now_ns,
+                   PY_LONG_LONG frame_ns)
+{
+    ClockSection* sect;
+    int i;
+
+    _clock->frames[_clock->frame_pos] = clamp_ns (frame_ns);
+    for (i = 0; i < _clock->num_sections; ++i)
+    {
+        sect = &_clock->sections[i];
+        if (sect->start_ns)
+        {
+            /* still open: split it across the frames */
+            sect->frame_ns += now_ns - sect->start_ns;
+            sect->start_ns = now_ns;
+        }
+        sect->times[_clock->frame_pos] = clamp_ns (sect->frame_ns);
+        sect->frame_ns = 0;
+        if (sect->count < _clock->history)
+            sect->count += 1;
+    }
+    _clock->frame_pos = (_clock->frame_pos + 1) % _clock->history;
+    if (_clock->frame_count < _clock->history)
+        _clock->frame_count += 1;
+
+    _clock->fps_count += 1;
+    if (!_clock->fps_tick)
+    {
+        _clock->fps_count = 0;
+        _clock->fps_tick = nowtime;
+    }
+    else if (_clock->fps_count >= 10)
+    {
+        _clock->fps = _clock->fps_count /
+            ((nowtime - _clock->fps_tick) / 1000.0f);
+        _clock->fps_count = 0;
+        _clock->fps_tick = nowtime;
+        Py_XDECREF (_clock->rendered);
+    }
+}
+
 // to be called by the other tick functions.
 static PyObject*
 clock_tick_base(PyObject* self, PyObject* arg, int use_accurate_delay)
@@ -198,6 +361,7 @@ clock_tick_base(PyObject* self, PyObject* arg, int use_accurate_delay)
     PyClockObject* _clock = (PyClockObject*) self;
     float framerate = 0.0f;
     int nowtime;
+    PY_LONG_LONG now_ns, frame_ns;
 
     if (!PyArg_ParseTuple (arg, "|f", &framerate))
         return NULL;
@@ -237,24 +401,17 @@ clock_tick_base(PyObject* self, PyObject* arg, int use_accurate_delay)
 
     nowtime = SDL_GetTicks ();
     _clock->timepassed = nowtime - _clock->last_tick;
-    _clock->fps_count += 1;
     _clock->last_tick = nowtime;
     if (!framerate)
         _clock->rawpassed = _clock->timepassed;
 
-    if (!_clock->fps_tick)
-    {
-        _clock->fps_count = 0;
-        _clock->fps_tick = nowtime;
-    }
-    else if (_clock->fps_count >= 10)
-    {
-        _clock->fps = _clock->fps_count /
-            ((nowtime - _clock->fps_tick) / 1000.0f);
-        _clock->fps_count = 0;
-        _clock->fps_tick = nowtime;
-        Py_XDECREF (_clock->rendered);
-    }
+    /* tick_precise() starts its schedule over after a plain tick */
+    now_ns = clock_ns ();
+    frame_ns = now_ns - _clock->last_ns;
+    _clock->last_ns = now_ns;
+    _clock->deadline_ns = 0;
+
+    clock_count_frame (_clock, nowtime, now_ns, frame_ns);
     return PyInt_FromLong (_clock->timepassed);
 }
 
@@ -270,6 +427,305 @@ clock_tick_busy_loop (PyObject* self, PyObject* arg)
     return clock_tick_base (self, arg, 1);
 }
 
+static PyObject*
+clock_tick_precise (PyObject* self, PyObject* arg)
+{
+    PyClockObject* _clock = (PyClockObject*) self;
+    float framerate = 0.0f;
+    PY_LONG_LONG period, now, deadline, spin_ns, passed;
+
+    if (!PyArg_ParseTuple (arg, "|f", &framerate))
+        return NULL;
+    if (framerate < 0)
+        return RAISE (PyExc_ValueError, "framerate must not be negative");
+
+    now = clock_ns ();
+    _clock->rawpassed = (int) ((now - _clock->last_ns) / 1000000);
+
+    if (framerate)
+    {
+        period = (PY_LONG_LONG) (1000000000.0 / framerate);
+
+        /* Keep to a fixed schedule so a late frame shortens the next
+         * wait, unless a whole frame was lost; then start over from now.
+         */
+        deadline = _clock->deadline_ns;
+        if (!deadline)
+            deadline = _clock->last_ns;
+        deadline += period;
+        if (now - deadline > period)
+            deadline = now;
+
+        spin_ns = _clock->spin_ns;
+        if (deadline > now)
+        {
+            Py_BEGIN_ALLOW_THREADS;
+            precise_wait (deadline, &spin_ns);
+            Py_END_ALLOW_THREADS;
+            now = clock_ns ();
+        }
+        _clock->spin_ns = spin_ns;
+        _clock->deadline_ns = deadline;
+    }
+    else
+        _clock->deadline_ns = 0;
+
+    passed = now - _clock->last_ns;
+    _clock->timepassed = (int) (passed / 1000000);
+    if (!framerate)
+        _clock->rawpassed = _clock->timepassed;
+    _clock->last_ns = now;
+    _clock->last_tick = SDL_GetTicks ();
+
+    clock_count_frame (_clock, _clock->last_tick, now, passed);
+    return PyFloat_FromDouble (passed / 1000000.0);
+}
+
+static ClockSection*
+clock_find_section (PyClockObject* _clock, PyObject* name)
+{
+    int i, same;
+
+    for (i = 0; i < _clock->num_sections; ++i)
+    {
+        if (_clock->sections[i].name == name)
+            return &_clock->sections[i];
+    }
+    for (i = 0; i < _clock->num_sections; ++i)
+    {
+        same = PyObject_RichCompareBool (_clock->sections[i].name, name,
+                                         Py_EQ);
+        if (same < 0)
+            return NULL;
+        if (same)
+            return &_clock->sections[i];
+    }
+    return NULL;
+}
+
+static PyObject*
+clock_begin_section (PyObject* self, PyObject* name)
+{
+    PyClockObject* _clock = (PyClockObject*) self;
+    PY_LONG_LONG now = clock_ns ();
+    ClockSection* sect = clock_find_section (_clock, name);
+
+    if (!sect)
+    {
+        if (PyErr_Occurred ())
+            return NULL;
+        if (!Text_Check (name) && !PyUnicode_Check (name))
+            return RAISE (PyExc_TypeError, "section name must be a string");
+        if (_clock->num_sections == CLOCK_MAX_SECTIONS)
+            return RAISE (PyExc_ValueError, "too many clock sections");
+        if (!_clock->sections)
+        {
+            _clock->sections = PyMem_New (ClockSection, CLOCK_MAX_SECTIONS);
+            if (!_clock->sections)
+                return PyErr_NoMemory ();
+        }
+        sect = &_clock->sections[_clock->num_sections];
+        sect->times = PyMem_New (Uint32, _clock->history);
+        if (!sect->times)
+            return PyErr_NoMemory ();
+        Py_INCREF (name);
+        sect->name = name;
+        sect->count = 0;
+        sect->frame_ns = 0;
+        _clock->num_sections += 1;
+    }
+    else if (sect->start_ns)
+        return RAISE (PyExc_ValueError, "clock section is already open");
+    sect->start_ns = now;
+    Py_RETURN_NONE;
+}
+
+static PyObject*
+clock_end_section (PyObject* self, PyObject* name)
+{
+    PyClockObject* _clock = (PyClockObject*) self;
+    PY_LONG_LONG now = clock_ns ();
+    ClockSection* sect = clock_find_section (_clock, name);
+
+    if (!sect || !sect->start_ns)
+    {
+        if (PyErr_Occurred ())
+            return NULL;
+        return RAISE (PyExc_ValueError, "clock section was not begun");
+    }
+    sect->frame_ns += now - sect->start_ns;
+    sect->start_ns = 0;
+    Py_RETURN_NONE;
+}
+
+/* Copy the recorded frame times, for the clock or one of its sections,
+ * into a new array. Sets *count; returns NULL with an exception set.
+ */
+static Uint32*
+clock_collect (PyClockObject* _clock, PyObject* section, int* count)
+{
+    Uint32 *ring = _clock->frames, *out;
+    int n = _clock->frame_count, i, pos;
+    ClockSection* sect;
+
+    if (section && section != Py_None)
+    {
+        sect = clock_find_section (_clock, section);
+        if (!sect)
+        {
+            if (!PyErr_Occurred ())
+                PyErr_SetString (PyExc_KeyError, "no such clock section");
+            return NULL;
+        }
+        ring = sect->times;
+        n = sect->count;
+    }
+
+    out = PyMem_New (Uint32, n ? n : 1);
+    if (!out)
+    {
+        PyErr_NoMemory ();
+        return NULL;
+    }
+    pos = _clock->frame_pos;
+    for (i = 0; i < n; ++i)
+    {
+        pos = pos ? pos - 1 : _clock->history - 1;
+        out[i] = ring[pos];
+    }
+    *count = n;
+    return out;
+}
+
+static int
+compare_uint32 (const void* a, const void* b)
+{
+    Uint32 x = *(const Uint32*) a, y = *(const Uint32*) b;
+    return x < y ? -1 : x > y;
+}
+
+static PyObject*
+clock_get_frame_percentiles (PyObject* self, PyObject* args, PyObject* kwds)
+{
+    PyClockObject* _clock = (PyClockObject*) self;
+    PyObject *percents = NULL, *section = NULL, *seq, *result;
+    Uint32* times;
+    Py_ssize_t num, i;
+    double percent, value;
+    int count, index;
+    static char *kwids[] = {"percents", "section", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "|OO", kwids,
+                                      &percents, &section))
+        return NULL;
+
+    if (percents)
+        seq = PySequence_Fast (percents, "percents must be a sequence");
+    else
+        seq = Py_BuildValue ("(iii)", 50, 95, 99);
+    if (!seq)
+        return NULL;
+
+    times = clock_collect (_clock, section, &count);
+    if (!times)
+    {
+        Py_DECREF (seq);
+        return NULL;
+    }
+    qsort (times, count, sizeof (Uint32), compare_uint32);
+
+    num = PySequence_Fast_GET_SIZE (seq);
+    result = PyTuple_New (num);
+    for (i = 0; result && i < num; ++i)
+    {
+        percent = PyFloat_AsDouble (PySequence_Fast_GET_ITEM (seq, i));
+        if (percent == -1.0 && PyErr_Occurred ())
+        {
+            Py_DECREF (result);
+            result = NULL;
+            break;
+        }
+        if (!(percent >= 0 && percent <= 100))
+        {
+            Py_DECREF (result);
+            result = RAISE (PyExc_ValueError,
+                            "percents must be from 0 to 100");
+            break;
+        }
+
+        /* nearest rank */
+        value = 0.0;
+        if (count)
+        {
+            index = (int) ceil (percent / 100.0 * count) - 1;
+            if (index < 0)
+                index = 0;
+            value = times[index] / 1000000.0;
+        }
+        PyTuple_SET_ITEM (result, i, PyFloat_FromDouble (value));
+    }
+
+    PyMem_Free (times);
+    Py_DECREF (seq);
+    return result;
+}
+
+static PyObject*
+clock_get_frame_histogram (PyObject* self, PyObject* args, PyObject* kwds)
+{
+    PyClockObject* _clock = (PyClockObject*) self;
+    PyObject *section = NULL, *result, *item;
+    Uint32* times;
+    long* bins;
+    double bin_ms = 1.0;
+    int numbins = 32, count, i, b;
+    static char *kwids[] = {"bin_ms", "bins", "section", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "|diO", kwids,
+                                      &bin_ms, &numbins, &section))
+        return NULL;
+    if (bin_ms <= 0)
+        return RAISE (PyExc_ValueError, "bin_ms must be positive");
+    if (numbins < 1)
+        return RAISE (PyExc_ValueError, "bins must be positive");
+
+    times = clock_collect (_clock, section, &count);
+    if (!times)
+        return NULL;
+    bins = PyMem_New (long, numbins);
+    if (!bins)
+    {
+        PyMem_Free (times);
+        return PyErr_NoMemory ();
+    }
+    memset (bins, 0, numbins * sizeof (long));
+
+    /* the last bin also holds everything slower */
+    for (i = 0; i < count; ++i)
+    {
+        double b_f = times[i] / (bin_ms * 1000000.0);
+
+        b = b_f >= numbins ? numbins - 1 : (int) b_f;
+        bins[b] += 1;
+    }
+    PyMem_Free (times);
+
+    result = PyList_New (numbins);
+    for (i = 0; result && i < numbins; ++i)
+    {
+        item = PyInt_FromLong (bins[i]);
+        if (!item)
+        {
+            Py_DECREF (result);
+            result = NULL;
+            break;
+        }
+        PyList_SET_ITEM (result, i, item);
+    }
+    PyMem_Free (bins);
+    return result;
+}
+
 static PyObject*
 clock_get_fps (PyObject* self, PyObject* args)
 {
@@ -303,6 +759,14 @@ static struct PyMethodDef clock_methods[] =
       DOC_CLOCKGETRAWTIME },
     { "tick_busy_loop", clock_tick_busy_loop, METH_VARARGS,
       DOC_CLOCKTICKBUSYLOOP },
+    { "tick_precise", clock_tick_precise, METH_VARARGS,
+      DOC_CLOCKTICKPRECISE },
+    { "begin_section", clock_begin_section, METH_O, DOC_CLOCKBEGINSECTION },
+    { "end_section", clock_end_section, METH_O, DOC_CLOCKENDSECTION },
+    { "get_frame_percentiles", (PyCFunction) clock_get_frame_percentiles,
+      METH_VARARGS | METH_KEYWORDS, DOC_CLOCKGETFRAMEPERCENTILES },
+    { "get_frame_histogram", (PyCFunction) clock_get_frame_histogram,
+      METH_VARARGS | METH_KEYWORDS, DOC_CLOCKGETFRAMEHISTOGRAM },
     { NULL, NULL, 0, NULL}
 };
 
@@ -310,7 +774,16 @@ static void
 clock_dealloc (PyObject* self)
 {
     PyClockObject* _clock = (PyClockObject*) self;
+    int i;
+
     Py_XDECREF (_clock->rendered);
+    for (i = 0; i < _clock->num_sections; ++i)
+    {
+        Py_DECREF (_clock->sections[i].name);
+        PyMem_Free (_clock->sections[i].times);
+    }
+    PyMem_Free (_clock->sections);
+    PyMem_Free (_clock->frames);
     PyObject_DEL (self);
 }
 
@@ -368,19 +841,44 @@ static PyTypeObject PyClock_Type =
 };
 
 PyObject*
-ClockInit (PyObject* self)
+ClockInit (PyObject* self, PyObject* args, PyObject* kwds)
 {
-    PyClockObject* _clock = PyObject_NEW (PyClockObject, &PyClock_Type);
+    PyClockObject* _clock;
+    int history = CLOCK_HISTORY;
+    static char *kwids[] = {"history", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwds, "|i", kwids, &history))
+        return NULL;
+    if (history < 1 || history > CLOCK_MAX_HISTORY)
+        return PyErr_Format (PyExc_ValueError,
+                             "history must be from 1 to %d",
+                             CLOCK_MAX_HISTORY);
 
+    _clock = PyObject_NEW (PyClockObject, &PyClock_Type);
     if (!_clock) {
         return NULL;
     }
+    _clock->rendered = NULL;
+    _clock->sections = NULL;
+    _clock->num_sections = 0;
+    _clock->history = history;
+    _clock->frame_pos = 0;
+    _clock->frame_count = 0;
+    _clock->frames = PyMem_New (Uint32, history);
+    if (!_clock->frames)
+    {
+        Py_DECREF (_clock);
+        return PyErr_NoMemory ();
+    }
 
     /*just doublecheck that timer is initialized*/
     if (!SDL_WasInit (SDL_INIT_TIMER))
     {
         if (SDL_InitSubSystem (SDL_INIT_TIMER))
+        {
+            Py_DECREF (_clock);
             return RAISE (PyExc_SDLError, SDL_GetError ());
+        }
     }
 
     _clock->fps_tick = 0;
@@ -389,7 +887,9 @@ ClockInit (PyObject* self)
     _clock->last_tick = SDL_GetTicks ();
     _clock->fps = 0.0f;
     _clock->fps_count = 0;
-    _clock->rendered = NULL;
+    _clock->last_ns = clock_ns ();
+    _clock->deadline_ns = 0;
+    _clock->spin_ns = SPIN_START_NS;
 
     return (PyObject*) _clock;
 }
@@ -402,7 +902,8 @@ static PyMethodDef _time_methods[] =
     { "wait", time_wait, METH_VARARGS, DOC_PYGAMETIMEWAIT },
     { "set_timer", time_set_timer, METH_VARARGS, DOC_PYGAMETIMESETTIMER },
 
-    { "Clock", (PyCFunction) ClockInit, METH_NOARGS, DOC_PYGAMETIMECLOCK },
+    { "Clock", (PyCFunction) ClockInit, METH_VARARGS | METH_KEYWORDS,
+      DOC_PYGAMETIMECLOCK },
 
     { NULL, NULL, 0, NULL }
 };
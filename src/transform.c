@@ -31,6 +31,26 @@
 #include <string.h>
 #include "scale.h"
 
+/* SSE2 is part of the x86-64 baseline, so the 32 bit pixel kernels for
+ * threshold, laplacian and average_color need no run time check there.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRANSFORM_SSE2_SUPPORT
+#include <emmintrin.h>
+
+/* True for 32 bit formats with 8 bit color channels on byte boundaries,
+ * so that each channel is one byte lane of the pixel.
+ */
+static int
+_bytelane_format (SDL_PixelFormat *format)
+{
+    return (format->BytesPerPixel == 4 &&
+            format->Rloss == 0 && format->Gloss == 0 && format->Bloss == 0 &&
+            !(format->Rshift & 7) && !(format->Gshift & 7) &&
+            !(format->Bshift & 7) &&
+            (!format->Amask || (format->Aloss == 0 && !(format->Ashift & 7))));
+}
+#endif /* defined(TRANSFORM_SSE2_SUPPORT) */
 
 typedef void (* SMOOTHSCALE_FILTER_P)(Uint8 *, Uint8 *, int, int, int, int, int);
 struct _module_state {
@@ -1512,6 +1532,96 @@ surf_set_smoothscale_backend (PyObject *self, PyObject *args, PyObject *kwds)
 #endif /* defined(SCALE_MMX_SUPPORT) */
 }
 
+#if defined(TRANSFORM_SSE2_SUPPORT)
+/* Four pixels at a time version of get_threshold for surfaces accepted by
+ * _bytelane_format.  The per channel tests become one saturating compare
+ * over all byte lanes, giving a mask per pixel which selects the color
+ * written and is summed into the count without leaving the registers.
+ */
+static int
+get_threshold_sse2 (SDL_Surface *destsurf, SDL_Surface *surf,
+                    SDL_Surface *surf2, Uint32 color, Uint32 threshold,
+                    Uint32 diff_color, int change_return, int inverse)
+{
+    Uint32 rgbmask = (surf->format->Rmask | surf->format->Gmask |
+                      surf->format->Bmask);
+    __m128i zero = _mm_setzero_si128 ();
+    __m128i ones = _mm_cmpeq_epi32 (zero, zero);
+    __m128i vcolor = _mm_set1_epi32 ((int) color);
+    __m128i vdiff_color = _mm_set1_epi32 ((int) diff_color);
+    /* lanes that are not compared always pass */
+    __m128i vthreshold = _mm_set1_epi32 ((int) ((threshold & rgbmask) |
+                                                ~rgbmask));
+    __m128i vinverse = inverse ? ones : zero;
+    __m128i counts = zero;
+    __m128i pix, ref, diff, match, out;
+    Uint32 buf[4], buf2[4];
+    Sint32 lanes[4];
+    Uint32 *src, *src2 = NULL, *dst = NULL;
+    int x, y, n;
+
+    for (y = 0; y < surf->h; y++)
+    {
+        src = (Uint32 *) ((Uint8 *) surf->pixels + y * surf->pitch);
+        if (surf2)
+            src2 = (Uint32 *) ((Uint8 *) surf2->pixels + y * surf2->pitch);
+        if (change_return)
+            dst = (Uint32 *) ((Uint8 *) destsurf->pixels +
+                              y * destsurf->pitch);
+
+        for (x = 0; x < surf->w; x += 4)
+        {
+            n = MIN (surf->w - x, 4);
+            if (n == 4)
+            {
+                pix = _mm_loadu_si128 ((__m128i *) (src + x));
+                ref = surf2 ? _mm_loadu_si128 ((__m128i *) (src2 + x)) : vcolor;
+            }
+            else
+            {
+                memset (buf, 0, sizeof (buf));
+                memcpy (buf, src + x, n * 4);
+                pix = _mm_loadu_si128 ((__m128i *) buf);
+                ref = vcolor;
+                if (surf2)
+                {
+                    memset (buf2, 0, sizeof (buf2));
+                    memcpy (buf2, src2 + x, n * 4);
+                    ref = _mm_loadu_si128 ((__m128i *) buf2);
+                }
+            }
+
+            /* |pix - ref| <= threshold in every lane of the pixel */
+            diff = _mm_or_si128 (_mm_subs_epu8 (pix, ref),
+                                 _mm_subs_epu8 (ref, pix));
+            match = _mm_cmpeq_epi8 (_mm_subs_epu8 (diff, vthreshold), zero);
+            match = _mm_xor_si128 (_mm_cmpeq_epi32 (match, ones), vinverse);
+            if (n < 4)
+                match = _mm_and_si128 (match, _mm_set_epi32 (
+                                           0, n > 2 ? -1 : 0, n > 1 ? -1 : 0,
+                                           -1));
+            counts = _mm_sub_epi32 (counts, match);
+
+            if (change_return)
+            {
+                out = _mm_or_si128 (
+                    _mm_and_si128 (match, change_return == 2 ? pix : vcolor),
+                    _mm_andnot_si128 (match, vdiff_color));
+                if (n == 4)
+                    _mm_storeu_si128 ((__m128i *) (dst + x), out);
+                else
+                {
+                    _mm_storeu_si128 ((__m128i *) buf, out);
+                    memcpy (dst + x, buf, n * 4);
+                }
+            }
+        }
+    }
+
+    _mm_storeu_si128 ((__m128i *) lanes, counts);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+#endif /* defined(TRANSFORM_SSE2_SUPPORT) */
 
 static int get_threshold (SDL_Surface *destsurf, SDL_Surface *surf,
                           SDL_Surface *surf2, Uint32 color,  Uint32 threshold,
@@ -1577,6 +1687,18 @@ static int get_threshold (SDL_Surface *destsurf, SDL_Surface *surf,
     SDL_GetRGBA (threshold, format, &tr, &tg, &tb, &ta);
     SDL_GetRGBA (diff_color, format, &dr, &dg, &db, &da);
 
+#if defined(TRANSFORM_SSE2_SUPPORT)
+    if (_bytelane_format (format) &&
+        (!surf2 || (_bytelane_format (format2) &&
+                    rmask2 == rmask && gmask2 == gmask && bmask2 == bmask &&
+                    surf2->w >= surf->w && surf2->h >= surf->h)) &&
+        (!change_return || (destformat->BytesPerPixel == 4 &&
+                            destsurf->w >= surf->w &&
+                            destsurf->h >= surf->h)))
+        return get_threshold_sse2 (destsurf, surf, surf2, color, threshold,
+                                   diff_color, change_return, inverse);
+#endif
+
     for(y=0; y < surf->h; y++) {
         pixels = (Uint8 *) surf->pixels + y*surf->pitch;
         if (surf2) {
@@ -1994,6 +2116,101 @@ number to use for missing samples
 #define LAPLACIAN_NUM 0xFFFFFFFF
 
 
+#if defined(TRANSFORM_SSE2_SUPPORT)
+/* Copies a source row into a line buffer with a LAPLACIAN_NUM border
+ * pixel on the left, padding the right up to the buffer length.  A NULL
+ * row, above or below the surface, is all missing samples.
+ */
+static void
+_laplacian_line (Uint32 *line, const Uint8 *row, int width, int length)
+{
+    int i = 0;
+
+    if (row)
+    {
+        line[0] = LAPLACIAN_NUM;
+        memcpy (line + 1, row, width * 4);
+        i = width + 1;
+    }
+    for (; i < length; i++)
+        line[i] = LAPLACIAN_NUM;
+}
+
+/* Four pixels at a time version of laplacian for surfaces accepted by
+ * _bytelane_format.  Rows are staged into padded line buffers so the
+ * edges need no special cases; the kernel runs on 16 bit lanes and the
+ * final pack saturates to 0-255, which is the clamp.  Returns 0 if the
+ * line buffers cannot be allocated.
+ */
+static int
+laplacian_sse2 (SDL_Surface *surf, SDL_Surface *destsurf)
+{
+    SDL_PixelFormat *format = surf->format;
+    int width = surf->w;
+    int height = surf->h;
+    int length = ((width + 3) & ~3) + 2;
+    __m128i zero = _mm_setzero_si128 ();
+    __m128i keep = _mm_set1_epi32 ((int) (format->Rmask | format->Gmask |
+                                          format->Bmask | format->Amask));
+    __m128i v, lo, hi, sumlo, sumhi;
+    Uint32 *lines, *up, *mid, *down, *tmp, *out;
+    int x, y;
+
+    lines = (Uint32 *) malloc (sizeof (Uint32) * length * 4);
+    if (!lines)
+        return 0;
+    up = lines;
+    mid = up + length;
+    down = mid + length;
+    out = down + length;
+
+    _laplacian_line (mid, NULL, width, length);
+    _laplacian_line (down, (Uint8 *) surf->pixels, width, length);
+
+    for (y = 0; y < height; y++)
+    {
+        tmp = up;
+        up = mid;
+        mid = down;
+        down = tmp;
+        _laplacian_line (down, y + 1 < height ?
+                         (Uint8 *) surf->pixels + (y + 1) * surf->pitch : NULL,
+                         width, length);
+
+        for (x = 0; x < width; x += 4)
+        {
+            sumlo = sumhi = zero;
+#define LAPLACIAN_ADD(line, offset)                                   \
+            v = _mm_loadu_si128 ((__m128i *) ((line) + x + (offset)));  \
+            sumlo = _mm_add_epi16 (sumlo, _mm_unpacklo_epi8 (v, zero)); \
+            sumhi = _mm_add_epi16 (sumhi, _mm_unpackhi_epi8 (v, zero));
+            LAPLACIAN_ADD (up, 0);
+            LAPLACIAN_ADD (up, 1);
+            LAPLACIAN_ADD (up, 2);
+            LAPLACIAN_ADD (mid, 0);
+            LAPLACIAN_ADD (mid, 2);
+            LAPLACIAN_ADD (down, 0);
+            LAPLACIAN_ADD (down, 1);
+            LAPLACIAN_ADD (down, 2);
+#undef LAPLACIAN_ADD
+
+            v = _mm_loadu_si128 ((__m128i *) (mid + x + 1));
+            lo = _mm_slli_epi16 (_mm_unpacklo_epi8 (v, zero), 3);
+            hi = _mm_slli_epi16 (_mm_unpackhi_epi8 (v, zero), 3);
+            v = _mm_packus_epi16 (_mm_sub_epi16 (lo, sumlo),
+                                  _mm_sub_epi16 (hi, sumhi));
+            _mm_storeu_si128 ((__m128i *) (out + x), _mm_and_si128 (v, keep));
+        }
+        memcpy ((Uint8 *) destsurf->pixels + y * destsurf->pitch, out,
+                width * 4);
+    }
+
+    free (lines);
+    return 1;
+}
+#endif /* defined(TRANSFORM_SSE2_SUPPORT) */
+
+
 
 void laplacian(SDL_Surface *surf, SDL_Surface *destsurf) {
 
@@ -2032,6 +2249,11 @@ void laplacian(SDL_Surface *surf, SDL_Surface *destsurf) {
     destpixels = (Uint8 *) destsurf->pixels;
     destformat = destsurf->format;
 
+#if defined(TRANSFORM_SSE2_SUPPORT)
+    if (_bytelane_format (format) && laplacian_sse2 (surf, destsurf))
+        return;
+#endif
+
 /*
     -1 -1 -1
     -1  8 -1
@@ -2053,12 +2275,16 @@ void laplacian(SDL_Surface *surf, SDL_Surface *destsurf) {
             if(y > 0) {
                 if(x>0) {
                     SURF_GET_AT(sample[0], surf, x+ -1, y+ -1, pixels, format, pix);
+                } else {
+                    sample[0] = LAPLACIAN_NUM;
                 }
 
                 SURF_GET_AT(sample[1], surf, x+  0, y+ -1, pixels, format, pix);
 
                 if(x+1<width) {
                     SURF_GET_AT(sample[2], surf, x+  1, y+ -1, pixels, format, pix);
+                } else {
+                    sample[2] = LAPLACIAN_NUM;
                 }
             } else {
                 sample[0] = LAPLACIAN_NUM;
@@ -2086,12 +2312,16 @@ void laplacian(SDL_Surface *surf, SDL_Surface *destsurf) {
 
                 if(x>0) {
                     SURF_GET_AT(sample[6], surf, x+ -1, y+  1, pixels, format, pix);
+                } else {
+                    sample[6] = LAPLACIAN_NUM;
                 }
 
                 SURF_GET_AT(sample[7], surf, x+  0, y+  1, pixels, format, pix);
 
                 if(x+1<width) {
                     SURF_GET_AT(sample[8], surf, x+  1, y+  1, pixels, format, pix);
+                } else {
+                    sample[8] = LAPLACIAN_NUM;
                 }
             } else {
                 sample[6] = LAPLACIAN_NUM;
@@ -2624,6 +2854,44 @@ surf_average_surfaces (PyObject* self, PyObject* arg)
 }
 
 
+#if defined(TRANSFORM_SSE2_SUPPORT)
+/* Sums each byte lane of the 32 bit pixels in the area into sums.  Lanes
+ * are widened to 32 bits and folded into the 64 bit totals every row, so
+ * large surfaces cannot overflow.
+ */
+static void
+_sum_bytelanes_sse2 (SDL_Surface *surf, int x, int y, int width, int height,
+                     Uint64 *sums)
+{
+    __m128i zero = _mm_setzero_si128 ();
+    __m128i acc, v, w;
+    Uint32 lanes[4];
+    Uint8 *pixels;
+    int row, col, i;
+
+    sums[0] = sums[1] = sums[2] = sums[3] = 0;
+    for (row = y; row < y + height; row++)
+    {
+        pixels = (Uint8 *) surf->pixels + row * surf->pitch + x * 4;
+        acc = zero;
+        for (col = 0; col + 4 <= width; col += 4)
+        {
+            v = _mm_loadu_si128 ((__m128i *) (pixels + col * 4));
+            w = _mm_add_epi16 (_mm_unpacklo_epi8 (v, zero),
+                               _mm_unpackhi_epi8 (v, zero));
+            acc = _mm_add_epi32 (acc, _mm_unpacklo_epi16 (w, zero));
+            acc = _mm_add_epi32 (acc, _mm_unpackhi_epi16 (w, zero));
+        }
+        _mm_storeu_si128 ((__m128i *) lanes, acc);
+        for (; col < width; col++)
+            for (i = 0; i < 4; i++)
+                lanes[i] += pixels[col * 4 + i];
+        for (i = 0; i < 4; i++)
+            sums[i] += lanes[i];
+    }
+}
+#endif /* defined(TRANSFORM_SSE2_SUPPORT) */
+
 void average_color(SDL_Surface* surf, int x, int y, int width, int height, Uint8* r, Uint8* g, Uint8* b, Uint8* a) {
     Uint32 color, rmask, gmask, bmask, amask;
     Uint8 *pixels, *pix;
@@ -2664,8 +2932,28 @@ void average_color(SDL_Surface* surf, int x, int y, int width, int height, Uint8
         y = 0;
     }
 
+    if (width <= 0 || height <= 0)
+    {
+        *r = *g = *b = *a = 0;
+        return;
+    }
+
     size = width*height;
 
+#if defined(TRANSFORM_SSE2_SUPPORT)
+    if (_bytelane_format (format))
+    {
+        Uint64 sums[4];
+
+        _sum_bytelanes_sse2 (surf, x, y, width, height, sums);
+        *r = (Uint8) (sums[rshift >> 3] / size);
+        *g = (Uint8) (sums[gshift >> 3] / size);
+        *b = (Uint8) (sums[bshift >> 3] / size);
+        *a = amask ? (Uint8) (sums[ashift >> 3] / size) : 0;
+        return;
+    }
+#endif
+
     switch (format->BytesPerPixel) {
         case 1:
             for (row = y; row < y+height; row++) {
@@ -103,8 +103,13 @@ def createPygameMods():
         ),
         "gfxdraw" : ( 
             "gfxdraw.c", 
+            "aacoverage.c",
             "SDL_gfx/SDL_gfxPrimitives.c" 
         ),   
+        "draw" : (
+            "draw.c",
+            "aacoverage.c"
+        ),
         "fastevent" : (
             "fastevents.c",
             "fastevent.c"
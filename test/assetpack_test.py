@@ -0,0 +1,115 @@
+#################################### IMPORTS ###################################
+
+if __name__ == '__main__':
+    import sys
+    import os
+    pkg_dir = os.path.split(os.path.abspath(__file__))[0]
+    parent_dir, pkg_name = os.path.split(pkg_dir)
+    is_pygame_pkg = (pkg_name == 'tests' and
+                     os.path.split(parent_dir)[1] == 'pygame')
+    if not is_pygame_pkg:
+        sys.path.insert(0, parent_dir)
+else:
+    is_pygame_pkg = __name__.startswith('pygame.tests.')
+
+if is_pygame_pkg:
+    from pygame.tests.test_utils import unittest
+else:
+    from test.test_utils import unittest
+import os
+import shutil
+import tempfile
+import pygame
+from pygame import assetpack
+from pygame.compat import as_bytes, PY_MAJOR_VERSION
+
+################################################################################
+
+class AssetpackModuleTest(unittest.TestCase):
+    def setUp(self):
+        self.tmpdir = tempfile.mkdtemp()
+        self.archive_path = os.path.join(self.tmpdir, 'test.pak')
+
+        self.surf = pygame.Surface((5, 3), pygame.SRCALPHA, 32)
+        for x in range(5):
+            for y in range(3):
+                self.surf.set_at((x, y), (x * 50, y * 100, 30, 255 - x * 40))
+        self.bmp_path = os.path.join(self.tmpdir, 'sprite.bmp')
+        pygame.image.save(self.surf, self.bmp_path)
+
+        self.data = as_bytes('some\0text\nand more')
+        self.txt_path = os.path.join(self.tmpdir, 'note.txt')
+        f = open(self.txt_path, 'wb')
+        f.write(self.data)
+        f.close()
+
+    def tearDown(self):
+        shutil.rmtree(self.tmpdir)
+
+    def test_build_and_read(self):
+        assetpack.build(self.archive_path,
+                        [('dir/note.txt', self.txt_path),
+                         ('sprite.bmp', self.bmp_path)])
+        archive = assetpack.Archive(self.archive_path)
+        try:
+            self.assertEqual(archive.names(), ['dir/note.txt', 'sprite.bmp'])
+            self.assertEqual(len(archive), 2)
+            self.assertTrue('sprite.bmp' in archive)
+            self.assertFalse(archive.is_raw('sprite.bmp'))
+            self.assertEqual(bytes(archive.read('dir/note.txt')), self.data)
+            self.assertRaises(KeyError, archive.read, 'missing')
+
+            surf = archive.load_image('sprite.bmp')
+            expected = pygame.image.load(self.bmp_path)
+            self.assertEqual(surf.get_size(), (5, 3))
+            for x in range(5):
+                self.assertEqual(surf.get_at((x, 1)), expected.get_at((x, 1)))
+            if PY_MAJOR_VERSION >= 3:
+                surf = pygame.image.load(archive.read('sprite.bmp'),
+                                         'sprite.bmp')
+                self.assertEqual(surf.get_at((2, 2)), expected.get_at((2, 2)))
+        finally:
+            archive.close()
+
+    def test_raw_images(self):
+        assetpack.build(self.archive_path, [self.bmp_path, self.txt_path],
+                        raw_images=True)
+        archive = assetpack.Archive(self.archive_path)
+        name = self.bmp_path.replace(os.sep, '/')
+        self.assertTrue(archive.is_raw(name))
+        self.assertFalse(archive.is_raw(self.txt_path.replace(os.sep, '/')))
+
+        expected = pygame.image.load(self.bmp_path)
+        surf = archive.load_image(name)
+        archive.close()
+        self.assertEqual(surf.get_size(), expected.get_size())
+        for x in range(5):
+            for y in range(3):
+                self.assertEqual(surf.get_at((x, y)), expected.get_at((x, y)))
+
+        # Raw Surfaces use a private mapping, so drawing is allowed.
+        surf.fill((1, 2, 3))
+        self.assertEqual(surf.get_at((0, 0))[:3], (1, 2, 3))
+
+    def test_not_an_archive(self):
+        self.assertRaises(ValueError, assetpack.Archive, self.txt_path)
+
+    def test_truncated_contents(self):
+        assetpack.build(self.archive_path,
+                        [('dir/note.txt', self.txt_path),
+                         ('sprite.bmp', self.bmp_path)])
+        f = open(self.archive_path, 'rb')
+        packed = f.read()
+        f.close()
+        # Cut inside the last name, then inside the last entry itself.
+        for cut in (5, 20):
+            f = open(self.archive_path, 'wb')
+            f.write(packed[:-cut])
+            f.close()
+            self.assertRaises(ValueError, assetpack.Archive,
+                              self.archive_path)
+
+################################################################################
+
+if __name__ == '__main__':
+    unittest.main()
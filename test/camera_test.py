@@ -19,11 +19,93 @@ if is_pygame_pkg:
 else:
     from test.test_utils import test_not_implemented, unittest
 import pygame
-from pygame.compat import long_
+from pygame.compat import long_, as_bytes
 import math
+import struct
+try:
+    from pygame import _camera
+except ImportError:
+    _camera = None
 
 #################################### Tests #####################################
 
+def yuv_to_rgb(y, u, v):
+    """the libv4l integer formulas the camera conversions use"""
+    u -= 128
+    v -= 128
+    u1 = ((u << 7) + u) >> 6
+    rg = ((u << 1) + u + (v << 2) + (v << 1)) >> 3
+    v1 = ((v << 1) + v) >> 1
+    return tuple(max(0, min(255, c)) for c in (y + v1, y - rg, y + u1))
+
+def divide(a, b):
+    """integer division truncating towards zero, like C"""
+    q = abs(a) // b
+    return q if a >= 0 else -q
+
 class CameraModuleTest(unittest.TestCase):
-    pass
+    def setUp(self):
+        import pygame.camera
+        pygame.camera.init()
+        self.colorspace = pygame.camera.colorspace
+
+    # Widths of 10 pixels cover both the 8 pixel blocks of the SSE2 kernels
+    # and the scalar tail.
+
+    def test_colorspace_yuyv(self):
+        pairs = [(0, 0, 255, 255), (255, 255, 0, 0), (16, 128, 235, 128),
+                 (81, 90, 145, 240), (200, 30, 60, 220)]
+        data = as_bytes('').join(struct.pack('4B', *p) for p in pairs)
+        dest = pygame.Surface((10, 1), pygame.SRCALPHA, 32)
+        self.assertTrue(self.colorspace(data, 'RGB', dest,
+                                        source='YUYV') is dest)
+        for i, (y1, u, y2, v) in enumerate(pairs):
+            self.assertEqual(dest.get_at((2 * i, 0)),
+                             yuv_to_rgb(y1, u, v) + (255,))
+            self.assertEqual(dest.get_at((2 * i + 1, 0)),
+                             yuv_to_rgb(y2, u, v) + (255,))
+
+        self.assertRaises(ValueError, self.colorspace, data[:-1], 'RGB',
+                          dest, source='YUYV')
+        self.assertRaises(ValueError, self.colorspace, data, 'RGB', None,
+                          source='YUYV')
+        self.assertRaises(ValueError, self.colorspace, data, 'RGB', dest,
+                          source='NV12')
+
+    def test_colorspace_yuv420(self):
+        lum = [(i * 29) % 256 for i in range(20)]
+        us = [0, 60, 128, 200, 255]
+        vs = [255, 10, 128, 90, 0]
+        data = struct.pack('30B', *(lum + us + vs))
+        dest = pygame.Surface((10, 2), 0, 32)
+        self.colorspace(data, 'RGB', dest, source='YUV420')
+        for y in range(2):
+            for x in range(10):
+                expected = yuv_to_rgb(lum[y * 10 + x], us[x // 2], vs[x // 2])
+                self.assertEqual(dest.get_at((x, y))[:3], expected)
+
+    def test_colorspace_hsv(self):
+        colors = [(0, 0, 0), (255, 255, 255), (255, 0, 0), (10, 200, 30),
+                  (40, 50, 240), (255, 0, 128), (128, 128, 127),
+                  (1, 2, 3), (250, 3, 251), (90, 90, 200)]
+        surf = pygame.Surface((10, 1), 0, 32)
+        for x, color in enumerate(colors):
+            surf.set_at((x, 0), color)
+        hsv = self.colorspace(surf, 'HSV')
+        for x, (r, g, b) in enumerate(colors):
+            high, delta = max(r, g, b), max(r, g, b) - min(r, g, b)
+            if not delta:
+                h = s = 0
+            else:
+                s = 255 * delta // high
+                if r == high:
+                    h = divide(43 * (g - b), delta)
+                elif g == high:
+                    h = 85 + divide(43 * (b - r), delta)
+                else:
+                    h = 170 + divide(43 * (r - g), delta)
+            self.assertEqual(hsv.get_at((x, 0))[:3], (h & 255, s, high))
+
+    if _camera is None:
+        del test_colorspace_yuyv, test_colorspace_yuv420, test_colorspace_hsv
 
@@ -72,6 +72,62 @@ class DrawModuleTest(unittest.TestCase):
             color_at_pt = self.surf.get_at(pt)
             self.assert_(color_at_pt != self.color)
 
+    def test_circle__filled_spans(self):
+        # Filled circles are drawn as horizontal spans; every pixel of a
+        # span must be written, whatever the pixel size of the surface.
+        x, y, r = 30, 20, 15
+        for depth in (8, 16, 24, 32):
+            surf = pygame.Surface((64, 48), 0, depth)
+            surf.fill((0, 0, 0))
+            fg = surf.unmap_rgb(surf.map_rgb((255, 255, 255)))
+            bg = surf.unmap_rgb(surf.map_rgb((0, 0, 0)))
+            draw.circle(surf, (255, 255, 255), (x, y), r, 0)
+            for row in (y - 1, y):
+                for col in range(x - r, x + r):
+                    self.assertEqual(surf.get_at((col, row)), fg)
+                self.assertEqual(surf.get_at((x - r - 1, row)), bg)
+                self.assertEqual(surf.get_at((x + r, row)), bg)
+            self.assertEqual(surf.get_at((x, y - r - 1)), bg)
+            self.assertEqual(surf.get_at((x, y + r)), bg)
+
+    def test_aaline__coverage(self):
+        # Integer end points are pixel centers, so the end pixels are half
+        # covered and the ones between fully covered.
+        surf = pygame.Surface((12, 10), 0, 32)
+        surf.fill((0, 0, 0))
+        rect = draw.aaline(surf, (255, 255, 255), (2, 5), (8, 5), 1, 1)
+        self.assertEqual(rect, pygame.Rect(2, 5, 7, 1))
+        for x in range(3, 8):
+            self.assertEqual(surf.get_at((x, 5)), (255, 255, 255, 255))
+        self.assertEqual(surf.get_at((2, 5)), (127, 127, 127, 255))
+        self.assertEqual(surf.get_at((8, 5)), (127, 127, 127, 255))
+        for x in range(12):
+            self.assertEqual(surf.get_at((x, 4)), (0, 0, 0, 255))
+            self.assertEqual(surf.get_at((x, 6)), (0, 0, 0, 255))
+
+    def test_aalines__coverage(self):
+        # The coverage rasterizer also handles depths the fast mode rejects.
+        points = [(10, 10), (20, 10), (20, 20), (10, 20)]
+        for depth in (8, 16, 24, 32):
+            surf = pygame.Surface((32, 32), 0, depth)
+            surf.fill((0, 0, 0))
+            fg = surf.unmap_rgb(surf.map_rgb((255, 255, 255)))
+            bg = surf.unmap_rgb(surf.map_rgb((0, 0, 0)))
+            draw.aalines(surf, (255, 255, 255), True, points, 1, 1)
+            for posn in [(15, 10), (20, 15), (15, 20), (10, 15)]:
+                self.assertEqual(surf.get_at(posn), fg)
+            self.assertEqual(surf.get_at((15, 15)), bg)
+            self.assertEqual(surf.get_at((15, 8)), bg)
+
+    def test_aaline__bad_quality(self):
+        surf = pygame.Surface((12, 10), 0, 32)
+        points = [(2, 2), (8, 2), (8, 8)]
+        for quality in (-1, 2, 100):
+            self.assertRaises(ValueError, draw.aaline,
+                              surf, (255, 255, 255), (2, 5), (8, 5), 1, quality)
+            self.assertRaises(ValueError, draw.aalines,
+                              surf, (255, 255, 255), False, points, 1, quality)
+
     def test_line(self):
 
         # __doc__ (as of 2008-06-25) for pygame.draw.line:
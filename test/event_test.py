@@ -17,7 +17,7 @@ if is_pygame_pkg:
 else:
     from test.test_utils import test_not_implemented, unittest
 import pygame
-from pygame.compat import as_unicode
+from pygame.compat import as_bytes, as_unicode
 
 ################################################################################
 
@@ -156,6 +156,141 @@ class EventModuleTest(unittest.TestCase):
 
         self.assert_ ( len(pygame.event.get()) >= 10 )
 
+    def test_get_into(self):
+        import struct
+
+        pygame.event.clear()
+        for _ in range(5):
+            pygame.event.post(pygame.event.Event(pygame.USEREVENT, a=1))
+        pygame.event.post(pygame.event.Event(pygame.USEREVENT + 1))
+
+        size = pygame.event.RECORD_SIZE
+        self.assertEqual(size, 32)
+        buf = bytearray(size * 4)
+        self.assertEqual(pygame.event.get_into(buf, pygame.USEREVENT), 4)
+        for i in range(4):
+            fields = struct.unpack_from('iI6i', buf, i * size)
+            self.assertEqual(fields[0], pygame.USEREVENT)
+            self.assertEqual(fields[2:], (0,) * 6)
+
+        # The rest stay on the queue.
+        self.assertEqual(pygame.event.get_into(buf), 2)
+        self.assertEqual(struct.unpack_from('i', buf, size)[0],
+                         pygame.USEREVENT + 1)
+        self.assertEqual(pygame.event.get_into(buf), 0)
+
+        self.assertRaises(TypeError, pygame.event.get_into, buf, 'x')
+
+    def test_lazy_dict(self):
+        import struct
+        import sys
+
+        # Replayed events come from the SDL queue, like input does.
+        pygame.event.start_replay(
+            struct.pack('<4sI', as_bytes('PGER'), 1) +
+            struct.pack('<iI6i', pygame.KEYDOWN, 0, pygame.K_a, 0, 30, 97,
+                        0, 0) +
+            struct.pack('<iI6i', pygame.NOEVENT, 0, 0, 0, 0, 0, 0, 0),
+            speed=0)
+        event = pygame.event.get()[0]
+        size = sys.getsizeof(event)
+        self.assertEqual(event.type, pygame.KEYDOWN)
+        self.assertEqual(sys.getsizeof(event), size)
+        self.assertEqual(event.key, pygame.K_a)
+        self.assertTrue(sys.getsizeof(event) > size)
+
+    def test_c_api_get_dict(self):
+        import ctypes
+        import struct
+
+        capsule = pygame.event._PYGAME_C_API
+        if type(capsule).__name__ != 'PyCapsule':
+            return
+        GetPointer = ctypes.pythonapi.PyCapsule_GetPointer
+        GetPointer.restype = ctypes.c_void_p
+        GetPointer.argtypes = [ctypes.py_object, ctypes.c_char_p]
+        slots = ctypes.cast(GetPointer(capsule,
+                                       as_bytes('pygame.event._PYGAME_C_API')),
+                            ctypes.POINTER(ctypes.c_void_p))
+        GetDict = ctypes.PYFUNCTYPE(ctypes.py_object,
+                                    ctypes.py_object)(slots[4])
+
+        pygame.event.start_replay(
+            struct.pack('<4sI', as_bytes('PGER'), 1) +
+            struct.pack('<iI6i', pygame.KEYDOWN, 0, pygame.K_a, 0, 30, 97,
+                        0, 0) +
+            struct.pack('<iI6i', pygame.NOEVENT, 0, 0, 0, 0, 0, 0, 0),
+            speed=0)
+        event = pygame.event.get()[0]
+        d = GetDict(event)
+        self.assertEqual(d['key'], pygame.K_a)
+        self.assertTrue(d is event.__dict__)
+        self.assertRaises(TypeError, GetDict, 1)
+
+    def test_record_and_replay(self):
+        import struct
+
+        def record(type, *data):
+            data = data + (0,) * (6 - len(data))
+            return struct.pack('<iI6i', type, 1000, *data)
+
+        recording = (struct.pack('<4sI', as_bytes('PGER'), 1) +
+                     record(pygame.KEYDOWN, pygame.K_a, 0, 30, 97) +
+                     record(pygame.NOEVENT) +
+                     record(pygame.MOUSEBUTTONDOWN, 10, 20, 1) +
+                     record(pygame.NOEVENT))
+
+        pygame.event.start_replay(recording, speed=0)
+        self.assertTrue(pygame.event.is_replaying())
+        pygame.event.start_recording()
+        events = pygame.event.get()
+        self.assertEqual([e.type for e in events], [pygame.KEYDOWN])
+        self.assertEqual(events[0].key, pygame.K_a)
+        self.assertEqual(events[0].unicode, as_unicode('a'))
+        events = pygame.event.get()
+        self.assertEqual([e.type for e in events], [pygame.MOUSEBUTTONDOWN])
+        self.assertEqual(events[0].pos, (10, 20))
+        self.assertEqual(events[0].button, 1)
+        self.assertFalse(pygame.event.is_replaying())
+
+        # Posted events are left out; the program posts them again.
+        pygame.event.post(pygame.event.Event(pygame.USEREVENT))
+        pygame.event.get()
+        data = pygame.event.stop_recording()
+        self.assertEqual(len(data), len(recording) + 32)
+        self.assertEqual(data[:8], recording[:8])
+        for start in range(8, len(recording), 32):
+            self.assertEqual(data[start:start + 4],
+                             recording[start:start + 4])
+            self.assertEqual(data[start + 8:start + 32],
+                             recording[start + 8:start + 32])
+
+        self.assertRaises(pygame.error, pygame.event.stop_recording)
+        self.assertRaises(ValueError, pygame.event.start_replay,
+                          as_bytes('nonsense'))
+
+    def test_replay_onto_full_queue(self):
+        import struct
+
+        # One recorded read call with more events than fit beside those
+        # already queued; the rest is fed by the following calls.
+        count = 127
+        key = struct.pack('<iI6i', pygame.KEYDOWN, 0, pygame.K_a, 0, 30, 97,
+                          0, 0)
+        pygame.event.start_replay(
+            struct.pack('<4sI', as_bytes('PGER'), 1) + key * count +
+            struct.pack('<iI6i', pygame.NOEVENT, 0, 0, 0, 0, 0, 0, 0),
+            speed=0)
+        for i in range(10):
+            pygame.event.post(pygame.event.Event(pygame.USEREVENT))
+
+        types = []
+        for i in range(5):
+            types.extend(e.type for e in pygame.event.get())
+        self.assertFalse(pygame.event.is_replaying())
+        self.assertEqual(types.count(pygame.USEREVENT), 10)
+        self.assertEqual(types.count(pygame.KEYDOWN), count)
+
     def test_clear(self):
 
         # __doc__ (as of 2008-06-25) for pygame.event.clear:
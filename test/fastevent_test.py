@@ -84,17 +84,19 @@ class FasteventModuleTest(unittest.TestCase):
           # the standard MOUSEBUTTONDOWN attributes to be available, like
           # 'pos' and 'button'.
           # 
-          # Because pygame.fastevent.post() may have to wait for the queue
-          # to empty, you can get into a dead lock if you try to append an
-          # event on to a full queue from the thread that processes events.
-          # For that reason I do not recommend using this function in the
-          # main thread of an SDL program.
+          # Posting takes no lock while the posting queue has room. When it
+          # is full, pygame.fastevent.post() may have to wait for the SDL
+          # queue to empty, so you can get into a dead lock if you post to
+          # full queues from the thread that processes events. For that
+          # reason I do not recommend using this function in the main
+          # thread of an SDL program.
     
         for _ in range(1, 11):
             fastevent.post(event.Event(pygame.USEREVENT))
         
+        # Posted events wait in the fastevent queue, not the SDL one.
         self.assertEquals (
-            [e.type for e in event.get()], [pygame.USEREVENT] * 10,
+            [e.type for e in fastevent.get()], [pygame.USEREVENT] * 10,
             race_condition_notification
         )
 
@@ -109,6 +111,41 @@ class FasteventModuleTest(unittest.TestCase):
         else:
             self.fail()
     
+    def test_post_from_threads(self):
+        import threading
+
+        def poster(code):
+            for i in range(500):
+                fastevent.post(event.Event(pygame.USEREVENT, code=code, i=i))
+
+        threads = [threading.Thread(target=poster, args=(n,))
+                   for n in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+
+        got = dict((n, []) for n in range(4))
+        for e in fastevent.get():
+            got[e.code].append(e.i)
+        for n in range(4):
+            self.assertEqual(got[n], list(range(500)))
+
+    def test_get_queue_stats(self):
+        capacity, queued, peak, overflows = fastevent.get_queue_stats()
+        self.assertTrue(capacity >= 4096)
+        self.assertEqual(capacity & (capacity - 1), 0)
+
+        for _ in range(10):
+            fastevent.post(event.Event(pygame.USEREVENT))
+        self.assertEqual(fastevent.get_queue_stats()[1], 10)
+        self.assertEqual(len(fastevent.get()), 10)
+        capacity, queued, peak, overflows = fastevent.get_queue_stats()
+        self.assertEqual(queued, 0)
+        self.assertTrue(peak >= 10)
+
+        self.assertRaises(ValueError, fastevent.init, -1)
+
     def todo_test_pump(self):
     
         # __doc__ (as of 2008-08-02) for pygame.fastevent.pump:
@@ -443,6 +443,57 @@ class FontTypeTest( unittest.TestCase ):
         else:
             self.assert_(size != bsize)
 
+    def test_render_to(self):
+        f = pygame_font.Font(None, 20)
+        text = as_unicode("Xg")
+        s = f.render(text, True, (255, 255, 255), (0, 0, 0))
+        surf = pygame.Surface((40, 40), 0, 32)
+        surf.fill((0, 0, 255))
+        r = f.render_to(surf, (5, 7), text, True, (255, 255, 255), (0, 0, 0))
+        self.assertEqual(r, pygame.Rect((5, 7), s.get_size()))
+        for x in range(s.get_width()):
+            for y in range(s.get_height()):
+                self.assertEqual(surf.get_at((x + 5, y + 7)),
+                                 s.get_at((x, y)))
+        self.assertEqual(surf.get_at((4, 7)), (0, 0, 255, 255))
+
+    def test_render_cache(self):
+        f = pygame_font.Font(None, 20)
+        self.assertEqual(f.get_cache_budget(), 0)
+        s = f.render(as_unicode("abc"), True, (255, 255, 255))
+        self.assertFalse(s is f.render(as_unicode("abc"), True,
+                                       (255, 255, 255)))
+        self.assertEqual(f.get_cache_stats(), (0, 0, 0, 0))
+
+        f.set_cache_budget(1 << 20)
+        self.assertEqual(f.get_cache_budget(), 1 << 20)
+        s = f.render(as_unicode("abc"), True, (255, 255, 255))
+        self.assertTrue(s is f.render(as_unicode("abc"), True,
+                                      (255, 255, 255)))
+        self.assertFalse(s is f.render(as_unicode("abc"), True, (255, 0, 0)))
+        f.set_underline(True)
+        self.assertFalse(s is f.render(as_unicode("abc"), True,
+                                       (255, 255, 255)))
+        hits, misses, evictions, nbytes = f.get_cache_stats()
+        self.assertEqual((hits, misses, evictions), (1, 3, 0))
+        self.assertTrue(nbytes >= 3 * s.get_pitch() * s.get_height())
+
+        f.set_cache_budget(nbytes - 1)
+        self.assertEqual(f.get_cache_stats()[2], 1)
+        f.set_cache_budget(0)
+        self.assertEqual(f.get_cache_stats()[2:], (3, 0))
+
+        # Entries are dropped least recently used first.
+        f.set_cache_budget(1 << 20)
+        a = f.render(as_unicode("a"), True, pygame.Color(0, 0, 0))
+        b = f.render(as_unicode("b"), True, (0, 0, 0))
+        self.assertTrue(a is f.render(as_unicode("a"), True, [0, 0, 0]))
+        f.set_cache_budget(f.get_cache_stats()[3] - 1)
+        self.assertTrue(a is f.render(as_unicode("a"), True, (0, 0, 0)))
+        self.assertFalse(b is f.render(as_unicode("b"), True, (0, 0, 0)))
+        # Colors that make no key are rendered, or rejected, uncached.
+        self.assertRaises(TypeError, f.render, as_unicode("a"), True, 1)
+
     def test_font_file_not_found(self):
         # A per BUG reported by Bo Jangeborg on pygame-user mailing list,
         # http://www.mail-archive.com/pygame-users@seul.org/msg11675.html
@@ -744,6 +744,144 @@ class FreeTypeFontTest(unittest.TestCase):
         finally:
             font.antialiased = save_antialiased
 
+    def test_freetype_Font_render_cache(self):
+        font = self._TEST_FONTS['sans']
+        color = pygame.Color('black')
+        self.assertFalse(font.render_cache)
+        s1, r1 = font.render('Cached', color, size=24)
+        s2, r2 = font.render('Cached', color, size=24)
+        self.assertFalse(s1 is s2)
+
+        font.render_cache = True
+        try:
+            s1, r1 = font.render('Cached', color, size=24)
+            s2, r2 = font.render('Cached', color, size=24)
+            self.assertTrue(s1 is s2)
+            self.assertFalse(r1 is r2)
+            self.assertEqual(r1, r2)
+            r1.move_ip(10, 10)
+            s3, r3 = font.render('Cached', color, size=24)
+            self.assertEqual(r3, r2)
+            s4, r4 = font.render('Cached', color, size=26)
+            self.assertFalse(s4 is s1)
+            s5, r5 = font.render('Cached', pygame.Color('red'), size=24)
+            self.assertFalse(s5 is s1)
+            s6, r6 = font.render('Cached', color, color, size=24)
+            self.assertFalse(s6 is s1)
+            self.assertRaises(TypeError, setattr, font, 'render_cache', 1)
+        finally:
+            font.render_cache = False
+        s7, r7 = font.render('Cached', color, size=24)
+        self.assertFalse(s7 is s1)
+
+    def test_freetype_Font_layout_reuse(self):
+        # Alternating strings are served from the layout cache and must
+        # measure and render exactly as when first laid out.
+        font = self._TEST_FONTS['sans']
+        texts = ['Layout %d' % i for i in range(12)]
+        rects = [font.get_rect(t, size=24) for t in texts]
+        for i in range(3):
+            for t, r in zip(texts, rects):
+                self.assertEqual(font.get_rect(t, size=24), r)
+        surf, r = font.render(texts[0], pygame.Color('black'), size=24)
+        for t in texts[:3]:
+            font.get_rect(t, size=24)
+        surf2, r2 = font.render(texts[0], pygame.Color('black'), size=24)
+        self.assertEqual(r2, r)
+        self.assertTrue(surf_same_image(surf2, surf))
+        strong = font.get_rect(texts[0], size=24, style=ft.STYLE_STRONG)
+        self.assertNotEqual(strong, rects[0])
+
+    def test_freetype_Font_render_to__depths_agree(self):
+        # 32 bit targets may be composited by a separate SIMD path, which
+        # must blend exactly as the 24 bit one does.
+        font = self._TEST_FONTS['sans']
+        text = "Agree, jumpy quiz"
+        size = font.get_rect(text, size=24, style=ft.STYLE_UNDERLINE).size
+        size = (size[0] + 9, size[1] + 6)
+        surf32 = pygame.Surface(size, 0, 32)
+        surf24 = pygame.Surface(size, 0, 24)
+        for x in range(size[0]):
+            for y in range(size[1]):
+                color = ((x * 37) & 255, (y * 91) & 255, ((x + y) * 13) & 255)
+                surf32.set_at((x, y), color)
+                surf24.set_at((x, y), color)
+        for fgcolor in [(250, 10, 120, 255), (5, 200, 255, 97)]:
+            for surf in (surf32, surf24):
+                font.render_to(surf, (3, 2), text, fgcolor, size=24,
+                               style=ft.STYLE_UNDERLINE)
+        for x in range(size[0]):
+            for y in range(size[1]):
+                self.assertEqual(surf32.get_at((x, y)),
+                                 surf24.get_at((x, y)))
+
+    def test_freetype_Font_render__threads(self):
+        # Renders from several threads, sharing one font, must match
+        # what a single thread produces.
+        import threading
+        font = self._TEST_FONTS['sans']
+        texts = ["Thread %i renders" % i for i in range(4)]
+        expected = [pygame.image.tostring(font.render(t, size=20)[0], 'RGBA')
+                    for t in texts]
+        failures = []
+
+        def worker(i):
+            for n in range(20):
+                surf = font.render(texts[i], size=20)[0]
+                if pygame.image.tostring(surf, 'RGBA') != expected[i]:
+                    failures.append(i)
+                font.render_raw(texts[i], size=20)
+
+        threads = [threading.Thread(target=worker, args=(i,))
+                   for i in range(len(texts))]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.assertEqual(failures, [])
+
+    def test_freetype_Font_render__threads_layout(self):
+        # Threads lay out text and load glyphs without the GIL, each with
+        # fonts of its own, one of them read from a file object. Sizes
+        # change on every call so the glyphs are always loaded afresh.
+        import threading
+        from pygame.compat import get_BytesIO
+        f = open(self._sans_path, 'rb')
+        sans_data = f.read()
+        f.close()
+        paths = [self._sans_path, self._mono_path, self._fixed_path, None]
+        sizes = [12, 17, 23, 30]
+        text = "Layout in threads"
+
+        def make_font(path):
+            if path is None:
+                return ft.Font(get_BytesIO()(sans_data))
+            return ft.Font(path)
+
+        def draw(font, size):
+            surf = font.render(text, size=size)[0]
+            return (pygame.image.tostring(surf, 'RGBA'),
+                    font.get_metrics(text, size=size))
+
+        fonts = [make_font(p) for p in paths]
+        expected = [[draw(font, size) for size in sizes] for font in fonts]
+        fonts = [make_font(p) for p in paths]
+        failures = []
+
+        def worker(i):
+            for n in range(5):
+                for j, size in enumerate(sizes):
+                    if draw(fonts[i], size) != expected[i][j]:
+                        failures.append((i, size))
+
+        threads = [threading.Thread(target=worker, args=(i,))
+                   for i in range(len(fonts))]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.assertEqual(failures, [])
+
     def test_freetype_Font_render_to_mono(self):
         # Blitting is done in two stages. First the target is alpha filled
         # with the background color, if any. Second, the foreground
@@ -1223,8 +1361,12 @@ class FreeTypeFontTest(unittest.TestCase):
         count += 2 * mglen
         access += 2 * mglen
         miss += 2 * mglen
-        f.get_metrics(many_glyphs, size=8)
-        f.get_metrics(many_glyphs, size=10)
+        ft.set_cache_budget(0)
+        try:
+            f.get_metrics(many_glyphs, size=8)
+            f.get_metrics(many_glyphs, size=10)
+        finally:
+            ft.set_cache_budget()
         ccount, cdelete_count, caccess, chit, cmiss = f._debug_cache_stats
         self.assertTrue(ccount < count)
         self.assertEqual((ccount + cdelete_count, caccess, chit, cmiss),
@@ -1443,5 +1585,61 @@ class FreeTypeTest(unittest.TestCase):
         self.assertEqual(ft.get_cache_size(), new_cache_size)
         ft.quit()
 
+    def test_cache_stats(self):
+        ft.init()
+        try:
+            f = ft.Font(None, size=24)
+            hits, misses, evictions, nbytes = ft.get_cache_stats()
+            f.render_raw('abc')
+            stats = ft.get_cache_stats()
+            self.assertEqual(stats[:3], (hits, misses + 3, evictions))
+            self.assertTrue(stats[3] > nbytes)
+            f.render_raw('cab')
+            self.assertEqual(ft.get_cache_stats()[:3],
+                             (hits + 3, misses + 3, evictions))
+        finally:
+            ft.quit()
+
+    def test_preload(self):
+        ft.init()
+        try:
+            f = ft.Font(None, size=24)
+            count, nbytes = f.preload('abc', [16, 24],
+                                      [ft.STYLE_NORMAL, ft.STYLE_OBLIQUE])
+            self.assertEqual(count, 12)
+            self.assertTrue(nbytes > 0)
+            self.assertEqual(f.preload('cab', 16, ft.STYLE_OBLIQUE),
+                             (0, nbytes))
+            hits, misses, evictions, nbytes = ft.get_cache_stats()
+            f.render_raw('bca', style=ft.STYLE_OBLIQUE)
+            self.assertEqual(ft.get_cache_stats()[:2], (hits + 3, misses))
+            self.assertRaises(ValueError, f.preload, 'a', styles=0xFFF)
+        finally:
+            ft.quit()
+
+    def test_cache_budget(self):
+        DEFAULT_CACHE_BUDGET = 2 * 1024 * 1024
+        ft.quit()
+        self.assertRaises(RuntimeError, ft.set_cache_budget, 0)
+        ft.init()
+        try:
+            self.assertEqual(ft.get_cache_budget(), DEFAULT_CACHE_BUDGET)
+            self.assertRaises(ValueError, ft.set_cache_budget, -1)
+            f = ft.Font(None, size=24)
+            f.render_raw('abc')
+            # Over budget glyphs are dropped before the next layout, but
+            # those of the text being drawn are kept.
+            ft.set_cache_budget(0)
+            self.assertEqual(ft.get_cache_budget(), 0)
+            evictions = ft.get_cache_stats()[2]
+            f.render_raw('d')
+            hits, misses, new_evictions, nbytes = ft.get_cache_stats()
+            self.assertEqual(new_evictions, evictions + 3)
+            self.assertTrue(nbytes > 0)
+            ft.set_cache_budget()
+            self.assertEqual(ft.get_cache_budget(), DEFAULT_CACHE_BUDGET)
+        finally:
+            ft.quit()
+
 if __name__ == '__main__':
     unittest.main()
@@ -328,6 +328,37 @@ class GfxdrawDefaultTest( unittest.TestCase ):
             for posn in bg_test_points:
                 self.check_at(surf, posn, bg_adjusted)
 
+    def test_aacircle__coverage(self):
+        """aacircle(surface, x, y, r, color, quality=1): return None"""
+        x, y, r = 50, 50, 20
+        fg = (255, 0, 0, 255)
+        surf = pygame.Surface((100, 100), 0, 32)
+        surf.fill((0, 0, 0))
+        pygame.gfxdraw.aacircle(surf, x, y, r, fg, 1)
+        # The one pixel wide ring nearly covers the pixels it passes
+        # through on the axes and leaves its neighbours untouched.
+        for posn in [(x + r, y), (x - r, y), (x, y + r), (x, y - r)]:
+            color = surf.get_at(posn)
+            self.failUnless(color[0] >= 240 and tuple(color)[1:] == (0, 0, 255),
+                            "%s != %s at %s" % (color, fg, posn))
+        for posn in [(x, y), (x + r + 2, y), (x + r - 2, y)]:
+            self.check_at(surf, posn, (0, 0, 0, 255))
+
+    def test_aa__bad_quality(self):
+        """quality other than 0 or 1 raises ValueError"""
+        fg = (255, 0, 0, 255)
+        surf = pygame.Surface((100, 100), 0, 32)
+        points = [(10, 10), (90, 10), (50, 90)]
+        for quality in (-1, 2, 100):
+            self.assertRaises(ValueError, pygame.gfxdraw.aacircle,
+                              surf, 50, 50, 20, fg, quality)
+            self.assertRaises(ValueError, pygame.gfxdraw.aaellipse,
+                              surf, 50, 50, 20, 10, fg, quality)
+            self.assertRaises(ValueError, pygame.gfxdraw.aatrigon,
+                              surf, 10, 10, 90, 10, 50, 90, fg, quality)
+            self.assertRaises(ValueError, pygame.gfxdraw.aapolygon,
+                              surf, points, fg, quality)
+
     def test_filled_circle(self):
         """filled_circle(surface, x, y, r, color): return None"""
         fg = self.foreground_color
@@ -357,6 +388,20 @@ class GfxdrawDefaultTest( unittest.TestCase ):
             for posn in bg_test_points:
                 self.check_at(surf, posn, bg_adjusted)
 
+    def test_filled_circle__blended_spans(self):
+        """filled_circle blends translucent spans evenly along each row"""
+        surf = pygame.Surface(self.default_size, 0, 32)
+        surf.fill((255, 255, 255))
+        x = 50
+        y = 50
+        r = 40
+        pygame.gfxdraw.filled_circle(surf, x, y, r, (255, 0, 0, 128))
+        expected = (255, 127, 127, 255)
+        for posn in [(col, y) for col in range(x - r, x + r + 1)]:
+            self.check_at(surf, posn, expected)
+        self.check_at(surf, (x - r - 1, y), (255, 255, 255, 255))
+        self.check_at(surf, (x + r + 1, y), (255, 255, 255, 255))
+
     def test_ellipse(self):
         """ellipse(surface, x, y, rx, ry, color): return None"""
         fg = self.foreground_color
@@ -647,6 +692,28 @@ class GfxdrawDefaultTest( unittest.TestCase ):
             for posn in bg_test_points:
                 self.check_at(surf, posn, bg_adjusted)
 
+    def test_filled_polygon__threads(self):
+        """filled_polygon is reentrant across threads on separate surfaces"""
+        import threading
+        fg = (255, 0, 0, 255)
+        surfs = [pygame.Surface((100, 100), 0, 32) for i in range(4)]
+        def worker(surf, n):
+            # Polygons with differing vertex counts grow the scan line
+            # scratch differently in each thread.
+            for i in range(50):
+                points = [(10, 10), (90, 10)] + \
+                         [(90 - k, 90) for k in range(0, 80, 80 // n)]
+                pygame.gfxdraw.filled_polygon(surf, points, fg)
+        threads = [threading.Thread(target=worker, args=(s, 2 + 3 * i))
+                   for i, s in enumerate(surfs)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        for surf in surfs:
+            self.assertEqual(surf.get_at((50, 50)), fg)
+            self.assertEqual(surf.get_at((5, 5)), (0, 0, 0, 255))
+
     def test_textured_polygon(self):
         """textured_polygon(surface, points, texture, tx, ty): return None"""
         w, h = self.default_size
@@ -687,6 +754,69 @@ class GfxdrawDefaultTest( unittest.TestCase ):
                               points,
                               texture, 0, 0)
 
+    def test_textured_quads(self):
+        """textured_quads(surface, points, texcoords, texture, bilinear=False): return None"""
+        texture = pygame.Surface((4, 4), 0, 32)
+        for x in range(4):
+            for y in range(4):
+                texture.set_at((x, y), (x * 60, y * 60, 7))
+        points = [(0, 0), (8, 0), (8, 8), (0, 8)]
+        texcoords = [(0, 0), (4, 0), (4, 4), (0, 4)]
+        for surf in [pygame.Surface((10, 10), 0, 32),
+                     pygame.Surface((10, 10), 0, 24)]:
+            surf.fill((0, 0, 0))
+            pygame.gfxdraw.textured_quads(surf, points, texcoords, texture)
+            for x in range(8):
+                for y in range(8):
+                    self.check_at(surf, (x, y), texture.get_at((x // 2, y // 2)))
+            self.check_at(surf, (8, 8), (0, 0, 0, 255))
+        self.failUnlessRaises(ValueError, pygame.gfxdraw.textured_quads,
+                              surf, points[:3], texcoords[:3], texture)
+        self.failUnlessRaises(ValueError, pygame.gfxdraw.textured_quads,
+                              surf, points, texcoords[:2], texture)
+
+    def test_textured_quads__far_texcoords(self):
+        """texture coordinates far from the origin wrap without overflowing"""
+        texture = pygame.Surface((4, 4), 0, 32)
+        for x in range(4):
+            for y in range(4):
+                texture.set_at((x, y), (x * 60, y * 60, 7))
+        points = [(0, 0), (8, 0), (8, 8), (0, 8)]
+        for offset in (32000, -32000):
+            texcoords = [(offset + u, offset + v)
+                         for u, v in [(0, 0), (4, 0), (4, 4), (0, 4)]]
+            surf = pygame.Surface((10, 10), 0, 32)
+            surf.fill((0, 0, 0))
+            pygame.gfxdraw.textured_quads(surf, points, texcoords, texture)
+            for x in range(8):
+                for y in range(8):
+                    self.check_at(surf, (x, y), texture.get_at((x // 2, y // 2)))
+        # A steep gradient across a narrow quad steps far past one period.
+        texcoords = [(-32766, 0), (32766, 0), (32766, 4), (-32766, 4)]
+        pygame.gfxdraw.textured_quads(surf, [(0, 0), (2, 0), (2, 8), (0, 8)],
+                                      texcoords, texture, True)
+        for bad in (32767, -32767, float('nan')):
+            self.failUnlessRaises(ValueError, pygame.gfxdraw.textured_quads,
+                                  surf, points, [(bad, 0)] + texcoords[1:],
+                                  texture)
+
+    def test_textured_triangles(self):
+        """textured_triangles(surface, points, texcoords, texture, bilinear=False): return None"""
+        texture = pygame.Surface((2, 2), SRCALPHA, 32)
+        texture.fill((255, 0, 0, 128))
+        # Two triangles sharing a diagonal must blend every pixel once.
+        points = [(0, 0), (6, 0), (6, 6), (0, 0), (6, 6), (0, 6)]
+        texcoords = [(0, 0), (2, 0), (2, 2), (0, 0), (2, 2), (0, 2)]
+        for bilinear in (False, True):
+            surf = pygame.Surface((8, 8), SRCALPHA, 32)
+            surf.fill((255, 255, 255, 255))
+            pygame.gfxdraw.textured_triangles(surf, points, texcoords,
+                                              texture, bilinear)
+            for x in range(6):
+                for y in range(6):
+                    self.check_at(surf, (x, y), (255, 127, 127, 255))
+            self.check_at(surf, (6, 6), (255, 255, 255, 255))
+
     def test_bezier(self):
         """bezier(surface, points, steps, color): return None"""
         fg = self.foreground_color
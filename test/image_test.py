@@ -114,6 +114,30 @@ class ImageModuleTest( unittest.TestCase ):
         
         # surf = pygame.image.load(open(os.path.join("examples", "data", "alien1.jpg"), "rb"))
 
+    def test_load_async(self):
+        if not pygame.image.get_extended():
+            return
+        f = example_path('data/alien1.png')
+        pending = [pygame.image.load_async(f) for i in range(4)]
+        expected = pygame.image.load(f)
+        for p in pending:
+            surf = p.result()
+            self.assertTrue(p.done())
+            self.assertTrue(p.result() is surf)
+            self.assertEqual(surf.get_size(), expected.get_size())
+            self.assertEqual(surf.get_at((20, 20)), expected.get_at((20, 20)))
+
+        bad = pygame.image.load_async(example_path('data/no_such_file.png'))
+        self.assertRaises(pygame.error, bad.result)
+        fileobj = open(f, 'rb')
+        try:
+            self.assertRaises(TypeError, pygame.image.load_async, fileobj)
+        finally:
+            fileobj.close()
+        self.assertRaises(ValueError, pygame.image.set_async_threads, 0)
+        pygame.image.set_async_threads(4)
+        pygame.image.set_async_threads(2)
+
     def testSaveJPG(self):
         """ JPG equivalent to issue #211 - color channel swapping
 
@@ -196,6 +220,32 @@ class ImageModuleTest( unittest.TestCase ):
 
         os.remove(f_path)
 
+    def test_save_png__options(self):
+        if not pygame.image.get_extended():
+            return
+        surf = pygame.Surface((64, 48), pygame.SRCALPHA, 32)
+        surf.fill((10, 20, 30, 255))
+        surf.fill((200, 100, 50, 128), (8, 8, 20, 20))
+
+        f_path = tempfile.mktemp(suffix='.png')
+        try:
+            for kwds in [{}, {'fast': True}, {'level': 0, 'filter': 'none'},
+                         {'level': 9, 'filter': 'paeth'},
+                         {'fast': True, 'filter': 'adaptive'}]:
+                pygame.image.save_png(surf, f_path, **kwds)
+                loaded = pygame.image.load(f_path)
+                for posn in [(0, 0), (10, 10), (63, 47)]:
+                    self.assertEqual(loaded.get_at(posn), surf.get_at(posn),
+                                     repr(kwds))
+        finally:
+            if os.path.exists(f_path):
+                os.remove(f_path)
+
+        self.assertRaises(ValueError, pygame.image.save_png,
+                          surf, f_path, level=10)
+        self.assertRaises(ValueError, pygame.image.save_png,
+                          surf, f_path, filter='best')
+
     def testSavePNG24(self):
         """ see if we can save a png with color values in the proper channels.
         """
@@ -331,6 +381,55 @@ class ImageModuleTest( unittest.TestCase ):
         self.assertRaises(ValueError, pygame.image.tostring, no_alpha_surface, "RGBA_PREMULT")
         
 
+    def test_tostring__channel_orders(self):
+        # The copy, swizzle and generic paths must agree with get_at.
+        masks = [(0xff0000, 0xff00, 0xff, 0xff000000),
+                 (0xff, 0xff00, 0xff0000, 0xff000000),
+                 (0xff00, 0xff0000, 0xff000000, 0xff),
+                 (0xff0000, 0xff00, 0xff, 0)]
+        size = (7, 3)
+        for m in masks:
+            flags = m[3] and pygame.SRCALPHA or 0
+            surf = pygame.Surface(size, flags, 32, m)
+            for x in range(size[0]):
+                for y in range(size[1]):
+                    surf.set_at((x, y), (x * 30, y * 70, 200 - x, 40 + x * y))
+            for fmt in ['RGB', 'RGBX', 'RGBA', 'ARGB']:
+                for flipped in [False, True]:
+                    rows = range(size[1])
+                    if flipped:
+                        rows = reversed(rows)
+                    expected = []
+                    for y in rows:
+                        for x in range(size[0]):
+                            r, g, b, a = surf.get_at((x, y))
+                            if fmt == 'RGB':
+                                expected.extend([r, g, b])
+                            elif fmt == 'ARGB':
+                                expected.extend([a, r, g, b])
+                            else:
+                                expected.extend([r, g, b, a])
+                    self.assertEqual(
+                        pygame.image.tostring(surf, fmt, flipped),
+                        bytes(bytearray(expected)), "%s %s" % (m, fmt))
+
+    def test_tobuffer(self):
+        data = bytes(bytearray(range(64)))
+        for fmt in ['RGBA', 'ARGB', 'RGBX']:
+            surf = pygame.image.frombuffer(data, (4, 4), fmt)
+            buf = pygame.image.tobuffer(surf, fmt)
+            self.assertEqual(buf.raw, data)
+            del buf
+            if fmt != 'RGBX':
+                self.assertEqual(pygame.image.tostring(surf, fmt), data)
+
+        surf = pygame.image.frombuffer(data, (4, 4), 'RGBA')
+        self.assertRaises(ValueError, pygame.image.tobuffer, surf, 'ARGB')
+        self.assertRaises(ValueError, pygame.image.tobuffer, surf, 'RGB')
+        self.assertRaises(ValueError, pygame.image.tobuffer, surf, 'XYZ')
+        surf = pygame.Surface((4, 4), 0, 24)
+        self.assertRaises(ValueError, pygame.image.tobuffer, surf, 'RGBA')
+
     def test_fromstring__and_tostring(self):
         """ see if fromstring, and tostring methods are symmetric.
         """
@@ -17,7 +17,7 @@ else:
     from test.test_utils \
          import test_not_implemented, unittest, example_path
 import pygame
-from pygame.compat import as_unicode, filesystem_encode
+from pygame.compat import as_unicode, as_bytes, filesystem_encode
 
 import os
 
@@ -52,22 +52,83 @@ class MixerMusicModuleTest(unittest.TestCase):
             #pygame.mixer.music.load(musf)
         pygame.mixer.quit()
 
-    def todo_test_queue(self):
-
-        # __doc__ (as of 2008-08-02) for pygame.mixer_music.queue:
-
-          # This will load a music file and queue it. A queued music file will
-          # begin as soon as the current music naturally ends. If the current
-          # music is ever stopped or changed, the queued song will be lost.
-          # 
-          # The following example will play music by Bach six times, then play
-          # music by Mozart once:
-          # 
-          #     pygame.mixer.music.load('bach.ogg')
-          #     pygame.mixer.music.play(5)        # Plays six times, not five!
-          #     pygame.mixer.music.queue('mozart.ogg')
-
-        self.fail() 
+    def test_queue(self):
+        data_fname = example_path('data')
+        ogg = os.path.join(data_fname, 'house_lo.ogg')
+        wav = os.path.join(data_fname, 'house_lo.wav')
+        music = pygame.mixer.music
+        pygame.mixer.init()
+        try:
+            music.load(wav)
+            self.assertEqual(music.get_queue_length(), 0)
+            music.queue(ogg)
+            music.queue(wav, loops=1, fade_ms=100)
+            music.queue(ogg, 0, 0)
+            self.assertEqual(music.get_queue_length(), 3)
+            music.clear_queue()
+            self.assertEqual(music.get_queue_length(), 0)
+
+            music.set_queue_ahead(3)
+            self.assertRaises(ValueError, music.set_queue_ahead, 0)
+            self.assertRaises(ValueError, music.set_queue_ahead, 9)
+
+            # Loading or stopping drops the queue.
+            music.queue(ogg)
+            music.queue(wav)
+            music.load(wav)
+            self.assertEqual(music.get_queue_length(), 0)
+            music.queue(ogg)
+            music.stop()
+            self.assertEqual(music.get_queue_length(), 0)
+            music.set_queue_ahead(2)
+        finally:
+            pygame.mixer.quit()
+
+    def test_queue__plays_through(self):
+        import shutil
+        import tempfile
+        import time
+        import wave
+
+        def write_wav(path, seconds):
+            w = wave.open(path, 'wb')
+            try:
+                w.setnchannels(1)
+                w.setsampwidth(2)
+                w.setframerate(22050)
+                w.writeframes(as_bytes('\x00\x10') * int(22050 * seconds))
+            finally:
+                w.close()
+
+        def wait_for(condition, timeout=5.0):
+            deadline = time.time() + timeout
+            while not condition() and time.time() < deadline:
+                time.sleep(0.005)
+            return condition()
+
+        tmpdir = tempfile.mkdtemp()
+        first = os.path.join(tmpdir, 'first.wav')
+        second = os.path.join(tmpdir, 'second.wav')
+        write_wav(first, 0.2)
+        write_wav(second, 1.0)
+        music = pygame.mixer.music
+        pygame.mixer.init(22050, -16, 1)
+        try:
+            music.load(first)
+            music.queue(second)
+            self.assertEqual(music.get_queue_length(), 1)
+            music.play()
+            self.assertTrue(music.get_busy())
+
+            # The first track ending takes the second off the queue and
+            # starts it without a gap.
+            self.assertTrue(wait_for(lambda: music.get_queue_length() == 0))
+            self.assertTrue(music.get_busy())
+            self.assertTrue(wait_for(lambda: not music.get_busy()))
+            self.assertEqual(music.get_queue_length(), 0)
+        finally:
+            pygame.mixer.quit()
+            shutil.rmtree(tmpdir)
 
     def todo_test_stop(self):
 
@@ -532,6 +532,155 @@ class MixerModuleTest(unittest.TestCase):
         finally:
             mixer.quit()
 
+    def test_buffer_copy_keyword(self):
+        import ctypes
+        mixer.init()
+        try:
+            samples = bytearray(as_bytes('abcdefgh'))
+            address = ctypes.addressof(
+                (ctypes.c_char * len(samples)).from_buffer(samples))
+            snd = mixer.Sound(buffer=samples, copy=False)
+            self.assertEqual(snd._samples_address, address)
+            samples[0:4] = as_bytes('ABCD')
+            self.assertEqual(snd.get_raw(), as_bytes('ABCDefgh'))
+            self.assertRaises(BufferError, samples.extend, as_bytes('ijkl'))
+            del snd
+            samples.extend(as_bytes('ijkl'))
+
+            snd = mixer.Sound(buffer=samples, copy=True)
+            self.assertNotEqual(snd._samples_address, address)
+            self.assertRaises(TypeError, mixer.Sound, copy=False)
+        finally:
+            mixer.quit()
+
+    def test_sound_stream(self):
+        wave_path = example_path(os.path.join('data', 'house_lo.wav'))
+        mixer.init()
+        try:
+            expected = mixer.Sound(wave_path).get_length()
+            stream = mixer.SoundStream(wave_path, budget=65536)
+            self.assertEqual(stream.get_budget(), 65536)
+            self.assertAlmostEqual(stream.get_length(), expected, 2)
+            self.assertFalse(stream.get_busy())
+            channel = stream.play()
+            if channel is not None:
+                self.assertTrue(isinstance(channel, mixer.ChannelType))
+                self.assertTrue(stream.get_busy())
+                stream.stop()
+                self.assertFalse(stream.get_busy())
+
+            f = open(wave_path, 'rb')
+            try:
+                stream = mixer.SoundStream(f)
+                self.assertAlmostEqual(stream.get_length(), expected, 2)
+                del stream
+            finally:
+                f.close()
+
+            self.assertRaises(ValueError, mixer.SoundStream, wave_path,
+                              budget=16)
+            ogg_path = example_path(os.path.join('data', 'house_lo.ogg'))
+            self.assertRaises(pygame.error, mixer.SoundStream, ogg_path)
+
+            # A data chunk with no samples would never finish a loop.
+            import io
+            import struct
+            fmt = struct.pack('<HHIIHH', 1, 1, 22050, 44100, 2, 16)
+            empty = (as_bytes('RIFF') + struct.pack('<I', 36) +
+                     as_bytes('WAVEfmt ') + struct.pack('<I', 16) + fmt +
+                     as_bytes('data') + struct.pack('<I', 0))
+            self.assertRaises(pygame.error, mixer.SoundStream,
+                              io.BytesIO(empty))
+        finally:
+            mixer.quit()
+        self.assertRaises(pygame.error, mixer.SoundStream, wave_path)
+
+    def test_sound_stream__samples(self):
+        # SDL's disk driver writes the mixed output to a file, so the
+        # samples the stream delivered can be compared with its data.
+        import io
+        import struct
+        import tempfile
+        import time
+        if mixer.get_init():
+            mixer.quit()
+        fd, raw_path = tempfile.mkstemp()
+        os.close(fd)
+        names = ['SDL_AUDIODRIVER', 'SDL_DISKAUDIOFILE', 'SDL_DISKAUDIODELAY']
+        saved = dict((name, os.environ.get(name)) for name in names)
+        os.environ['SDL_AUDIODRIVER'] = 'disk'
+        os.environ['SDL_DISKAUDIOFILE'] = raw_path
+        os.environ['SDL_DISKAUDIODELAY'] = '1'
+        try:
+            try:
+                mixer.init(22050, -16, 1, 512)
+            except pygame.error:
+                return
+            try:
+                if mixer.get_init() != (22050, -16, 1):
+                    return
+                values = [(i * 7) % 60000 - 30000 for i in range(8000)]
+                data = struct.pack('<%dh' % len(values), *values)
+                fmt = struct.pack('<HHIIHH', 1, 1, 22050, 44100, 2, 16)
+                wav = (as_bytes('RIFF') + struct.pack('<I', 36 + len(data)) +
+                       as_bytes('WAVEfmt ') + struct.pack('<I', 16) + fmt +
+                       as_bytes('data') + struct.pack('<I', len(data)) +
+                       data)
+                stream = mixer.SoundStream(io.BytesIO(wav), budget=65536)
+                time.sleep(0.2)     # let it prefetch the whole file
+                channel = stream.play()
+                self.assertTrue(channel is not None)
+                deadline = time.time() + 10
+                while stream.get_busy() and time.time() < deadline:
+                    time.sleep(0.01)
+                self.assertFalse(stream.get_busy())
+
+                # Halting the finished stream must leave the channel alone
+                # once another sound has it.
+                sound = mixer.Sound(buffer=as_bytes('\x01\x02') * 44100)
+                channel.play(sound)
+                time.sleep(0.05)
+                self.assertTrue(channel.get_busy())
+                channel.stop()
+            finally:
+                mixer.quit()
+            f = open(raw_path, 'rb')
+            try:
+                played = f.read()
+            finally:
+                f.close()
+            expected = struct.pack('=%dh' % len(values), *values)
+            self.assertTrue(expected in played)
+        finally:
+            for name in names:
+                if saved[name] is None:
+                    del os.environ[name]
+                else:
+                    os.environ[name] = saved[name]
+            os.remove(raw_path)
+
+    def test_array_copy_keyword(self):
+        import array
+        mixer.init(22050, -16, 1)
+        try:
+            a = array.array('h', [0, 1, -1, 300, -300, 32767, -32768, 5])
+            snd = mixer.Sound(array=a, copy=False)
+            self.assertEqual(snd._samples_address, a.buffer_info()[0])
+            self.assertEqual(snd.get_raw(), a.tostring()
+                             if not hasattr(a, 'tobytes') else a.tobytes())
+
+            # A different item size is converted into a new buffer.
+            values = [(i * 7919) - 70000 for i in range(37)]
+            b = array.array('i', values)
+            snd = mixer.Sound(array=b, copy=False)
+            self.assertNotEqual(snd._samples_address, b.buffer_info()[0])
+            expected = array.array('H', [v & 0xFFFF for v in values])
+            self.assertEqual(snd.get_raw(), expected.tostring()
+                             if not hasattr(expected, 'tobytes')
+                             else expected.tobytes())
+        finally:
+            mixer.quit()
+
     def todo_test_fadeout(self):
 
         # __doc__ (as of 2008-08-02) for pygame.mixer.fadeout:
@@ -16,7 +16,8 @@ else:
     from test.test_utils import test_not_implemented, unittest
 import pygame
 from pygame import encode_string, encode_file_path
-from pygame.compat import bytes_, as_bytes, as_unicode
+from pygame.rwobject import set_rwops_buffer_size, get_rwops_buffer_size
+from pygame.compat import bytes_, as_bytes, as_unicode, get_BytesIO
 
 
 class RWopsEncodeStringTest(unittest.TestCase):
@@ -110,6 +111,268 @@ class RWopsEncodeFilePathTest(unittest.TestCase):
     def test_etype(self):
         b = as_bytes("a\x00b\x00c")
         self.assertRaises(TypeError, encode_file_path, b, TypeError)
+
+class RWopsBufferSizeTest(unittest.TestCase):
+    def setUp(self):
+        self.size = get_rwops_buffer_size()
+
+    def tearDown(self):
+        set_rwops_buffer_size(self.size)
+
+    def test_get_set(self):
+        self.assertEqual(self.size, 65536)
+        set_rwops_buffer_size(100)
+        self.assertEqual(get_rwops_buffer_size(), 100)
+        self.assertRaises(ValueError, set_rwops_buffer_size, -1)
+        self.assertFalse(hasattr(pygame, 'set_rwops_buffer_size'))
+
+    def test_load_from_file_object(self):
+        surf = pygame.Surface((7, 5), 0, 24)
+        for x in range(7):
+            surf.set_at((x, x % 5), (x * 30, 255 - x * 30, 77))
+        data = saved_bmp(surf)
+        second = pygame.Surface((3, 2), 0, 24)
+        second.fill((10, 20, 30))
+        data2 = saved_bmp(second)
+
+        # Buffers smaller than the file and no buffering at all. Loading
+        # leaves the object just past the first image, ready for the next.
+        for size in (16, 0, 65536):
+            set_rwops_buffer_size(size)
+            f = KeepOpen(data + data2)
+            loaded = pygame.image.load(f, 'x.bmp')
+            for x in range(7):
+                self.assertEqual(loaded.get_at((x, x % 5)),
+                                 surf.get_at((x, x % 5)))
+            self.assertEqual(f.tell(), len(data))
+            loaded = pygame.image.load(f, 'x.bmp')
+            self.assertEqual(loaded.get_size(), (3, 2))
+            self.assertEqual(loaded.get_at((2, 1)), second.get_at((2, 1)))
+
+    def test_threaded_file_position(self):
+        # SoundStream reads through the threaded RWops: the read ahead
+        # path for file-like objects and the descriptor path for files.
+        from pygame import mixer
+        import os
+        import tempfile
+        import time
+        import struct
+
+        frames = 64
+        fmt = struct.pack('<HHIIHH', 1, 1, 22050, 44100, 2, 16)
+        wav = (as_bytes('RIFF') + struct.pack('<I', 36 + frames * 2) +
+               as_bytes('WAVEfmt ') + struct.pack('<I', 16) + fmt +
+               as_bytes('data') + struct.pack('<I', frames * 2) +
+               as_bytes('\0') * (frames * 2))
+        trailer = as_bytes('next object')
+
+        fd, path = tempfile.mkstemp(suffix='.wav')
+        os.close(fd)
+        mixer.init(22050, -16, 1)
+        try:
+            f = open(path, 'wb')
+            f.write(wav + trailer)
+            f.close()
+            plain = open(path, 'rb')
+            objects = [KeepOpen(wav + trailer)]
+            if sys.platform != 'win32':
+                # Elsewhere the stream would close the file when done
+                objects.append(plain)
+            for f in objects:
+                stream = mixer.SoundStream(f)
+                if stream.play() is None:
+                    # No free channel; nothing to read to the end
+                    del stream
+                    continue
+                deadline = time.time() + 5
+                while stream.get_busy() and time.time() < deadline:
+                    time.sleep(0.01)
+                self.assertFalse(stream.get_busy())
+                del stream
+                # The last reference may be dropped by the stream thread
+                while f.tell() != len(wav) and time.time() < deadline:
+                    time.sleep(0.01)
+                self.assertEqual(f.tell(), len(wav))
+                self.assertEqual(f.read(), trailer)
+            plain.close()
+        finally:
+            mixer.quit()
+            os.remove(path)
+
+
+class KeepOpen(get_BytesIO()):
+    """a file-like object that outlives the loaders closing it"""
+    def close(self):
+        pass
+
+
+def saved_bmp(surf):
+    import os
+    import tempfile
+    fd, path = tempfile.mkstemp(suffix='.bmp')
+    os.close(fd)
+    try:
+        pygame.image.save(surf, path)
+        f = open(path, 'rb')
+        data = f.read()
+        f.close()
+    finally:
+        os.remove(path)
+    return data
+
+
+if __name__ == '__main__':
+    import os
+    pkg_dir = os.path.split(os.path.abspath(__file__))[0]
+    parent_dir, pkg_name = os.path.split(pkg_dir)
+    is_pygame_pkg = (pkg_name == 'tests' and
+                     os.path.split(parent_dir)[1] == 'pygame')
+    if not is_pygame_pkg:
+        sys.path.insert(0, parent_dir)
+else:
+    is_pygame_pkg = __name__.startswith('pygame.tests.')
+
+if is_pygame_pkg:
+    from pygame.tests.test_utils import test_not_implemented, unittest
+else:
+    from test.test_utils import test_not_implemented, unittest
+import pygame
+from pygame import encode_string, encode_file_path
+from pygame.rwobject import set_rwops_buffer_size, get_rwops_buffer_size
+from pygame.compat import bytes_, as_bytes, as_unicode, get_BytesIO
+
+
+class RWopsEncodeStringTest(unittest.TestCase):
+    global getrefcount
+
+    def test_obj_None(self):
+        self.assert_(encode_string(None) is None)
+    
+    def test_returns_bytes(self):
+        u = as_unicode(r"Hello")
+        self.assert_(isinstance(encode_string(u), bytes_))
+    
+    def test_obj_bytes(self):
+        b = as_bytes("encyclop\xE6dia")
+        self.assert_(encode_string(b, 'ascii', 'strict') is b)
+        
+    def test_encode_unicode(self):
+        u = as_unicode(r"\u00DEe Olde Komp\u00FCter Shoppe")
+        b = u.encode('utf-8')
+        self.assertEqual(encode_string(u, 'utf-8'), b)
+        
+    def test_error_fowarding(self):
+        self.assertRaises(SyntaxError, encode_string)
+        
+    def test_errors(self):
+        s = r"abc\u0109defg\u011Dh\u0125ij\u0135klmnoprs\u015Dtu\u016Dvz"
+        u = as_unicode(s)
+        b = u.encode('ascii', 'ignore')
+        self.assertEqual(encode_string(u, 'ascii', 'ignore'), b)
+
+    def test_encoding_error(self):
+        u = as_unicode(r"a\x80b")
+        self.assert_(encode_string(u, 'ascii', 'strict') is None)
+
+    def test_check_defaults(self):
+        u = as_unicode(r"a\u01F7b")
+        b = u.encode("unicode_escape", "backslashreplace") 
+        self.assert_(encode_string(u) == b)
+
+    def test_etype(self):
+        u = as_unicode(r"a\x80b")
+        self.assertRaises(SyntaxError, encode_string,
+                          u, 'ascii', 'strict', SyntaxError)
+
+    def test_string_with_null_bytes(self):
+        b = as_bytes("a\x00b\x00c")
+        self.assert_(encode_string(b, etype=SyntaxError) is b)
+        u = b.decode()
+        self.assert_(encode_string(u, 'ascii', 'strict') == b)
+
+    try:
+        from sys import getrefcount as _g
+        getrefcount = _g                   # This nonsense is for Python 3.x
+    except ImportError:
+        pass
+    else:
+        def test_refcount(self):
+            bpath = as_bytes(" This is a string that is not cached.")[1:]
+            upath = bpath.decode('ascii')
+            before = getrefcount(bpath)
+            bpath = encode_string(bpath)
+            self.assertEqual(getrefcount(bpath), before)
+            bpath = encode_string(upath)
+            self.assertEqual(getrefcount(bpath), before)
+            
+    def test_smp(self):
+        utf_8 = as_bytes("a\xF0\x93\x82\xA7b")
+        u = as_unicode(r"a\U000130A7b")
+        b = encode_string(u, 'utf-8', 'strict', AssertionError)
+        self.assertEqual(b, utf_8)
+        #  For Python 3.1, surrogate pair handling depends on whether the
+        #  interpreter was built with UCS-2 or USC-4 unicode strings.
+        ##u = as_unicode(r"a\uD80C\uDCA7b")
+        ##b = encode_string(u, 'utf-8', 'strict', AssertionError)
+        ##self.assertEqual(b, utf_8)
+
+class RWopsEncodeFilePathTest(unittest.TestCase):
+    # Most tests can be skipped since RWopsEncodeFilePath wraps
+    # RWopsEncodeString
+    def test_encoding(self):
+        u = as_unicode(r"Hello")
+        self.assert_(isinstance(encode_file_path(u), bytes_))
+    
+    def test_error_fowarding(self):
+        self.assertRaises(SyntaxError, encode_file_path)
+
+    def test_path_with_null_bytes(self):
+        b = as_bytes("a\x00b\x00c")
+        self.assert_(encode_file_path(b) is None)
+
+    def test_etype(self):
+        b = as_bytes("a\x00b\x00c")
+        self.assertRaises(TypeError, encode_file_path, b, TypeError)
+
+class RWopsBufferSizeTest(unittest.TestCase):
+    def setUp(self):
+        self.size = pygame.get_rwops_buffer_size()
+
+    def tearDown(self):
+        pygame.set_rwops_buffer_size(self.size)
+
+    def test_get_set(self):
+        self.assertEqual(self.size, 65536)
+        pygame.set_rwops_buffer_size(100)
+        self.assertEqual(pygame.get_rwops_buffer_size(), 100)
+        self.assertRaises(ValueError, pygame.set_rwops_buffer_size, -1)
+
+    def test_load_from_file_object(self):
+        from pygame.compat import get_BytesIO
+        BytesIO = get_BytesIO()
+        surf = pygame.Surface((7, 5), 0, 24)
+        for x in range(7):
+            surf.set_at((x, x % 5), (x * 30, 255 - x * 30, 77))
+        import os
+        import tempfile
+        fd, path = tempfile.mkstemp(suffix='.bmp')
+        os.close(fd)
+        try:
+            pygame.image.save(surf, path)
+            f = open(path, 'rb')
+            data = f.read()
+            f.close()
+        finally:
+            os.remove(path)
+
+        # Buffers smaller than the file and no buffering at all.
+        for size in (16, 0, 65536):
+            pygame.set_rwops_buffer_size(size)
+            f = BytesIO(data)
+            loaded = pygame.image.load(f, 'x.bmp')
+            for x in range(7):
+                self.assertEqual(loaded.get_at((x, x % 5)),
+                                 surf.get_at((x, x % 5)))
                                    
 if __name__ == '__main__':
     unittest.main()
@@ -152,6 +152,49 @@ class ClockTypeTest(unittest.TestCase):
 
         self.fail() 
 
+    def test_tick_precise(self):
+        c = Clock()
+        c.tick_precise()
+        start = time.time()
+        times = [c.tick_precise(100) for _ in range(10)]
+        elapsed = time.time() - start
+
+        self.assertTrue(isinstance(times[0], float))
+        # Pacing keeps to a fixed schedule of 10 ms frames.
+        self.assertTrue(elapsed >= 0.095, elapsed)
+        self.assertAlmostEqual(sum(times) / 1000.0, elapsed, 1)
+        self.assertEqual(c.get_time(), int(times[-1]))
+        self.assertRaises(ValueError, c.tick_precise, -1)
+
+    def test_frame_statistics(self):
+        c = Clock(history=8)
+        self.assertEqual(c.get_frame_percentiles(), (0.0, 0.0, 0.0))
+        for _ in range(12):
+            c.begin_section('work')
+            time.sleep(0.002)
+            c.end_section('work')
+            c.tick()
+
+        median, p95, p99 = c.get_frame_percentiles()
+        self.assertTrue(1.5 < median <= p95 <= p99, (median, p95, p99))
+        work, = c.get_frame_percentiles((50,), section='work')
+        self.assertTrue(1.5 < work <= p99)
+
+        hist = c.get_frame_histogram(bin_ms=1.0, bins=4)
+        self.assertEqual(len(hist), 4)
+        self.assertEqual(sum(hist), 8)
+        self.assertEqual(hist[0], 0)
+        self.assertEqual(sum(c.get_frame_histogram(section='work')), 8)
+
+        self.assertRaises(ValueError, c.end_section, 'work')
+        self.assertRaises(KeyError, c.get_frame_percentiles, (50,), 'none')
+        self.assertRaises(ValueError, c.get_frame_percentiles, (101,))
+        self.assertRaises(ValueError, c.get_frame_percentiles, (float('nan'),))
+        c.begin_section('work')
+        self.assertRaises(ValueError, c.begin_section, 'work')
+        c.end_section('work')
+        self.assertRaises(ValueError, Clock, 0)
+
 class TimeModuleTest(unittest.TestCase):
     def todo_test_delay(self):
 
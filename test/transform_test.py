@@ -500,6 +500,38 @@ class TransformModuleTest( unittest.TestCase ):
         self.assertEqual(s2.get_at((0,31)), (255,0,0,255))
         self.assertEqual(s2.get_at((31,31)), (255,0,0,255))
 
+    def test_laplacian__depths_agree(self):
+        # 32 bit surfaces have a packed code path; it must give the same
+        # result as 24 bit, including the edges and a width which is not
+        # a multiple of four.
+        size = (13, 9)
+        results = []
+        for depth in (24, 32):
+            s = pygame.Surface(size, 0, depth)
+            s.fill((10, 10, 70))
+            pygame.draw.line(s, (255, 0, 0), (0, 0), (12, 8))
+            pygame.draw.line(s, (0, 200, 30), (12, 0), (0, 8))
+            d = pygame.transform.laplacian(s)
+            results.append([d.get_at((x, y)) for x in range(size[0])
+                                             for y in range(size[1])])
+        self.assertEqual(results[0], results[1])
+
+    def test_threshold__depths_agree(self):
+        size = (13, 9)
+        results = []
+        for depth in (24, 32):
+            s = pygame.Surface(size, 0, depth)
+            s.fill((40, 40, 40))
+            s.fill((50, 40, 40), (0, 0, 5, 9))
+            s.fill((40, 40, 60), (11, 0, 2, 9))
+            d = pygame.Surface(size, 0, depth)
+            num = pygame.transform.threshold(d, s, (40, 40, 40),
+                                             (10, 10, 10, 255),
+                                             (0, 0, 0), 1)
+            results.append((num, [d.get_at((x, 4)) for x in range(13)]))
+        self.assertEqual(results[0], results[1])
+        self.assertEqual(results[1][0], (5 + 6) * 9)
+
     def test_average_surfaces(self):
         """
         """